@@ -0,0 +1,127 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//Measures the throughput of mpmc_queue with movable-only work items for an
+//increasing number of producer and consumer threads, with both wait
+//strategies. Consumers take batches with pop_bulk and block with pop when
+//the queue is empty. Pass an item count to change the default one.
+#include <boost/move/mpmc_queue.hpp>
+#include <cstdio>
+
+#if !defined(BOOST_NO_CXX11_HDR_THREAD)
+#include "bench_timer.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+//Movable-only work item
+class task
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(task)
+   int id_;
+
+   public:
+   explicit task(int id = -1) : id_(id) {}
+   task(BOOST_RV_REF(task) x) : id_(x.id_) {  x.id_ = -1;  }
+   task &operator=(BOOST_RV_REF(task) x) {  id_ = x.id_;  x.id_ = -1;  return *this;  }
+
+   int id() const {  return id_;  }
+};
+
+//Pushed once per consumer after the producers finish
+const int stop_id = -2;
+
+template<class WaitStrategy>
+double items_per_second(int pairs, int items, bool &ok)
+{
+   typedef boost::movelib::mpmc_queue<task, WaitStrategy> queue_t;
+   queue_t q(1024);
+   const int per_producer = items/pairs;
+   std::atomic<long long> sum(0);
+   std::vector<std::thread> producers, consumers;
+   bench_timer t;
+   for(int c = 0; c != pairs; ++c){
+      consumers.push_back(std::thread([&q, &sum]{
+         task batch[32];
+         long long local = 0;
+         for(bool stop = false; !stop;){
+            std::size_t n = q.pop_bulk(batch, 32u);
+            if(!n){
+               q.pop(batch[0]);
+               n = 1;
+            }
+            int stops = 0;
+            for(std::size_t i = 0; i != n; ++i){
+               if(batch[i].id() == stop_id){
+                  ++stops;
+               }
+               else{
+                  local += batch[i].id();
+               }
+            }
+            //Leaves the other stop items to the other consumers
+            for(; stops > 1; --stops){
+               q.emplace(stop_id);
+            }
+            stop = stops != 0;
+         }
+         sum += local;
+      }));
+   }
+   for(int p = 0; p != pairs; ++p){
+      producers.push_back(std::thread([&q, p, per_producer]{
+         for(int i = 0; i != per_producer; ++i){
+            task w(p*per_producer + i);
+            q.push(::boost::move(w));
+         }
+      }));
+   }
+   for(std::size_t i = 0; i != producers.size(); ++i){
+      producers[i].join();
+   }
+   for(int c = 0; c != pairs; ++c){
+      q.emplace(stop_id);
+   }
+   for(std::size_t i = 0; i != consumers.size(); ++i){
+      consumers[i].join();
+   }
+   const double secs = t.elapsed();
+   const long long n = static_cast<long long>(per_producer)*pairs;
+   ok = ok && sum.load() == n*(n - 1)/2;
+   return double(n)/secs;
+}
+
+int main(int argc, char *argv[])
+{
+   const int items = argc > 1 ? std::atoi(argv[1]) : 200000;
+   const int pairs[] = { 1, 2, 4, 8 };
+   bool ok = true;
+   std::printf("%d movable-only items, %u hardware threads\n", items, std::thread::hardware_concurrency());
+   std::printf("%10s %10s %16s %16s\n", "producers", "consumers", "spin_wait", "blocking_wait");
+   for(std::size_t i = 0; i != sizeof(pairs)/sizeof(pairs[0]); ++i){
+      const int p = pairs[i];
+      const double spin = items_per_second<boost::movelib::spin_wait>(p, items, ok);
+      const double block = items_per_second<boost::movelib::blocking_wait>(p, items, ok);
+      std::printf("%10d %10d %11.2f M/s %11.2f M/s\n", p, p, spin/1e6, block/1e6);
+   }
+   return ok ? 0 : 1;
+}
+
+#else
+
+int main()
+{
+   std::printf("This benchmark needs <thread>\n");
+   return 0;
+}
+
+#endif
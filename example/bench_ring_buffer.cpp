@@ -0,0 +1,157 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//Times ring_buffer<T> against std::deque<T> used as a window of the most
+//recent events: pushing events into a full window, which drops the oldest
+//one, and filling the window and moving all its events out. Pass an event
+//count to change the default one.
+#include <boost/move/ring_buffer.hpp>
+#include "bench_timer.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+//Copyable and movable event with a heap payload
+class event
+{
+   BOOST_COPYABLE_AND_MOVABLE(event)
+   std::vector<int> data_;
+
+   public:
+   event() {}
+   explicit event(int i) : data_(16, i) {}
+   event(const event &x) : data_(x.data_) {}
+   event(BOOST_RV_REF(event) x) {  data_.swap(x.data_);  }
+
+   event &operator=(BOOST_COPY_ASSIGN_REF(event) x)
+   {
+      data_ = x.data_;
+      return *this;
+   }
+
+   event &operator=(BOOST_RV_REF(event) x)
+   {
+      data_.swap(x.data_);
+      x.data_.clear();
+      return *this;
+   }
+
+   int id() const {  return data_.empty() ? -1 : data_[0];  }
+};
+
+template<class T>
+T make_value(int i);
+
+template<>
+int make_value<int>(int i)
+{  return i;  }
+
+template<>
+event make_value<event>(int i)
+{  return event(i);  }
+
+long weight(int i)            {  return i;  }
+long weight(const event &e)   {  return e.id();  }
+
+template<class T>
+double deque_window_time(std::size_t window, int events, long &sink)
+{
+   std::deque<T> d;
+   bench_timer t;
+   for(int i = 0; i != events; ++i){
+      T x(make_value<T>(i));
+      if(d.size() == window){
+         d.pop_front();
+      }
+      d.push_back(::boost::move(x));
+   }
+   sink += weight(d.front());
+   return t.elapsed();
+}
+
+template<class T>
+double ring_window_time(std::size_t window, int events, long &sink)
+{
+   boost::movelib::ring_buffer<T> r(window);
+   bench_timer t;
+   for(int i = 0; i != events; ++i){
+      T x(make_value<T>(i));
+      r.push_back(::boost::move(x));
+   }
+   sink += weight(r.front());
+   return t.elapsed();
+}
+
+template<class T>
+double deque_drain_time(std::size_t window, int events, long &sink)
+{
+   std::deque<T> d;
+   std::vector<T> out(window);
+   bench_timer t;
+   for(int i = 0; i < events; i += int(window)){
+      for(std::size_t j = 0; j != window; ++j){
+         T x(make_value<T>(i));
+         d.push_back(::boost::move(x));
+      }
+      ::boost::move(d.begin(), d.end(), out.begin());
+      d.clear();
+      sink += weight(out.back());
+   }
+   return t.elapsed();
+}
+
+template<class T>
+double ring_drain_time(std::size_t window, int events, long &sink)
+{
+   boost::movelib::ring_buffer<T> r(window);
+   std::vector<T> out(window);
+   //Every transfer wraps around the end of the buffer
+   r.push_back(make_value<T>(0));
+   r.pop_front();
+   bench_timer t;
+   for(int i = 0; i < events; i += int(window)){
+      for(std::size_t j = 0; j != window; ++j){
+         T x(make_value<T>(i));
+         r.push_back(::boost::move(x));
+      }
+      r.move_out(window, out.begin());
+      sink += weight(out.back());
+   }
+   return t.elapsed();
+}
+
+template<class T>
+void run(const char *type_name, int events, long &sink)
+{
+   //Powers of two, so that both containers hold the same number of events
+   const std::size_t windows[] = { 64, 1024, 16384 };
+   std::printf("\n%s, %d events\n", type_name, events);
+   std::printf("%8s  %-8s %14s %14s\n", "window", "test", "std::deque", "ring_buffer");
+   for(std::size_t i = 0; i != sizeof(windows)/sizeof(windows[0]); ++i){
+      const std::size_t w = windows[i];
+      std::printf( "%8u  %-8s %13.4fs %13.4fs\n", unsigned(w), "window"
+                 , deque_window_time<T>(w, events, sink), ring_window_time<T>(w, events, sink));
+      std::printf( "%8u  %-8s %13.4fs %13.4fs\n", unsigned(w), "drain"
+                 , deque_drain_time<T>(w, events, sink), ring_drain_time<T>(w, events, sink));
+   }
+}
+
+int main(int argc, char *argv[])
+{
+   const int events = argc > 1 ? std::atoi(argv[1]) : 200000;
+   long sink = 0;
+   run<int>("int", events, sink);
+   run<event>("event with a heap payload", events, sink);
+   //Uses the results so that the timed loops are not optimized away
+   std::printf("\nchecksum: %ld\n", sink);
+   return 0;
+}
@@ -0,0 +1,116 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//Times small_vector<T, 16> against std::vector<T> for push_back, insertion
+//at the front and moving the container, with sizes that fit in the inline
+//storage and a size that doesn't. Pass a repetition count to change the
+//default one.
+#include <boost/move/small_vector.hpp>
+#include "bench_timer.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+template<class T>
+T make_value(int i);
+
+template<>
+int make_value<int>(int i)
+{  return i;  }
+
+//Long enough to live in dynamic memory
+template<>
+std::string make_value<std::string>(int i)
+{  return std::string(32, char('a' + i % 26));  }
+
+std::size_t weight(int i)                 {  return std::size_t(i);  }
+std::size_t weight(const std::string &s)  {  return s.size();  }
+
+template<class Vector>
+double push_back_time(int n, int reps, std::size_t &sink)
+{
+   typedef typename Vector::value_type value_type;
+   const value_type x(make_value<value_type>(n));
+   bench_timer t;
+   for(int r = 0; r != reps; ++r){
+      Vector v;
+      for(int i = 0; i != n; ++i){
+         v.push_back(x);
+      }
+      sink += weight(v.back());
+   }
+   return t.elapsed();
+}
+
+template<class Vector>
+double insert_time(int n, int reps, std::size_t &sink)
+{
+   typedef typename Vector::value_type value_type;
+   const value_type x(make_value<value_type>(n));
+   bench_timer t;
+   for(int r = 0; r != reps; ++r){
+      Vector v;
+      for(int i = 0; i != n; ++i){
+         v.insert(v.begin(), x);
+      }
+      sink += weight(v.front());
+   }
+   return t.elapsed();
+}
+
+//Moves the elements to a new container and back
+template<class Vector>
+double move_time(int n, int reps, std::size_t &sink)
+{
+   typedef typename Vector::value_type value_type;
+   Vector v;
+   for(int i = 0; i != n; ++i){
+      v.push_back(make_value<value_type>(i));
+   }
+   bench_timer t;
+   for(int r = 0; r != reps; ++r){
+      Vector tmp(::boost::move(v));
+      sink += weight(tmp.back());
+      v = ::boost::move(tmp);
+   }
+   return t.elapsed();
+}
+
+template<class T>
+void run(const char *type_name, int reps, std::size_t &sink)
+{
+   typedef std::vector<T>                       std_vector_t;
+   typedef boost::movelib::small_vector<T, 16>  small_vector_t;
+   const int sizes[] = { 4, 16, 64 };
+   std::printf("\n%s, %d repetitions\n", type_name, reps);
+   std::printf("%6s  %-10s %14s %14s\n", "size", "operation", "std::vector", "small_vector");
+   for(std::size_t i = 0; i != sizeof(sizes)/sizeof(sizes[0]); ++i){
+      const int n = sizes[i];
+      std::printf( "%6d  %-10s %13.4fs %13.4fs\n", n, "push_back"
+                 , push_back_time<std_vector_t>(n, reps, sink), push_back_time<small_vector_t>(n, reps, sink));
+      std::printf( "%6d  %-10s %13.4fs %13.4fs\n", n, "insert"
+                 , insert_time<std_vector_t>(n, reps, sink), insert_time<small_vector_t>(n, reps, sink));
+      std::printf( "%6d  %-10s %13.4fs %13.4fs\n", n, "move"
+                 , move_time<std_vector_t>(n, reps, sink), move_time<small_vector_t>(n, reps, sink));
+   }
+}
+
+int main(int argc, char *argv[])
+{
+   const int reps = argc > 1 ? std::atoi(argv[1]) : 10000;
+   std::size_t sink = 0;
+   run<int>("int", reps, sink);
+   run<std::string>("std::string", reps, sink);
+   //Uses the results so that the timed loops are not optimized away
+   std::printf("\nchecksum: %lu\n", static_cast<unsigned long>(sink));
+   return 0;
+}
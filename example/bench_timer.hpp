@@ -0,0 +1,56 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#ifndef BOOST_MOVE_EXAMPLE_BENCH_TIMER_HPP
+#define BOOST_MOVE_EXAMPLE_BENCH_TIMER_HPP
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_NO_CXX11_HDR_CHRONO)
+#include <chrono>
+#else
+#include <ctime>
+#endif
+
+//Seconds elapsed since construction: wall clock time if <chrono> is
+//available, processor time otherwise
+class bench_timer
+{
+   public:
+   bench_timer()
+   {  this->restart();  }
+
+   void restart()
+   {
+      #if !defined(BOOST_NO_CXX11_HDR_CHRONO)
+      start_ = std::chrono::steady_clock::now();
+      #else
+      start_ = std::clock();
+      #endif
+   }
+
+   double elapsed() const
+   {
+      #if !defined(BOOST_NO_CXX11_HDR_CHRONO)
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+      #else
+      return double(std::clock() - start_)/CLOCKS_PER_SEC;
+      #endif
+   }
+
+   private:
+   #if !defined(BOOST_NO_CXX11_HDR_CHRONO)
+   std::chrono::steady_clock::time_point start_;
+   #else
+   std::clock_t start_;
+   #endif
+};
+
+#endif //BOOST_MOVE_EXAMPLE_BENCH_TIMER_HPP
@@ -0,0 +1,453 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+//! Lazy range views that preserve the rvalue-ness of the elements:
+//!
+//! \code
+//! movelib::move_to(src | boost::adaptors::moved
+//!                      | movelib::adaptors::filtered(pred)
+//!                      | movelib::adaptors::transformed(f), dst);
+//! \endcode
+//!
+//! moves the elements of src that satisfy pred through f into dst without
+//! intermediate containers. A range is any object with begin() and end()
+//! members and nested iterator and const_iterator types.
+
+#ifndef BOOST_MOVE_ADAPTORS_HPP
+#define BOOST_MOVE_ADAPTORS_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/type_traits/decay.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_reference.hpp>
+#include <boost/utility/result_of.hpp>
+#include <iterator>  //std::iterator_traits, iterator tags
+
+namespace boost {
+
+/// @cond
+
+namespace move_detail {
+
+template<class R>
+struct range_iterator
+{  typedef typename R::iterator type;  };
+
+template<class R>
+struct range_iterator<const R>
+{  typedef typename R::const_iterator type;  };
+
+template<class C>
+struct has_member_reserve
+{
+   template<class U, void (U::*)(typename U::size_type)> struct sig;
+   template<class U> static char test(sig<U, &U::reserve> *);
+   template<class U> static int  test(...);
+   static const bool value = sizeof(test<C>(0)) == sizeof(char);
+};
+
+//Reserves room for the elements of [f, l) if their number is known
+//without traversing the range and the container has reserve()
+template<class C, class It>
+void reserve_for(C &c, It f, It l, std::random_access_iterator_tag, ::boost::true_type)
+{  c.reserve(c.size() + typename C::size_type(l - f));  }
+
+template<class C, class It, class Category, class HasReserve>
+void reserve_for(C &, It, It, Category, HasReserve)
+{}
+
+#if defined(BOOST_NO_RVALUE_REFERENCES)
+
+//A temporary of a movable-only type only binds to const T & in C++03
+//compilers, so a view that returns temporaries is materialized first
+template<class C, class It>
+void push_back_from(C &c, const It &it, ::boost::true_type)
+{  c.push_back(*it);  }
+
+template<class C, class It>
+void push_back_from(C &c, const It &it, ::boost::false_type)
+{
+   typename C::value_type v(*it);
+   c.push_back(::boost::move(v));
+}
+
+#endif   //#if defined(BOOST_NO_RVALUE_REFERENCES)
+
+}  //namespace move_detail {
+
+/// @endcond
+
+namespace movelib {
+
+//! Iterator over the elements of [it, end) that satisfy a predicate.
+//! Dereferencing it yields the reference of the underlying iterator, so
+//! the elements of a moved view stay rvalues.
+template<class It, class Pred>
+class filter_iterator
+{
+   public:
+   typedef typename std::iterator_traits<It>::value_type       value_type;
+   typedef typename std::iterator_traits<It>::reference        reference;
+   typedef typename std::iterator_traits<It>::pointer          pointer;
+   typedef typename std::iterator_traits<It>::difference_type  difference_type;
+   typedef std::forward_iterator_tag                           iterator_category;
+
+   filter_iterator()
+      : m_it(), m_end(), m_pred()
+   {}
+
+   filter_iterator(It it, It end, const Pred &pred)
+      : m_it(it), m_end(end), m_pred(pred)
+   {  this->priv_satisfy();  }
+
+   It base() const
+   {  return m_it;  }
+
+   reference operator*() const
+   {  return *m_it;  }
+
+   filter_iterator &operator++()
+   {
+      ++m_it;
+      this->priv_satisfy();
+      return *this;
+   }
+
+   filter_iterator operator++(int)
+   {
+      filter_iterator tmp(*this);
+      ++*this;
+      return tmp;
+   }
+
+   friend bool operator==(const filter_iterator &a, const filter_iterator &b)
+   {  return a.m_it == b.m_it;  }
+
+   friend bool operator!=(const filter_iterator &a, const filter_iterator &b)
+   {  return a.m_it != b.m_it;  }
+
+   private:
+   void priv_satisfy()
+   {
+      //The predicate sees a const lvalue, so it can't consume the element
+      while(m_it != m_end && !m_pred(static_cast<const value_type &>(*m_it))){
+         ++m_it;
+      }
+   }
+
+   It    m_it;
+   It    m_end;
+   Pred  m_pred;
+};
+
+//! Iterator that yields f(*it) for each iterator it of the underlying
+//! range. f receives the reference of the underlying iterator, so over a
+//! moved view it receives rvalues and can consume them. Has the category
+//! of the underlying iterator, but its reference is the result of f.
+template<class It, class F>
+class transform_iterator
+{
+   typedef typename std::iterator_traits<It>::reference  base_reference;
+
+   public:
+   typedef typename ::boost::result_of<const F(base_reference)>::type      reference;
+   typedef typename ::boost::decay<reference>::type                        value_type;
+   typedef void                                                            pointer;
+   typedef typename std::iterator_traits<It>::difference_type              difference_type;
+   typedef typename std::iterator_traits<It>::iterator_category            iterator_category;
+
+   transform_iterator()
+      : m_it(), m_f()
+   {}
+
+   transform_iterator(It it, const F &f)
+      : m_it(it), m_f(f)
+   {}
+
+   It base() const
+   {  return m_it;  }
+
+   reference operator*() const
+   {  return m_f(*m_it);  }
+
+   reference operator[](difference_type n) const
+   {  return m_f(m_it[n]);  }
+
+   transform_iterator &operator++()
+   {  ++m_it;  return *this;  }
+
+   transform_iterator operator++(int)
+   {  transform_iterator tmp(*this);  ++m_it;  return tmp;  }
+
+   transform_iterator &operator--()
+   {  --m_it;  return *this;  }
+
+   transform_iterator operator--(int)
+   {  transform_iterator tmp(*this);  --m_it;  return tmp;  }
+
+   transform_iterator &operator+=(difference_type n)
+   {  m_it += n;  return *this;  }
+
+   transform_iterator &operator-=(difference_type n)
+   {  m_it -= n;  return *this;  }
+
+   friend transform_iterator operator+(transform_iterator x, difference_type n)
+   {  return x += n;  }
+
+   friend transform_iterator operator+(difference_type n, transform_iterator x)
+   {  return x += n;  }
+
+   friend transform_iterator operator-(transform_iterator x, difference_type n)
+   {  return x -= n;  }
+
+   friend difference_type operator-(const transform_iterator &a, const transform_iterator &b)
+   {  return a.m_it - b.m_it;  }
+
+   friend bool operator==(const transform_iterator &a, const transform_iterator &b)
+   {  return a.m_it == b.m_it;  }
+
+   friend bool operator!=(const transform_iterator &a, const transform_iterator &b)
+   {  return a.m_it != b.m_it;  }
+
+   friend bool operator<(const transform_iterator &a, const transform_iterator &b)
+   {  return a.m_it < b.m_it;  }
+
+   friend bool operator>(const transform_iterator &a, const transform_iterator &b)
+   {  return b.m_it < a.m_it;  }
+
+   friend bool operator<=(const transform_iterator &a, const transform_iterator &b)
+   {  return !(b.m_it < a.m_it);  }
+
+   friend bool operator>=(const transform_iterator &a, const transform_iterator &b)
+   {  return !(a.m_it < b.m_it);  }
+
+   private:
+   It m_it;
+   F  m_f;
+};
+
+//! View of a range whose elements are yielded as rvalues
+//! (through move_iterator), created with range | boost::adaptors::moved.
+template<class It>
+class moved_range
+{
+   public:
+   typedef ::boost::move_iterator<It>  iterator;
+   typedef iterator                    const_iterator;
+
+   moved_range(It first, It last)
+      : m_first(first), m_last(last)
+   {}
+
+   iterator begin() const
+   {  return iterator(m_first);  }
+
+   iterator end() const
+   {  return iterator(m_last);  }
+
+   bool empty() const
+   {  return m_first == m_last;  }
+
+   private:
+   It m_first;
+   It m_last;
+};
+
+//! View of the elements of a range that satisfy a predicate, created with
+//! range | movelib::adaptors::filtered(pred).
+template<class It, class Pred>
+class filtered_range
+{
+   public:
+   typedef filter_iterator<It, Pred>   iterator;
+   typedef iterator                    const_iterator;
+
+   filtered_range(It first, It last, const Pred &pred)
+      : m_first(first, last, pred), m_last(last, last, pred)
+   {}
+
+   iterator begin() const
+   {  return m_first;  }
+
+   iterator end() const
+   {  return m_last;  }
+
+   bool empty() const
+   {  return m_first == m_last;  }
+
+   private:
+   //The first element is searched once, when the view is created
+   iterator m_first;
+   iterator m_last;
+};
+
+//! View of the results of a function applied to the elements of a range,
+//! created with range | movelib::adaptors::transformed(f).
+template<class It, class F>
+class transformed_range
+{
+   public:
+   typedef transform_iterator<It, F>   iterator;
+   typedef iterator                    const_iterator;
+
+   transformed_range(It first, It last, const F &f)
+      : m_first(first, f), m_last(last, f)
+   {}
+
+   iterator begin() const
+   {  return m_first;  }
+
+   iterator end() const
+   {  return m_last;  }
+
+   bool empty() const
+   {  return m_first == m_last;  }
+
+   private:
+   iterator m_first;
+   iterator m_last;
+};
+
+namespace adaptors {
+
+/// @cond
+
+struct moved_t {};
+
+template<class Pred>
+struct filter_holder
+{
+   Pred pred;
+};
+
+template<class F>
+struct transform_holder
+{
+   F f;
+};
+
+/// @endcond
+
+//! Adaptor object: range | moved is a moved_range over range.
+//! Also available as boost::adaptors::moved.
+const moved_t moved = moved_t();
+
+//! <b>Returns</b>: An adaptor that, applied with range | filtered(pred),
+//!   creates a filtered_range.
+//!
+//! pred is called with const lvalues, so it never consumes the elements.
+//! Dereferencing a filtered iterator and testing the predicate each
+//! dereference the underlying iterator: when filtering a transformed
+//! view, the function runs twice for each selected element. Filter
+//! before transforming if the function consumes its argument.
+template<class Pred>
+filter_holder<Pred> filtered(const Pred &pred)
+{
+   const filter_holder<Pred> h = { pred };
+   return h;
+}
+
+//! <b>Returns</b>: An adaptor that, applied with range | transformed(f),
+//!   creates a transformed_range. In C++03 compilers F must define
+//!   result_type (see boost::result_of).
+template<class F>
+transform_holder<F> transformed(const F &f)
+{
+   const transform_holder<F> h = { f };
+   return h;
+}
+
+template<class Range>
+moved_range<typename ::boost::move_detail::range_iterator<Range>::type>
+   operator|(Range &r, moved_t)
+{
+   return moved_range<typename ::boost::move_detail::range_iterator<Range>::type>(r.begin(), r.end());
+}
+
+template<class Range>
+moved_range<typename ::boost::move_detail::range_iterator<const Range>::type>
+   operator|(const Range &r, moved_t)
+{
+   return moved_range<typename ::boost::move_detail::range_iterator<const Range>::type>(r.begin(), r.end());
+}
+
+template<class Range, class Pred>
+filtered_range<typename ::boost::move_detail::range_iterator<Range>::type, Pred>
+   operator|(Range &r, const filter_holder<Pred> &h)
+{
+   return filtered_range<typename ::boost::move_detail::range_iterator<Range>::type, Pred>
+      (r.begin(), r.end(), h.pred);
+}
+
+template<class Range, class Pred>
+filtered_range<typename ::boost::move_detail::range_iterator<const Range>::type, Pred>
+   operator|(const Range &r, const filter_holder<Pred> &h)
+{
+   return filtered_range<typename ::boost::move_detail::range_iterator<const Range>::type, Pred>
+      (r.begin(), r.end(), h.pred);
+}
+
+template<class Range, class F>
+transformed_range<typename ::boost::move_detail::range_iterator<Range>::type, F>
+   operator|(Range &r, const transform_holder<F> &h)
+{
+   return transformed_range<typename ::boost::move_detail::range_iterator<Range>::type, F>
+      (r.begin(), r.end(), h.f);
+}
+
+template<class Range, class F>
+transformed_range<typename ::boost::move_detail::range_iterator<const Range>::type, F>
+   operator|(const Range &r, const transform_holder<F> &h)
+{
+   return transformed_range<typename ::boost::move_detail::range_iterator<const Range>::type, F>
+      (r.begin(), r.end(), h.f);
+}
+
+}  //namespace adaptors {
+
+//! <b>Effects</b>: Appends the elements of r to c with c.push_back(*it),
+//!   so the elements of a moved view, or rvalues returned by a transformed
+//!   one, are moved. If the size of r is known without traversing it
+//!   (random access iterators, as in moved and transformed views of
+//!   vectors) and c has reserve(), reserves room for all of them first.
+template<class Range, class Container>
+void move_to(const Range &r, Container &c)
+{
+   typedef typename ::boost::move_detail::range_iterator<const Range>::type   iterator;
+   typedef typename std::iterator_traits<iterator>::iterator_category         category;
+   const iterator last = r.end();
+   iterator it = r.begin();
+   ::boost::move_detail::reserve_for
+      ( c, it, last, category()
+      , ::boost::integral_constant<bool, ::boost::move_detail::has_member_reserve<Container>::value>());
+   for(; it != last; ++it){
+      #if !defined(BOOST_NO_RVALUE_REFERENCES)
+      c.push_back(*it);
+      #else
+      typedef typename std::iterator_traits<iterator>::reference reference;
+      ::boost::move_detail::push_back_from
+         (c, it, ::boost::integral_constant<bool, ::boost::is_reference<reference>::value>());
+      #endif
+   }
+}
+
+}  //namespace movelib {
+
+namespace adaptors {
+
+using ::boost::movelib::adaptors::moved;
+
+}  //namespace adaptors {
+
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_ADAPTORS_HPP
@@ -0,0 +1,801 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_ALGORITHM_HPP
+#define BOOST_MOVE_ALGORITHM_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/detail/heap_sort.hpp>
+#include <cstddef>      //std::size_t
+#include <functional>   //std::equal_to, std::less
+#include <iterator>     //std::iterator_traits
+#include <new>          //placement new
+#include <vector>
+
+namespace boost {
+
+/// @cond
+
+namespace move_detail {
+
+//Which elements a set operation outputs: the ones only in the first range,
+//the ones only in the second range and, for equivalent pairs, the first
+//range's element.
+template<bool FirstOnly, bool SecondOnly, bool Both>
+struct set_op_kind
+{
+   static const bool first_only  = FirstOnly;
+   static const bool second_only = SecondOnly;
+   static const bool both        = Both;
+};
+
+typedef set_op_kind<true,  true,  true>   set_union_kind;
+typedef set_op_kind<false, false, true>   set_intersection_kind;
+typedef set_op_kind<true,  false, false>  set_difference_kind;
+typedef set_op_kind<true,  true,  false>  set_symmetric_difference_kind;
+
+//Move assigns to an initialized output
+struct set_op_assign
+{
+   template<class I, class O>
+   static void put(I &it, O &out)
+   {
+      *out = ::boost::move(*it);
+      ++it;
+      ++out;
+   }
+
+   template<class I, class O>
+   static void put_range(I f, I l, O &out)
+   {  out = ::boost::move(f, l, out);  }
+};
+
+//Move constructs in uninitialized storage, advancing out after each
+//element so that the caller can destroy the constructed ones on failure
+struct set_op_construct
+{
+   template<class I, class O>
+   static void put(I &it, O &out)
+   {
+      typedef typename std::iterator_traits<O>::value_type value_type;
+      ::new(static_cast<void*>(&*out)) value_type(::boost::move(*it));
+      ++it;
+      ++out;
+   }
+
+   template<class I, class O>
+   static void put_range(I f, I l, O &out)
+   {
+      while(f != l){
+         put(f, out);
+      }
+   }
+};
+
+template<class Kind, class Op, class I1, class I2, class O, class Compare>
+void set_op(I1 f1, I1 l1, I2 f2, I2 l2, O &out, Compare comp)
+{
+   while(f1 != l1 && f2 != l2){
+      if(comp(*f1, *f2)){
+         if(Kind::first_only)
+            Op::put(f1, out);
+         else
+            ++f1;
+      }
+      else if(comp(*f2, *f1)){
+         if(Kind::second_only)
+            Op::put(f2, out);
+         else
+            ++f2;
+      }
+      else{
+         if(Kind::both)
+            Op::put(f1, out);
+         else
+            ++f1;
+         ++f2;
+      }
+   }
+   if(Kind::first_only)
+      Op::put_range(f1, l1, out);
+   if(Kind::second_only)
+      Op::put_range(f2, l2, out);
+}
+
+template<class Kind, class I1, class I2, class O, class Compare>
+O set_op_move(I1 f1, I1 l1, I2 f2, I2 l2, O out, Compare comp)
+{
+   set_op<Kind, set_op_assign>(f1, l1, f2, l2, out, comp);
+   return out;
+}
+
+template<class Kind, class I1, class I2, class F, class Compare>
+F set_op_uninitialized_move(I1 f1, I1 l1, I2 f2, I2 l2, F out, Compare comp)
+{
+   typedef typename std::iterator_traits<F>::value_type value_type;
+   F cur = out;
+   try{
+      set_op<Kind, set_op_construct>(f1, l1, f2, l2, cur, comp);
+   }
+   catch(...){
+      for(; out != cur; ++out){
+         (*out).~value_type();
+      }
+      throw;
+   }
+   return cur;
+}
+
+//Compares the elements referenced by two iterators
+template<class It, class Compare>
+struct indirect_compare
+{
+   Compare comp;
+
+   bool operator()(const It &a, const It &b) const
+   {  return comp(*a, *b);  }
+};
+
+template<class RandIt>
+void swap_by_move(RandIt a, RandIt b)
+{
+   typedef typename std::iterator_traits<RandIt>::value_type value_type;
+   value_type v(::boost::move(*a));
+   *a = ::boost::move(*b);
+   *b = ::boost::move(v);
+}
+
+template<class RandIt, class Compare>
+void insertion_sort(RandIt first, RandIt last, Compare comp)
+{
+   typedef typename std::iterator_traits<RandIt>::value_type value_type;
+   if(first == last){
+      return;
+   }
+   for(RandIt i = first + 1; i != last; ++i){
+      if(comp(*i, *first)){
+         value_type v(::boost::move(*i));
+         ::boost::move_backward(first, i, i + 1);
+         *first = ::boost::move(v);
+      }
+      else if(comp(*i, *(i - 1))){
+         //*first is a sentinel: v is not less than it
+         value_type v(::boost::move(*i));
+         RandIt j = i;
+         do{
+            *j = ::boost::move(*(j - 1));
+            --j;
+         } while(comp(v, *(j - 1)));
+         *j = ::boost::move(v);
+      }
+   }
+}
+
+//Moves the median of *first, *mid and *(last - 1) to *first and
+//partitions [first, last) around it. Returns the final position of the
+//pivot: the elements before it are not greater and the ones after it
+//are not less than it.
+template<class RandIt, class Compare>
+RandIt partition_around_median(RandIt first, RandIt last, Compare comp)
+{
+   RandIt a = first + 1, mid = first + (last - first)/2, b = last - 1;
+   if(comp(*mid, *a))
+      ::boost::move_detail::swap_by_move(a, mid);
+   if(comp(*b, *mid)){
+      ::boost::move_detail::swap_by_move(mid, b);
+      if(comp(*mid, *a))
+         ::boost::move_detail::swap_by_move(a, mid);
+   }
+   ::boost::move_detail::swap_by_move(first, mid);
+   RandIt i = first + 1, j = last - 1;
+   while(true){
+      while(i <= j && comp(*i, *first)){
+         ++i;
+      }
+      while(i <= j && comp(*first, *j)){
+         --j;
+      }
+      if(i >= j){
+         break;
+      }
+      ::boost::move_detail::swap_by_move(i, j);
+      ++i;
+      --j;
+   }
+   ::boost::move_detail::swap_by_move(first, j);
+   return j;
+}
+
+}  //namespace move_detail {
+
+/// @endcond
+
+namespace movelib {
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//                               remove_if
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! <b>Effects</b>: Removes the elements of [first, last) for which pred
+//!   returns true, moving the remaining ones to the front of the range
+//!   in their original order. The elements in [return value, last) are
+//!   left in a valid but unspecified (moved-from) state.
+//!
+//!   Each run of consecutive surviving elements is moved with a single
+//!   call to ::boost::move, which moves contiguous runs of elements with
+//!   trivial assignment with a memmove and, for segmented iterators (like
+//!   movelib::deque's), block by block.
+//!
+//! <b>Returns</b>: The end of the range of surviving elements.
+//!
+//! <b>Complexity</b>: Exactly last - first applications of pred and at
+//!   most last - first move assignments.
+template<class ForwardIt, class Pred>
+ForwardIt remove_if(ForwardIt first, ForwardIt last, Pred pred)
+{
+   //Skip the leading survivors, they stay in place
+   while(first != last && !pred(*first)){
+      ++first;
+   }
+   if(first == last){
+      return first;
+   }
+   ForwardIt out = first;
+   ++first;
+   while(true){
+      while(first != last && pred(*first)){
+         ++first;
+      }
+      if(first == last){
+         return out;
+      }
+      ForwardIt run_end = first;
+      ++run_end;
+      while(run_end != last && !pred(*run_end)){
+         ++run_end;
+      }
+      out = ::boost::move(first, run_end, out);
+      if(run_end == last){
+         return out;
+      }
+      //*run_end is removed
+      first = ++run_end;
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//                               unique
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! <b>Effects</b>: Removes from every group of consecutive equivalent
+//!   elements of [first, last) all but the first one, comparing each
+//!   element with the last kept one with pred. The kept elements are moved
+//!   to the front of the range in their original order, a run of
+//!   consecutive kept elements with a single call to ::boost::move (see
+//!   remove_if).
+//!
+//! <b>Returns</b>: The end of the range of kept elements.
+//!
+//! <b>Complexity</b>: For nonempty ranges, exactly (last - first) - 1
+//!   applications of pred and at most last - first move assignments.
+template<class ForwardIt, class BinaryPred>
+ForwardIt unique(ForwardIt first, ForwardIt last, BinaryPred pred)
+{
+   if(first == last){
+      return last;
+   }
+   //Skip the leading kept elements, they stay in place
+   ForwardIt kept = first;
+   while(++first != last && !pred(*kept, *first)){
+      kept = first;
+   }
+   if(first == last){
+      return last;
+   }
+   ForwardIt out = first;
+   while(++first != last && pred(*kept, *first)){}
+   while(first != last){
+      //[first, run_end) are kept: each one differs from its predecessor
+      kept = first;
+      ForwardIt run_end = first;
+      while(++run_end != last && !pred(*kept, *run_end)){
+         kept = run_end;
+      }
+      //Skip the duplicates of the run's last element before moving it.
+      //*run_end, if any, is already known to be one.
+      ForwardIt next = run_end;
+      if(next != last){
+         while(++next != last && pred(*kept, *next)){}
+      }
+      out = ::boost::move(first, run_end, out);
+      first = next;
+   }
+   return out;
+}
+
+//! <b>Effects</b>: unique(first, last, std::equal_to&lt;value_type&gt;()).
+template<class ForwardIt>
+ForwardIt unique(ForwardIt first, ForwardIt last)
+{
+   typedef typename std::iterator_traits<ForwardIt>::value_type value_type;
+   return ::boost::movelib::unique(first, last, std::equal_to<value_type>());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//                            set operations
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! <b>Requires</b>: [first1, last1) and [first2, last2) are sorted by comp.
+//!
+//! <b>Effects</b>: Same as std::set_union, but the output elements are move
+//!   assigned from the inputs instead of copied. When an element of the
+//!   first range is equivalent to one of the second range, the element of
+//!   the first range is moved and the one of the second range is left
+//!   untouched. The remaining elements of the range that is not exhausted
+//!   are moved with a single call to ::boost::move.
+//!
+//! <b>Returns</b>: The end of the output range.
+//!
+//! <b>Complexity</b>: At most 2*((last1 - first1) + (last2 - first2)) - 1
+//!   comparisons.
+template<class InputIt1, class InputIt2, class OutputIt, class Compare>
+OutputIt set_union_move
+   (InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt out, Compare comp)
+{
+   return ::boost::move_detail::set_op_move< ::boost::move_detail::set_union_kind>
+      (first1, last1, first2, last2, out, comp);
+}
+
+//! <b>Effects</b>: set_union_move(first1, last1, first2, last2, out, std::less&lt;value_type&gt;()).
+template<class InputIt1, class InputIt2, class OutputIt>
+OutputIt set_union_move(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt out)
+{
+   typedef typename std::iterator_traits<InputIt1>::value_type value_type;
+   return ::boost::movelib::set_union_move(first1, last1, first2, last2, out, std::less<value_type>());
+}
+
+//! <b>Effects</b>: Same as std::set_intersection, but the output elements
+//!   are move assigned from the first range. The elements of the second
+//!   range are never moved.
+//!
+//! <b>Returns</b>: The end of the output range.
+template<class InputIt1, class InputIt2, class OutputIt, class Compare>
+OutputIt set_intersection_move
+   (InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt out, Compare comp)
+{
+   return ::boost::move_detail::set_op_move< ::boost::move_detail::set_intersection_kind>
+      (first1, last1, first2, last2, out, comp);
+}
+
+//! <b>Effects</b>: set_intersection_move(first1, last1, first2, last2, out, std::less&lt;value_type&gt;()).
+template<class InputIt1, class InputIt2, class OutputIt>
+OutputIt set_intersection_move(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt out)
+{
+   typedef typename std::iterator_traits<InputIt1>::value_type value_type;
+   return ::boost::movelib::set_intersection_move(first1, last1, first2, last2, out, std::less<value_type>());
+}
+
+//! <b>Effects</b>: Same as std::set_difference, but the output elements
+//!   are move assigned from the first range. The elements of the second
+//!   range are never moved.
+//!
+//! <b>Returns</b>: The end of the output range.
+template<class InputIt1, class InputIt2, class OutputIt, class Compare>
+OutputIt set_difference_move
+   (InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt out, Compare comp)
+{
+   return ::boost::move_detail::set_op_move< ::boost::move_detail::set_difference_kind>
+      (first1, last1, first2, last2, out, comp);
+}
+
+//! <b>Effects</b>: set_difference_move(first1, last1, first2, last2, out, std::less&lt;value_type&gt;()).
+template<class InputIt1, class InputIt2, class OutputIt>
+OutputIt set_difference_move(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt out)
+{
+   typedef typename std::iterator_traits<InputIt1>::value_type value_type;
+   return ::boost::movelib::set_difference_move(first1, last1, first2, last2, out, std::less<value_type>());
+}
+
+//! <b>Effects</b>: Same as std::set_symmetric_difference, but the output
+//!   elements are move assigned from the range they come from. Elements
+//!   with an equivalent one in the other range are not moved.
+//!
+//! <b>Returns</b>: The end of the output range.
+template<class InputIt1, class InputIt2, class OutputIt, class Compare>
+OutputIt set_symmetric_difference_move
+   (InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt out, Compare comp)
+{
+   return ::boost::move_detail::set_op_move< ::boost::move_detail::set_symmetric_difference_kind>
+      (first1, last1, first2, last2, out, comp);
+}
+
+//! <b>Effects</b>: set_symmetric_difference_move(first1, last1, first2, last2, out, std::less&lt;value_type&gt;()).
+template<class InputIt1, class InputIt2, class OutputIt>
+OutputIt set_symmetric_difference_move(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt out)
+{
+   typedef typename std::iterator_traits<InputIt1>::value_type value_type;
+   return ::boost::movelib::set_symmetric_difference_move(first1, last1, first2, last2, out, std::less<value_type>());
+}
+
+//! <b>Effects</b>: Same as set_union_move, but the output elements are move
+//!   constructed in the uninitialized storage starting at out.
+//!
+//! <b>Returns</b>: The end of the constructed range.
+//!
+//! <b>Throws</b>: If a comparison or a move constructor throws, the
+//!   constructed elements are destroyed. The inputs are left in a valid
+//!   but unspecified state.
+template<class InputIt1, class InputIt2, class ForwardIt, class Compare>
+ForwardIt uninitialized_set_union_move
+   (InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, ForwardIt out, Compare comp)
+{
+   return ::boost::move_detail::set_op_uninitialized_move< ::boost::move_detail::set_union_kind>
+      (first1, last1, first2, last2, out, comp);
+}
+
+template<class InputIt1, class InputIt2, class ForwardIt>
+ForwardIt uninitialized_set_union_move(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, ForwardIt out)
+{
+   typedef typename std::iterator_traits<InputIt1>::value_type value_type;
+   return ::boost::movelib::uninitialized_set_union_move(first1, last1, first2, last2, out, std::less<value_type>());
+}
+
+//! <b>Effects</b>: Same as set_intersection_move, but the output elements
+//!   are move constructed in the uninitialized storage starting at out.
+//!
+//! <b>Returns</b>: The end of the constructed range.
+//!
+//! <b>Throws</b>: See uninitialized_set_union_move.
+template<class InputIt1, class InputIt2, class ForwardIt, class Compare>
+ForwardIt uninitialized_set_intersection_move
+   (InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, ForwardIt out, Compare comp)
+{
+   return ::boost::move_detail::set_op_uninitialized_move< ::boost::move_detail::set_intersection_kind>
+      (first1, last1, first2, last2, out, comp);
+}
+
+template<class InputIt1, class InputIt2, class ForwardIt>
+ForwardIt uninitialized_set_intersection_move(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, ForwardIt out)
+{
+   typedef typename std::iterator_traits<InputIt1>::value_type value_type;
+   return ::boost::movelib::uninitialized_set_intersection_move(first1, last1, first2, last2, out, std::less<value_type>());
+}
+
+//! <b>Effects</b>: Same as set_difference_move, but the output elements
+//!   are move constructed in the uninitialized storage starting at out.
+//!
+//! <b>Returns</b>: The end of the constructed range.
+//!
+//! <b>Throws</b>: See uninitialized_set_union_move.
+template<class InputIt1, class InputIt2, class ForwardIt, class Compare>
+ForwardIt uninitialized_set_difference_move
+   (InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, ForwardIt out, Compare comp)
+{
+   return ::boost::move_detail::set_op_uninitialized_move< ::boost::move_detail::set_difference_kind>
+      (first1, last1, first2, last2, out, comp);
+}
+
+template<class InputIt1, class InputIt2, class ForwardIt>
+ForwardIt uninitialized_set_difference_move(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, ForwardIt out)
+{
+   typedef typename std::iterator_traits<InputIt1>::value_type value_type;
+   return ::boost::movelib::uninitialized_set_difference_move(first1, last1, first2, last2, out, std::less<value_type>());
+}
+
+//! <b>Effects</b>: Same as set_symmetric_difference_move, but the output
+//!   elements are move constructed in the uninitialized storage starting
+//!   at out.
+//!
+//! <b>Returns</b>: The end of the constructed range.
+//!
+//! <b>Throws</b>: See uninitialized_set_union_move.
+template<class InputIt1, class InputIt2, class ForwardIt, class Compare>
+ForwardIt uninitialized_set_symmetric_difference_move
+   (InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, ForwardIt out, Compare comp)
+{
+   return ::boost::move_detail::set_op_uninitialized_move< ::boost::move_detail::set_symmetric_difference_kind>
+      (first1, last1, first2, last2, out, comp);
+}
+
+template<class InputIt1, class InputIt2, class ForwardIt>
+ForwardIt uninitialized_set_symmetric_difference_move(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, ForwardIt out)
+{
+   typedef typename std::iterator_traits<InputIt1>::value_type value_type;
+   return ::boost::movelib::uninitialized_set_symmetric_difference_move(first1, last1, first2, last2, out, std::less<value_type>());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//                             partial_sort
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! <b>Effects</b>: Same as std::partial_sort: places in [first, middle)
+//!   the middle - first smallest elements of [first, last) sorted by comp.
+//!   The order of the elements of [middle, last) is unspecified.
+//!
+//!   Elements are only moved, never copied, so movable-only types are
+//!   supported in C++03 compilers. An element of [middle, last) that does
+//!   not enter the result costs a single comparison and is not moved.
+//!
+//! <b>Complexity</b>: O((last - first) log(middle - first)) comparisons.
+template<class RandIt, class Compare>
+void partial_sort(RandIt first, RandIt middle, RandIt last, Compare comp)
+{
+   typedef typename std::iterator_traits<RandIt>::value_type      value_type;
+   typedef typename std::iterator_traits<RandIt>::difference_type difference_type;
+   if(first == middle){
+      return;
+   }
+   ::boost::move_detail::heap_make(first, middle, comp);
+   const difference_type len = middle - first;
+   for(RandIt it = middle; it != last; ++it){
+      if(comp(*it, *first)){
+         //Replace the greatest element of the heap
+         value_type v(::boost::move(*it));
+         *it = ::boost::move(*first);
+         ::boost::move_detail::heap_sift_hole(first, 0, len, v, comp);
+      }
+   }
+   for(; middle - first > 1; --middle){
+      ::boost::move_detail::heap_pop(first, middle, comp);
+   }
+}
+
+//! <b>Effects</b>: partial_sort(first, middle, last, std::less&lt;value_type&gt;()).
+template<class RandIt>
+void partial_sort(RandIt first, RandIt middle, RandIt last)
+{
+   typedef typename std::iterator_traits<RandIt>::value_type value_type;
+   ::boost::movelib::partial_sort(first, middle, last, std::less<value_type>());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//                             nth_element
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! <b>Effects</b>: Same as std::nth_element: rearranges [first, last) so
+//!   that *nth is the element that would be there if the range was sorted
+//!   by comp, no element of [first, nth) is greater than it and no element
+//!   of (nth, last) is less than it. Elements are only moved, never copied.
+//!
+//!   Partitions around a median of three pivot, falling back to
+//!   partial_sort if the partitions do not shrink fast enough, and sorts
+//!   small ranges by insertion.
+//!
+//! <b>Complexity</b>: O(last - first) comparisons on average,
+//!   O((last - first) log(last - first)) in the worst case.
+template<class RandIt, class Compare>
+void nth_element(RandIt first, RandIt nth, RandIt last, Compare comp)
+{
+   typedef typename std::iterator_traits<RandIt>::difference_type difference_type;
+   const difference_type insertion_sort_limit = 16;
+   if(nth == last){
+      return;
+   }
+   difference_type depth = 0;
+   for(difference_type n = last - first; n > 1; n /= 2){
+      depth += 2;
+   }
+   while(last - first > insertion_sort_limit){
+      if(!depth--){
+         ::boost::movelib::partial_sort(first, nth + 1, last, comp);
+         return;
+      }
+      const RandIt cut = ::boost::move_detail::partition_around_median(first, last, comp);
+      if(cut == nth){
+         return;
+      }
+      else if(nth < cut){
+         last = cut;
+      }
+      else{
+         first = cut + 1;
+      }
+   }
+   ::boost::move_detail::insertion_sort(first, last, comp);
+}
+
+//! <b>Effects</b>: nth_element(first, nth, last, std::less&lt;value_type&gt;()).
+template<class RandIt>
+void nth_element(RandIt first, RandIt nth, RandIt last)
+{
+   typedef typename std::iterator_traits<RandIt>::value_type value_type;
+   ::boost::movelib::nth_element(first, nth, last, std::less<value_type>());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//                                top_k
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! <b>Effects</b>: Moves to out, sorted by comp, the min(k, last - first)
+//!   smallest elements of [first, last) (use a comparison like
+//!   std::greater to select the greatest ones).
+//!
+//!   A bounded max-heap of iterators holds the best k elements found so
+//!   far, so the input is not modified until the winners are known and
+//!   only they are moved, each one exactly once. An element that does
+//!   not enter the heap costs a single comparison.
+//!
+//! <b>Returns</b>: The end of the output range.
+//!
+//! <b>Complexity</b>: O((last - first) log k) comparisons, min(k, last - first)
+//!   move assignments and O(k) memory.
+template<class ForwardIt, class OutputIt, class Compare>
+OutputIt top_k(ForwardIt first, ForwardIt last, std::size_t k, OutputIt out, Compare comp)
+{
+   typedef typename std::vector<ForwardIt>::difference_type             difference_type;
+   typedef ::boost::move_detail::indirect_compare<ForwardIt, Compare>   icomp_t;
+   if(!k){
+      return out;
+   }
+   const icomp_t icomp = { comp };
+   std::vector<ForwardIt> heap;
+   for(; first != last && heap.size() != k; ++first){
+      heap.push_back(first);
+   }
+   ::boost::move_detail::heap_make(heap.begin(), heap.end(), icomp);
+   const difference_type len = difference_type(heap.size());
+   for(; first != last; ++first){
+      if(comp(*first, *heap[0])){
+         ForwardIt it(first);
+         ::boost::move_detail::heap_sift_hole(heap.begin(), 0, len, it, icomp);
+      }
+   }
+   ::boost::move_detail::heap_sort(heap.begin(), heap.end(), icomp);
+   for(std::size_t i = 0; i != heap.size(); ++i){
+      *out = ::boost::move(*heap[i]);
+      ++out;
+   }
+   return out;
+}
+
+//! <b>Effects</b>: top_k(first, last, k, out, std::less&lt;value_type&gt;()).
+template<class ForwardIt, class OutputIt>
+OutputIt top_k(ForwardIt first, ForwardIt last, std::size_t k, OutputIt out)
+{
+   typedef typename std::iterator_traits<ForwardIt>::value_type value_type;
+   return ::boost::movelib::top_k(first, last, k, out, std::less<value_type>());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//                          fold_left / accumulate
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! <b>Effects</b>: For each iterator it in [first, last), in order,
+//!   performs init = op(::boost::move(init), *it). The accumulator is
+//!   moved into op and its result moved back, so an op that takes the
+//!   accumulator by value or by BOOST_RV_REF and extends it (for example
+//!   appending to a string or a vector) does not copy it at every step.
+//!
+//! <b>Returns</b>: The final value of init (moved).
+//!
+//! <b>Complexity</b>: Exactly last - first applications of op.
+template<class InputIt, class T, class BinaryOp>
+T fold_left(InputIt first, InputIt last, T init, BinaryOp op)
+{
+   for(; first != last; ++first){
+      init = op(::boost::move(init), *first);
+   }
+   return ::boost::move(init);
+}
+
+//! <b>Effects</b>: fold_left(first, last, init, op).
+template<class InputIt, class T, class BinaryOp>
+T accumulate(InputIt first, InputIt last, T init, BinaryOp op)
+{
+   return ::boost::movelib::fold_left<InputIt, T, BinaryOp>(first, last, ::boost::move(init), op);
+}
+
+//! <b>Requires</b>: init += *it is a valid expression.
+//!
+//! <b>Effects</b>: Same as std::accumulate(first, last, init), but
+//!   computed as init += *it. This extends the accumulator in place
+//!   instead of building a new one from init + *it at every step, which
+//!   is quadratic for strings and other growing accumulators in C++03
+//!   compilers (whose temporaries can't be moved from).
+//!
+//! <b>Returns</b>: The final value of init (moved).
+template<class InputIt, class T>
+T accumulate(InputIt first, InputIt last, T init)
+{
+   for(; first != last; ++first){
+      init += *first;
+   }
+   return ::boost::move(init);
+}
+
+//! <b>Effects</b>: fold_left(make_move_iterator(first), make_move_iterator(last), init, op):
+//!   like fold_left, but op also receives the elements as rvalues, so it
+//!   can consume them. The elements of [first, last) are left in a valid
+//!   but unspecified state.
+//!
+//! <b>Returns</b>: The final value of init (moved).
+template<class InputIt, class T, class BinaryOp>
+T move_reduce(InputIt first, InputIt last, T init, BinaryOp op)
+{
+   typedef ::boost::move_iterator<InputIt> move_it;
+   return ::boost::movelib::fold_left<move_it, T, BinaryOp>
+      (::boost::make_move_iterator(first), ::boost::make_move_iterator(last), ::boost::move(init), op);
+}
+
+//! <b>Requires</b>: init += ::boost::move(*it) is a valid expression.
+//!
+//! <b>Effects</b>: Same as accumulate(first, last, init), but the elements
+//!   are moved into the accumulator.
+//!
+//! <b>Returns</b>: The final value of init (moved).
+template<class InputIt, class T>
+T move_reduce(InputIt first, InputIt last, T init)
+{
+   typedef ::boost::move_iterator<InputIt> move_it;
+   return ::boost::movelib::accumulate<move_it, T>
+      (::boost::make_move_iterator(first), ::boost::make_move_iterator(last), ::boost::move(init));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//                               erase_if
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! <b>Requires</b>: Container is a sequence with forward iterators and an
+//!   erase(first, last) member (std::vector, small_vector, deque...).
+//!
+//! <b>Effects</b>: Erases the elements of c for which pred returns true
+//!   with remove_if, so surviving elements are moved in runs.
+//!
+//! <b>Returns</b>: The number of erased elements.
+template<class Container, class Pred>
+typename Container::size_type erase_if(Container &c, Pred pred)
+{
+   const typename Container::size_type old_size = c.size();
+   c.erase(::boost::movelib::remove_if(c.begin(), c.end(), pred), c.end());
+   return old_size - c.size();
+}
+
+//! <b>Effects</b>: Erases the consecutive duplicates of c with unique.
+//!
+//! <b>Returns</b>: The number of erased elements.
+template<class Container, class BinaryPred>
+typename Container::size_type erase_unique(Container &c, BinaryPred pred)
+{
+   const typename Container::size_type old_size = c.size();
+   c.erase(::boost::movelib::unique(c.begin(), c.end(), pred), c.end());
+   return old_size - c.size();
+}
+
+template<class Container>
+typename Container::size_type erase_unique(Container &c)
+{
+   const typename Container::size_type old_size = c.size();
+   c.erase(::boost::movelib::unique(c.begin(), c.end()), c.end());
+   return old_size - c.size();
+}
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_ALGORITHM_HPP
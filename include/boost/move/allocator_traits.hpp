@@ -0,0 +1,175 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_ALLOCATOR_TRAITS_HPP
+#define BOOST_MOVE_ALLOCATOR_TRAITS_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_empty.hpp>
+#include <iterator>  //std::advance
+
+namespace boost {
+
+/// @cond
+
+namespace move_detail {
+
+//Defines allocator_NAME<A, Default>::type as A::NAME if it exists and
+//Default otherwise
+#define BOOST_MOVE_ALLOCATOR_NESTED_TYPE(NAME)                                   \
+template<class A>                                                                \
+struct has_allocator_##NAME                                                      \
+{                                                                                \
+   template<class U> static char test(typename U::NAME *);                       \
+   template<class U> static int  test(...);                                      \
+   static const bool value = sizeof(test<A>(0)) == sizeof(char);                 \
+};                                                                               \
+                                                                                 \
+template<class A, class Default, bool = has_allocator_##NAME<A>::value>          \
+struct allocator_##NAME                                                          \
+{  typedef Default type;  };                                                     \
+                                                                                 \
+template<class A, class Default>                                                 \
+struct allocator_##NAME<A, Default, true>                                        \
+{                                                                                \
+   typedef ::boost::integral_constant                                            \
+      <bool, A::NAME::value> type;                                               \
+};                                                                               \
+//
+
+BOOST_MOVE_ALLOCATOR_NESTED_TYPE(propagate_on_container_copy_assignment)
+BOOST_MOVE_ALLOCATOR_NESTED_TYPE(propagate_on_container_move_assignment)
+BOOST_MOVE_ALLOCATOR_NESTED_TYPE(propagate_on_container_swap)
+BOOST_MOVE_ALLOCATOR_NESTED_TYPE(is_always_equal)
+
+#undef BOOST_MOVE_ALLOCATOR_NESTED_TYPE
+
+}  //namespace move_detail {
+
+/// @endcond
+
+namespace movelib {
+
+//! Emulation of the propagation traits of C++0x std::allocator_traits,
+//! available for C++03 allocators. Every trait is the corresponding
+//! nested type of Allocator, if present, converted to a
+//! boost::integral_constant. Otherwise:
+//!
+//! - propagate_on_container_copy_assignment, propagate_on_container_move_assignment
+//!   and propagate_on_container_swap are false_type.
+//! - is_always_equal is true if Allocator is an empty class.
+template<class Allocator>
+struct allocator_traits
+{
+   typedef Allocator                                     allocator_type;
+   typedef typename Allocator::value_type                value_type;
+   typedef typename Allocator::size_type                 size_type;
+
+   typedef typename ::boost::move_detail::allocator_propagate_on_container_copy_assignment
+      <Allocator, ::boost::false_type>::type             propagate_on_container_copy_assignment;
+   typedef typename ::boost::move_detail::allocator_propagate_on_container_move_assignment
+      <Allocator, ::boost::false_type>::type             propagate_on_container_move_assignment;
+   typedef typename ::boost::move_detail::allocator_propagate_on_container_swap
+      <Allocator, ::boost::false_type>::type             propagate_on_container_swap;
+   typedef typename ::boost::move_detail::allocator_is_always_equal
+      < Allocator
+      , ::boost::integral_constant<bool, ::boost::is_empty<Allocator>::value>
+      >::type                                            is_always_equal;
+
+   //! <b>Returns</b>: true if memory allocated by a can be deallocated by b.
+   static bool equal(const Allocator &a, const Allocator &b)
+   {  return is_always_equal::value || a == b;  }
+
+   //! <b>Returns</b>: true if a container using dst_alloc can take the memory
+   //!   of a container using src_alloc on move assignment.
+   static bool can_steal_on_move_assignment(const Allocator &dst_alloc, const Allocator &src_alloc)
+   {  return propagate_on_container_move_assignment::value || equal(dst_alloc, src_alloc);  }
+};
+
+}  //namespace movelib {
+
+/// @cond
+
+namespace move_detail {
+
+template<class Container>
+Container &move_assign_container(Container &dst, Container &src)
+{
+   typedef ::boost::movelib::allocator_traits<typename Container::allocator_type> traits_t;
+   if(&dst == &src){
+      return dst;
+   }
+   if(traits_t::can_steal_on_move_assignment(dst.get_allocator(), src.get_allocator())){
+      dst.swap(src);
+      src.clear();
+   }
+   else{
+      typedef typename Container::iterator iterator;
+      const typename Container::size_type dst_size = dst.size(), src_size = src.size();
+      iterator sf = src.begin();
+      if(dst_size < src_size){
+         iterator sl = sf;
+         std::advance(sl, dst_size);
+         ::boost::move(sf, sl, dst.begin());
+         dst.insert(dst.end(), ::boost::make_move_iterator(sl), ::boost::make_move_iterator(src.end()));
+      }
+      else{
+         iterator dl = ::boost::move(sf, src.end(), dst.begin());
+         dst.erase(dl, dst.end());
+      }
+   }
+   return dst;
+}
+
+}  //namespace move_detail {
+
+/// @endcond
+
+namespace movelib {
+
+//! <b>Requires</b>: Container is a sequence container with get_allocator(),
+//!   swap(), clear(), begin(), end(), size(), insert(pos, first, last) and
+//!   erase(first, last). If the propagate_on_container_move_assignment trait
+//!   of its allocator is true, swap() must exchange the allocators.
+//!
+//! <b>Effects</b>: Move assigns src to dst:
+//!   - If the allocator propagates on move assignment or both allocators
+//!     compare equal, dst takes the memory of src with swap() and the
+//!     previous elements of dst are destroyed. Nothing is moved element-wise.
+//!   - Otherwise the memory of src can't be used by dst: the first elements
+//!     of dst are move assigned from src with boost::move and the rest are
+//!     erased or move constructed in dst with insert() and move iterators.
+//!     dst keeps its allocator and src keeps its (moved-from) elements.
+//!
+//! <b>Returns</b>: dst.
+//!
+//! <b>Throws</b>: Nothing in the first case. Otherwise any exception thrown
+//!   by the move operations of the elements or the allocation.
+template<class Container>
+Container &move_assign_container(Container &dst, BOOST_RV_REF(Container) src)
+{  return ::boost::move_detail::move_assign_container<Container>(dst, src);  }
+
+#if defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_MOVE_DOXYGEN_INVOKED)
+//C++03 containers without move emulation (like std containers) are
+//passed as lvalues by boost::move
+template<class Container>
+typename ::boost::move_detail::disable_if< ::boost::has_move_emulation_enabled<Container>, Container&>::type
+   move_assign_container(Container &dst, Container &src)
+{  return ::boost::move_detail::move_assign_container<Container>(dst, src);  }
+#endif
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_ALLOCATOR_TRAITS_HPP
@@ -0,0 +1,782 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_DEQUE_HPP
+#define BOOST_MOVE_DEQUE_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/relocate.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+#include <algorithm> //std::copy, std::swap
+#include <cstddef>   //std::size_t, std::ptrdiff_t
+#include <cstring>   //std::memcpy, std::memmove
+#include <iterator>  //std::random_access_iterator_tag
+#include <stdexcept> //std::out_of_range
+#include <new>       //placement new
+
+namespace boost {
+
+/// @cond
+
+namespace move_detail {
+
+//Elements per block: 512 bytes, but at least 16 elements
+template<class T>
+struct deque_block_size
+{
+   static const std::size_t value = sizeof(T) < 512u/16u ? 512u/sizeof(T) : 16u;
+};
+
+template<class T, class Ref, class Ptr>
+class deque_iterator
+{
+   public:
+   typedef std::random_access_iterator_tag   iterator_category;
+   typedef T                                 value_type;
+   typedef std::ptrdiff_t                    difference_type;
+   typedef Ptr                               pointer;
+   typedef Ref                               reference;
+
+   static const difference_type block_size = difference_type(deque_block_size<T>::value);
+
+   deque_iterator()
+      : m_cur(0), m_first(0), m_last(0), m_node(0)
+   {}
+
+   deque_iterator(Ptr cur, T **node)
+      : m_cur(cur), m_first(*node), m_last(*node + block_size), m_node(node)
+   {}
+
+   //Conversion from iterator to const_iterator
+   template<class Ref2, class Ptr2>
+   deque_iterator( const deque_iterator<T, Ref2, Ptr2> &x
+                 , typename enable_if_c<is_convertible<Ptr2, Ptr>::value>::type* = 0)
+      : m_cur(x.m_cur), m_first(x.m_first), m_last(x.m_last), m_node(x.m_node)
+   {}
+
+   Ref operator*() const   {  return *m_cur;  }
+   Ptr operator->() const  {  return m_cur;  }
+   Ref operator[](difference_type n) const   {  return *(*this + n);  }
+
+   deque_iterator &operator++()
+   {
+      if(++m_cur == m_last){
+         this->set_node(m_node + 1);
+         m_cur = m_first;
+      }
+      return *this;
+   }
+
+   deque_iterator operator++(int)
+   {
+      deque_iterator tmp(*this);
+      ++*this;
+      return tmp;
+   }
+
+   deque_iterator &operator--()
+   {
+      if(m_cur == m_first){
+         this->set_node(m_node - 1);
+         m_cur = m_last;
+      }
+      --m_cur;
+      return *this;
+   }
+
+   deque_iterator operator--(int)
+   {
+      deque_iterator tmp(*this);
+      --*this;
+      return tmp;
+   }
+
+   deque_iterator &operator+=(difference_type n)
+   {
+      const difference_type offset = n + (m_cur - m_first);
+      if(offset >= 0 && offset < block_size){
+         m_cur += n;
+      }
+      else{
+         const difference_type node_offset = offset > 0
+            ? offset / block_size
+            : -((-offset - 1) / block_size) - 1;
+         this->set_node(m_node + node_offset);
+         m_cur = m_first + (offset - node_offset*block_size);
+      }
+      return *this;
+   }
+
+   deque_iterator &operator-=(difference_type n)
+   {  return *this += -n;  }
+
+   friend deque_iterator operator+(deque_iterator x, difference_type n)
+   {  return x += n;  }
+
+   friend deque_iterator operator+(difference_type n, deque_iterator x)
+   {  return x += n;  }
+
+   friend deque_iterator operator-(deque_iterator x, difference_type n)
+   {  return x -= n;  }
+
+   friend difference_type operator-(const deque_iterator &l, const deque_iterator &r)
+   {  return block_size*(l.m_node - r.m_node) + (l.m_cur - l.m_first) - (r.m_cur - r.m_first);  }
+
+   friend bool operator==(const deque_iterator &l, const deque_iterator &r)
+   {  return l.m_cur == r.m_cur;  }
+
+   friend bool operator!=(const deque_iterator &l, const deque_iterator &r)
+   {  return l.m_cur != r.m_cur;  }
+
+   friend bool operator<(const deque_iterator &l, const deque_iterator &r)
+   {  return l.m_node == r.m_node ? l.m_cur < r.m_cur : l.m_node < r.m_node;  }
+
+   friend bool operator>(const deque_iterator &l, const deque_iterator &r)
+   {  return r < l;  }
+
+   friend bool operator<=(const deque_iterator &l, const deque_iterator &r)
+   {  return !(r < l);  }
+
+   friend bool operator>=(const deque_iterator &l, const deque_iterator &r)
+   {  return !(l < r);  }
+
+   void set_node(T **node)
+   {
+      m_node  = node;
+      m_first = *node;
+      m_last  = m_first + block_size;
+   }
+
+   Ptr   m_cur;
+   Ptr   m_first;
+   Ptr   m_last;
+   T   **m_node;
+};
+
+}  //namespace move_detail {
+
+//A deque iterator is a sequence of blocks of deque_block_size elements
+template<class T, class Ref, class Ptr>
+struct segmented_iterator_traits< ::boost::move_detail::deque_iterator<T, Ref, Ptr> >
+{
+   typedef ::boost::move_detail::deque_iterator<T, Ref, Ptr>   iterator;
+   typedef T **                                                segment_iterator;
+   typedef Ptr                                                 local_iterator;
+
+   static const bool is_segmented_iterator = true;
+
+   static segment_iterator segment(const iterator &it)
+   {  return it.m_node;  }
+
+   static local_iterator local(const iterator &it)
+   {  return it.m_cur;  }
+
+   static local_iterator begin(segment_iterator s)
+   {  return *s;  }
+
+   static local_iterator end(segment_iterator s)
+   {  return *s + iterator::block_size;  }
+
+   static iterator compose(segment_iterator s, local_iterator l)
+   {
+      //The end of a block is the beginning of the next one
+      if(l == end(s)){
+         ++s;
+         l = *s;
+      }
+      return iterator(l, s);
+   }
+};
+
+/// @endcond
+
+namespace movelib {
+
+//! A double-ended queue that stores its elements in fixed-size blocks,
+//! referenced from a map of block pointers.
+//!
+//! Elements never change their address when the deque grows at either end:
+//! growing the map only relocates the block pointers. Inserting or erasing
+//! in the middle moves the elements of the shorter side, and the iterators
+//! are segmented (see segmented_iterator_traits), so these moves, and
+//! ::boost::move/move_backward between a deque and a contiguous range, are
+//! done block by block, with a single memmove per block for elements with
+//! a trivial assignment. Works with movable-only
+//! (BOOST_MOVABLE_BUT_NOT_COPYABLE) types in C++03 compilers.
+//!
+//! A default constructed or moved-from deque doesn't own any memory.
+//! Insertions and erasures invalidate iterators, but insertions at
+//! either end keep references to the elements valid.
+template<class T>
+class deque
+{
+   /// @cond
+   BOOST_COPYABLE_AND_MOVABLE(deque)
+   typedef typename ::boost::aligned_storage
+      <sizeof(T), ::boost::alignment_of<T>::value>::type storage_one_t;
+   BOOST_STATIC_ASSERT(::boost::alignment_of<T>::value <= ::boost::alignment_of< ::boost::detail::max_align>::value);
+   /// @endcond
+
+   public:
+   typedef T                  value_type;
+   typedef T &                reference;
+   typedef const T &          const_reference;
+   typedef T *                pointer;
+   typedef const T *          const_pointer;
+   typedef std::size_t        size_type;
+   typedef std::ptrdiff_t     difference_type;
+   typedef ::boost::move_detail::deque_iterator<T, T&, T*>              iterator;
+   typedef ::boost::move_detail::deque_iterator<T, const T&, const T*>  const_iterator;
+
+   //! Number of elements of a block.
+   static const size_type block_size = ::boost::move_detail::deque_block_size<T>::value;
+
+   //! <b>Effects</b>: Constructs an empty deque.
+   //!
+   //! <b>Throws</b>: Nothing.
+   deque()
+      : m_map(0), m_map_size(0), m_start(), m_finish()
+   {}
+
+   //! <b>Effects</b>: Constructs a deque with n value initialized elements.
+   explicit deque(size_type n)
+      : m_map(0), m_map_size(0), m_start(), m_finish()
+   {
+      try{
+         for(; n; --n){
+            this->emplace_back();
+         }
+      }
+      catch(...){
+         this->priv_destroy_all();
+         throw;
+      }
+   }
+
+   //! <b>Effects</b>: Copy constructs the elements of x.
+   deque(const deque &x)
+      : m_map(0), m_map_size(0), m_start(), m_finish()
+   {
+      try{
+         for(const_iterator it = x.begin(), itend = x.end(); it != itend; ++it){
+            this->emplace_back(*it);
+         }
+      }
+      catch(...){
+         this->priv_destroy_all();
+         throw;
+      }
+   }
+
+   //! <b>Effects</b>: Steals the blocks of x, leaving it empty.
+   //!
+   //! <b>Throws</b>: Nothing.
+   deque(BOOST_RV_REF(deque) x)
+      : m_map(x.m_map), m_map_size(x.m_map_size), m_start(x.m_start), m_finish(x.m_finish)
+   {  x.priv_reset();  }
+
+   //! <b>Effects</b>: Destroys the elements and releases the blocks.
+   ~deque()
+   {  this->priv_destroy_all();  }
+
+   //! <b>Effects</b>: Copy assigns the elements of x, reusing the
+   //!   elements and blocks of *this.
+   deque& operator=(BOOST_COPY_ASSIGN_REF(deque) x)
+   {
+      if(&x != this){
+         const size_type n = x.size();
+         if(n <= this->size()){
+            this->erase(std::copy(x.begin(), x.end(), this->begin()), this->end());
+         }
+         else{
+            const_iterator mid = x.begin() + difference_type(this->size());
+            std::copy(x.begin(), mid, this->begin());
+            for(const_iterator xend = x.end(); mid != xend; ++mid){
+               this->emplace_back(*mid);
+            }
+         }
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Destroys the elements of *this and steals the blocks
+   //!   of x, leaving it empty.
+   //!
+   //! <b>Throws</b>: Nothing.
+   deque& operator=(BOOST_RV_REF(deque) x)
+   {
+      if(&x != this){
+         this->priv_destroy_all();
+         m_map      = x.m_map;
+         m_map_size = x.m_map_size;
+         m_start    = x.m_start;
+         m_finish   = x.m_finish;
+         x.priv_reset();
+      }
+      return *this;
+   }
+
+   iterator begin()              {  return m_start;  }
+   const_iterator begin() const  {  return m_start;  }
+   iterator end()                {  return m_finish;  }
+   const_iterator end() const    {  return m_finish;  }
+
+   size_type size() const        {  return size_type(m_finish - m_start);  }
+   bool empty() const            {  return m_finish == m_start;  }
+
+   T &operator[](size_type i)
+   {  BOOST_ASSERT(i < this->size());  return m_start[difference_type(i)];  }
+
+   const T &operator[](size_type i) const
+   {  BOOST_ASSERT(i < this->size());  return m_start[difference_type(i)];  }
+
+   //! <b>Throws</b>: std::out_of_range if i >= size().
+   T &at(size_type i)
+   {
+      if(i >= this->size()){
+         throw std::out_of_range("deque::at: index out of range");
+      }
+      return m_start[difference_type(i)];
+   }
+
+   const T &at(size_type i) const
+   {
+      if(i >= this->size()){
+         throw std::out_of_range("deque::at: index out of range");
+      }
+      return m_start[difference_type(i)];
+   }
+
+   T &front()              {  BOOST_ASSERT(!this->empty());  return *m_start.m_cur;  }
+   const T &front() const  {  BOOST_ASSERT(!this->empty());  return *m_start.m_cur;  }
+   T &back()               {  BOOST_ASSERT(!this->empty());  return *(m_finish - 1);  }
+   const T &back() const   {  BOOST_ASSERT(!this->empty());  return *(m_finish - 1);  }
+
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   //! <b>Effects</b>: Constructs a new element at the end forwarding args
+   //!   to T's constructor.
+   //!
+   //! <b>Returns</b>: A reference to the new element.
+   //!
+   //! <b>Complexity</b>: Constant. The map of blocks might be reallocated,
+   //!   which only copies block pointers.
+   template<class ...Args>
+   T &emplace_back(Args&&... args);
+
+   //! <b>Effects</b>: Constructs a new element at the beginning forwarding
+   //!   args to T's constructor.
+   //!
+   //! <b>Returns</b>: A reference to the new element.
+   template<class ...Args>
+   T &emplace_front(Args&&... args);
+
+   //! <b>Effects</b>: Constructs a new element before pos forwarding args
+   //!   to T's constructor. args may refer to elements of *this.
+   //!
+   //! <b>Returns</b>: An iterator to the new element.
+   //!
+   //! <b>Complexity</b>: Linear in the distance to the nearest end.
+   template<class ...Args>
+   iterator emplace(const_iterator pos, Args&&... args);
+   #else
+   #define BOOST_PP_LOCAL_MACRO(n)                                                     \
+   BOOST_MOVE_PP_TEMPLATE_DECL(n)                                                      \
+   T &emplace_back(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM, _))                           \
+   {                                                                                   \
+      this->priv_initialize_map();                                                     \
+      T *const p = BOOST_MOVE_PP_CONSTRUCT(n, T, m_finish.m_cur);                      \
+      this->priv_commit_back();                                                        \
+      return *p;                                                                       \
+   }                                                                                   \
+                                                                                       \
+   BOOST_MOVE_PP_TEMPLATE_DECL(n)                                                      \
+   T &emplace_front(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM, _))                          \
+   {                                                                                   \
+      T *const slot = this->priv_front_slot();                                         \
+      try{                                                                             \
+         BOOST_MOVE_PP_CONSTRUCT(n, T, slot);                                          \
+      }                                                                                \
+      catch(...){                                                                      \
+         this->priv_rollback_front();                                                  \
+         throw;                                                                        \
+      }                                                                                \
+      this->priv_commit_front(slot);                                                   \
+      return *slot;                                                                    \
+   }                                                                                   \
+                                                                                       \
+   BOOST_MOVE_PP_TEMPLATE_DECL(n)                                                      \
+   iterator emplace(const_iterator pos BOOST_PP_ENUM_TRAILING(n, BOOST_MOVE_PP_PARAM, _)) \
+   {                                                                                   \
+      if(pos == this->begin()){                                                        \
+         this->emplace_front(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_FORWARD, _));        \
+         return m_start;                                                               \
+      }                                                                                \
+      else if(pos == this->end()){                                                     \
+         this->emplace_back(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_FORWARD, _));         \
+         return m_finish - 1;                                                          \
+      }                                                                                \
+      /*Arguments might refer to elements that will be moved*/                         \
+      storage_one_t tmp_storage;                                                       \
+      T *tmp = BOOST_MOVE_PP_CONSTRUCT(n, T, &tmp_storage);                            \
+      iterator r;                                                                      \
+      try{                                                                             \
+         r = this->priv_insert_moved(pos, *tmp);                                       \
+      }                                                                                \
+      catch(...){                                                                      \
+         tmp->~T();                                                                    \
+         throw;                                                                        \
+      }                                                                                \
+      tmp->~T();                                                                       \
+      return r;                                                                        \
+   }                                                                                   \
+   //
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+   #endif
+
+   //! <b>Effects</b>: Inserts a copy of x at the end.
+   void push_back(const T &x)
+   {  this->emplace_back(x);  }
+
+   //! <b>Effects</b>: Moves x to the end.
+   void push_back(BOOST_RV_REF(T) x)
+   {  this->emplace_back(::boost::move(x));  }
+
+   //! <b>Effects</b>: Inserts a copy of x at the beginning.
+   void push_front(const T &x)
+   {  this->emplace_front(x);  }
+
+   //! <b>Effects</b>: Moves x to the beginning.
+   void push_front(BOOST_RV_REF(T) x)
+   {  this->emplace_front(::boost::move(x));  }
+
+   //! <b>Effects</b>: Inserts a copy of x before pos.
+   iterator insert(const_iterator pos, const T &x)
+   {  return this->emplace(pos, x);  }
+
+   //! <b>Effects</b>: Moves x before pos.
+   iterator insert(const_iterator pos, BOOST_RV_REF(T) x)
+   {  return this->emplace(pos, ::boost::move(x));  }
+
+   //! <b>Effects</b>: Destroys the last element.
+   //!
+   //! <b>Throws</b>: Nothing.
+   void pop_back()
+   {
+      BOOST_ASSERT(!this->empty());
+      if(m_finish.m_cur == m_finish.m_first){
+         priv_deallocate_block(m_finish.m_first);
+         m_finish.set_node(m_finish.m_node - 1);
+         m_finish.m_cur = m_finish.m_last;
+      }
+      --m_finish.m_cur;
+      m_finish.m_cur->~T();
+   }
+
+   //! <b>Effects</b>: Destroys the first element.
+   //!
+   //! <b>Throws</b>: Nothing.
+   void pop_front()
+   {
+      BOOST_ASSERT(!this->empty());
+      m_start.m_cur->~T();
+      if(++m_start.m_cur == m_start.m_last){
+         priv_deallocate_block(m_start.m_first);
+         m_start.set_node(m_start.m_node + 1);
+         m_start.m_cur = m_start.m_first;
+      }
+   }
+
+   //! <b>Effects</b>: Erases the element at pos moving the elements of the
+   //!   shorter side.
+   //!
+   //! <b>Returns</b>: An iterator to the element that followed the erased one.
+   iterator erase(const_iterator pos)
+   {
+      BOOST_ASSERT(this->begin() <= pos && pos < this->end());
+      const difference_type idx = pos - this->begin();
+      iterator p = m_start + idx;
+      if(size_type(idx) < this->size()/2){
+         ::boost::move_backward(m_start, p, p + 1);
+         this->pop_front();
+      }
+      else{
+         ::boost::move(p + 1, m_finish, p);
+         this->pop_back();
+      }
+      return m_start + idx;
+   }
+
+   //! <b>Effects</b>: Erases the elements in [first, last) moving the
+   //!   elements of the shorter side, one block at a time.
+   //!
+   //! <b>Returns</b>: An iterator to the element that followed the erased ones.
+   iterator erase(const_iterator first, const_iterator last)
+   {
+      BOOST_ASSERT(this->begin() <= first && first <= last && last <= this->end());
+      const difference_type idx = first - this->begin();
+      const difference_type n = last - first;
+      if(!n){
+         return m_start + idx;
+      }
+      if(size_type(n) == this->size()){
+         this->clear();
+         return m_finish;
+      }
+      iterator f = m_start + idx;
+      iterator l = f + n;
+      if(size_type(idx) < (this->size() - size_type(n))/2){
+         ::boost::move_backward(m_start, f, l);
+         const iterator new_start = m_start + n;
+         this->priv_destroy_range(m_start, new_start);
+         this->priv_deallocate_blocks(m_start.m_node, new_start.m_node);
+         m_start = new_start;
+      }
+      else{
+         ::boost::move(l, m_finish, f);
+         const iterator new_finish = m_finish - n;
+         this->priv_destroy_range(new_finish, m_finish);
+         this->priv_deallocate_blocks(new_finish.m_node + 1, m_finish.m_node + 1);
+         m_finish = new_finish;
+      }
+      return m_start + idx;
+   }
+
+   //! <b>Effects</b>: Value initializes or destroys elements at the end
+   //!   so that size() == n.
+   void resize(size_type n)
+   {
+      const size_type s = this->size();
+      if(n < s){
+         this->erase(m_start + difference_type(n), m_finish);
+      }
+      else{
+         for(n -= s; n; --n){
+            this->emplace_back();
+         }
+      }
+   }
+
+   //! <b>Effects</b>: Destroys all the elements and releases all the blocks
+   //!   but one. The map is kept.
+   //!
+   //! <b>Throws</b>: Nothing.
+   void clear()
+   {
+      if(m_map){
+         this->priv_destroy_range(m_start, m_finish);
+         this->priv_deallocate_blocks(m_start.m_node + 1, m_finish.m_node + 1);
+         m_start.m_cur = m_start.m_first;
+         m_finish = m_start;
+      }
+   }
+
+   //! <b>Effects</b>: Exchanges the contents of *this and x.
+   //!
+   //! <b>Throws</b>: Nothing.
+   void swap(deque &x)
+   {
+      std::swap(m_map, x.m_map);
+      std::swap(m_map_size, x.m_map_size);
+      std::swap(m_start, x.m_start);
+      std::swap(m_finish, x.m_finish);
+   }
+
+   friend void swap(deque &l, deque &r)
+   {  l.swap(r);  }
+
+   /// @cond
+   private:
+
+   static T *priv_allocate_block()
+   {  return static_cast<T*>(::operator new(block_size*sizeof(T)));  }
+
+   static void priv_deallocate_block(T *p)
+   {  ::operator delete(p);  }
+
+   //Deallocates the blocks referenced by [f, l)
+   static void priv_deallocate_blocks(T **f, T **l)
+   {
+      for(; f != l; ++f){
+         priv_deallocate_block(*f);
+      }
+   }
+
+   static void priv_destroy_range(iterator f, iterator l)
+   {
+      if(f.m_node == l.m_node){
+         ::boost::movelib::destroy(f.m_cur, l.m_cur);
+      }
+      else{
+         ::boost::movelib::destroy(f.m_cur, f.m_last);
+         for(T **n = f.m_node + 1; n != l.m_node; ++n){
+            ::boost::movelib::destroy(*n, *n + block_size);
+         }
+         ::boost::movelib::destroy(l.m_first, l.m_cur);
+      }
+   }
+
+   void priv_reset()
+   {
+      m_map = 0;
+      m_map_size = 0;
+      m_start = m_finish = iterator();
+   }
+
+   void priv_destroy_all()
+   {
+      if(m_map){
+         this->priv_destroy_range(m_start, m_finish);
+         this->priv_deallocate_blocks(m_start.m_node, m_finish.m_node + 1);
+         ::operator delete(m_map);
+         this->priv_reset();
+      }
+   }
+
+   //Allocates the map and a block in its middle if *this owns no memory
+   void priv_initialize_map()
+   {
+      if(!m_map){
+         const size_type map_size = 8u;
+         T **const map = static_cast<T**>(::operator new(map_size*sizeof(T*)));
+         T **const node = map + map_size/2;
+         try{
+            *node = priv_allocate_block();
+         }
+         catch(...){
+            ::operator delete(map);
+            throw;
+         }
+         m_map = map;
+         m_map_size = map_size;
+         m_start.set_node(node);
+         m_start.m_cur = m_start.m_first;
+         m_finish = m_start;
+      }
+   }
+
+   //Makes room in the map for nodes_to_add more block pointers at one end.
+   //Only block pointers are moved: the blocks and elements keep their address.
+   void priv_reallocate_map(size_type nodes_to_add, bool add_at_front)
+   {
+      const size_type old_num_nodes = size_type(m_finish.m_node - m_start.m_node) + 1u;
+      const size_type new_num_nodes = old_num_nodes + nodes_to_add;
+      T **new_nstart;
+      if(m_map_size > 2u*new_num_nodes){
+         //Enough free slots: recenter the used ones
+         new_nstart = m_map + (m_map_size - new_num_nodes)/2u + (add_at_front ? nodes_to_add : 0u);
+         std::memmove(new_nstart, m_start.m_node, old_num_nodes*sizeof(T*));
+      }
+      else{
+         const size_type new_map_size = m_map_size + (m_map_size > nodes_to_add ? m_map_size : nodes_to_add) + 2u;
+         T **const new_map = static_cast<T**>(::operator new(new_map_size*sizeof(T*)));
+         new_nstart = new_map + (new_map_size - new_num_nodes)/2u + (add_at_front ? nodes_to_add : 0u);
+         std::memcpy(new_nstart, m_start.m_node, old_num_nodes*sizeof(T*));
+         ::operator delete(m_map);
+         m_map = new_map;
+         m_map_size = new_map_size;
+      }
+      m_start.m_node  = new_nstart;
+      m_finish.m_node = new_nstart + (old_num_nodes - 1u);
+   }
+
+   //Called after constructing an element at m_finish.m_cur. m_finish.m_cur
+   //always points to an allocated slot, so the next block is allocated here.
+   void priv_commit_back()
+   {
+      if(m_finish.m_cur + 1 == m_finish.m_last){
+         try{
+            if(size_type(m_map_size - size_type(m_finish.m_node - m_map)) < 2u){
+               this->priv_reallocate_map(1u, false);
+            }
+            m_finish.m_node[1] = priv_allocate_block();
+         }
+         catch(...){
+            m_finish.m_cur->~T();
+            throw;
+         }
+         m_finish.set_node(m_finish.m_node + 1);
+         m_finish.m_cur = m_finish.m_first;
+      }
+      else{
+         ++m_finish.m_cur;
+      }
+   }
+
+   //Returns the slot before the first element, allocating a block if needed
+   T *priv_front_slot()
+   {
+      this->priv_initialize_map();
+      if(m_start.m_cur != m_start.m_first){
+         return m_start.m_cur - 1;
+      }
+      if(m_start.m_node == m_map){
+         this->priv_reallocate_map(1u, true);
+      }
+      m_start.m_node[-1] = priv_allocate_block();
+      return m_start.m_node[-1] + (block_size - 1u);
+   }
+
+   void priv_rollback_front()
+   {
+      if(m_start.m_cur == m_start.m_first){
+         priv_deallocate_block(m_start.m_node[-1]);
+      }
+   }
+
+   void priv_commit_front(T *slot)
+   {
+      if(m_start.m_cur == m_start.m_first){
+         m_start.set_node(m_start.m_node - 1);
+      }
+      m_start.m_cur = slot;
+   }
+
+   //Inserts x before pos, which is not an end, moving the shorter side.
+   iterator priv_insert_moved(const_iterator pos, T &x)
+   {
+      const difference_type idx = pos - this->begin();
+      if(size_type(idx) < this->size()/2){
+         this->emplace_front(::boost::move(*m_start));
+         const iterator first1 = m_start + 1;
+         const iterator p = m_start + idx;
+         ::boost::move(first1 + 1, p + 1, first1);
+         *p = ::boost::move(x);
+         return p;
+      }
+      else{
+         this->emplace_back(::boost::move(*(m_finish - 1)));
+         const iterator p = m_start + idx;
+         const iterator last1 = m_finish - 1;
+         ::boost::move_backward(p, last1 - 1, last1);
+         *p = ::boost::move(x);
+         return p;
+      }
+   }
+
+   T        **m_map;
+   size_type   m_map_size;
+   iterator    m_start;
+   iterator    m_finish;
+   /// @endcond
+};
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_DEQUE_HPP
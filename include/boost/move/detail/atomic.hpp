@@ -0,0 +1,321 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_DETAIL_ATOMIC_HPP
+#define BOOST_MOVE_DETAIL_ATOMIC_HPP
+
+#include <boost/config.hpp>
+#include <boost/static_assert.hpp>
+#include <cstddef>   //std::size_t
+
+//Minimal atomic integer used by the concurrent containers. C++0x compilers
+//use std::atomic; C++03 compilers use the platform's atomic primitives.
+#if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_HDR_ATOMIC) && !defined(BOOST_NO_0X_HDR_ATOMIC)
+   #define BOOST_MOVE_ATOMIC_STD
+   #include <atomic>
+#elif defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+   #define BOOST_MOVE_ATOMIC_GCC_ATOMIC
+#elif defined(__GNUC__)
+   #define BOOST_MOVE_ATOMIC_GCC_SYNC
+#elif defined(BOOST_MSVC)
+   #define BOOST_MOVE_ATOMIC_MSVC
+   #include <intrin.h>
+   #pragma intrinsic(_InterlockedCompareExchange, _ReadWriteBarrier)
+   #if defined(_M_X64) || defined(_M_IA64)
+   #pragma intrinsic(_InterlockedCompareExchange64)
+   #endif
+#else
+   #error "Atomic operations are not supported for this platform"
+#endif
+
+#if (defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__)))
+   #define BOOST_MOVE_CPU_RELAX() __builtin_ia32_pause()
+#elif defined(BOOST_MSVC) && (defined(_M_IX86) || defined(_M_X64))
+   #include <intrin.h>
+   #define BOOST_MOVE_CPU_RELAX() _mm_pause()
+#else
+   #define BOOST_MOVE_CPU_RELAX() ((void)0)
+#endif
+
+//! Size of the cache line used to pad data shared between threads.
+#ifndef BOOST_MOVE_CACHE_LINE_SIZE
+#define BOOST_MOVE_CACHE_LINE_SIZE 64
+#endif
+
+namespace boost {
+namespace move_detail {
+
+enum memory_order
+{  memory_order_relaxed, memory_order_acquire, memory_order_release
+,  memory_order_acq_rel, memory_order_seq_cst  };
+
+inline void cpu_relax()
+{  BOOST_MOVE_CPU_RELAX();  }
+
+#if defined(BOOST_MOVE_ATOMIC_STD)
+
+inline std::memory_order std_order(memory_order o)
+{
+   switch(o){
+      case memory_order_relaxed: return std::memory_order_relaxed;
+      case memory_order_acquire: return std::memory_order_acquire;
+      case memory_order_release: return std::memory_order_release;
+      case memory_order_acq_rel: return std::memory_order_acq_rel;
+      default:                   return std::memory_order_seq_cst;
+   }
+}
+
+//Load orders can't be release or acq_rel
+inline std::memory_order std_load_order(memory_order o)
+{  return o == memory_order_relaxed ? std::memory_order_relaxed :
+          o == memory_order_seq_cst ? std::memory_order_seq_cst : std::memory_order_acquire;  }
+
+//Store orders can't be acquire or acq_rel
+inline std::memory_order std_store_order(memory_order o)
+{  return o == memory_order_relaxed ? std::memory_order_relaxed :
+          o == memory_order_seq_cst ? std::memory_order_seq_cst : std::memory_order_release;  }
+
+template<class T>
+class atomic
+{
+   atomic(const atomic &);
+   atomic &operator=(const atomic &);
+
+   public:
+   explicit atomic(T v = T())
+      : m_v(v)
+   {}
+
+   T load(memory_order o = memory_order_seq_cst) const
+   {  return m_v.load(std_load_order(o));  }
+
+   void store(T v, memory_order o = memory_order_seq_cst)
+   {  m_v.store(v, std_store_order(o));  }
+
+   T exchange(T v, memory_order o = memory_order_seq_cst)
+   {  return m_v.exchange(v, std_order(o));  }
+
+   T fetch_add(T v, memory_order o = memory_order_seq_cst)
+   {  return m_v.fetch_add(v, std_order(o));  }
+
+   T fetch_sub(T v, memory_order o = memory_order_seq_cst)
+   {  return m_v.fetch_sub(v, std_order(o));  }
+
+   //On failure expected is updated with the current value
+   bool compare_exchange_weak(T &expected, T desired, memory_order o = memory_order_seq_cst)
+   {  return m_v.compare_exchange_weak(expected, desired, std_order(o), std_load_order(o));  }
+
+   bool compare_exchange_strong(T &expected, T desired, memory_order o = memory_order_seq_cst)
+   {  return m_v.compare_exchange_strong(expected, desired, std_order(o), std_load_order(o));  }
+
+   private:
+   std::atomic<T> m_v;
+};
+
+inline void atomic_thread_fence(memory_order o)
+{  std::atomic_thread_fence(std_order(o));  }
+
+#elif defined(BOOST_MOVE_ATOMIC_GCC_ATOMIC)
+
+inline int gcc_order(memory_order o)
+{
+   switch(o){
+      case memory_order_relaxed: return __ATOMIC_RELAXED;
+      case memory_order_acquire: return __ATOMIC_ACQUIRE;
+      case memory_order_release: return __ATOMIC_RELEASE;
+      case memory_order_acq_rel: return __ATOMIC_ACQ_REL;
+      default:                   return __ATOMIC_SEQ_CST;
+   }
+}
+
+inline int gcc_load_order(memory_order o)
+{  return o == memory_order_relaxed ? __ATOMIC_RELAXED :
+          o == memory_order_seq_cst ? __ATOMIC_SEQ_CST : __ATOMIC_ACQUIRE;  }
+
+inline int gcc_store_order(memory_order o)
+{  return o == memory_order_relaxed ? __ATOMIC_RELAXED :
+          o == memory_order_seq_cst ? __ATOMIC_SEQ_CST : __ATOMIC_RELEASE;  }
+
+template<class T>
+class atomic
+{
+   atomic(const atomic &);
+   atomic &operator=(const atomic &);
+
+   public:
+   explicit atomic(T v = T())
+      : m_v(v)
+   {}
+
+   T load(memory_order o = memory_order_seq_cst) const
+   {  return __atomic_load_n(&m_v, gcc_load_order(o));  }
+
+   void store(T v, memory_order o = memory_order_seq_cst)
+   {  __atomic_store_n(&m_v, v, gcc_store_order(o));  }
+
+   T exchange(T v, memory_order o = memory_order_seq_cst)
+   {  return __atomic_exchange_n(&m_v, v, gcc_order(o));  }
+
+   T fetch_add(T v, memory_order o = memory_order_seq_cst)
+   {  return __atomic_fetch_add(&m_v, v, gcc_order(o));  }
+
+   T fetch_sub(T v, memory_order o = memory_order_seq_cst)
+   {  return __atomic_fetch_sub(&m_v, v, gcc_order(o));  }
+
+   bool compare_exchange_weak(T &expected, T desired, memory_order o = memory_order_seq_cst)
+   {  return __atomic_compare_exchange_n(&m_v, &expected, desired, true, gcc_order(o), gcc_load_order(o));  }
+
+   bool compare_exchange_strong(T &expected, T desired, memory_order o = memory_order_seq_cst)
+   {  return __atomic_compare_exchange_n(&m_v, &expected, desired, false, gcc_order(o), gcc_load_order(o));  }
+
+   private:
+   T m_v;
+};
+
+inline void atomic_thread_fence(memory_order o)
+{  __atomic_thread_fence(gcc_order(o));  }
+
+#else //BOOST_MOVE_ATOMIC_GCC_SYNC || BOOST_MOVE_ATOMIC_MSVC
+
+#if defined(BOOST_MOVE_ATOMIC_GCC_SYNC)
+
+inline void full_fence()
+{  __sync_synchronize();  }
+
+template<class T>
+inline T atomic_cas(volatile T *p, T expected, T desired)
+{  return __sync_val_compare_and_swap(p, expected, desired);  }
+
+#else //BOOST_MOVE_ATOMIC_MSVC
+
+inline void full_fence()
+{
+   long dummy = 0;
+   _InterlockedCompareExchange(&dummy, 0, 0);
+}
+
+template<std::size_t Size>
+struct msvc_cas;
+
+template<>
+struct msvc_cas<4>
+{
+   template<class T>
+   static T cas(volatile T *p, T expected, T desired)
+   {
+      return (T)_InterlockedCompareExchange
+         (reinterpret_cast<volatile long*>(p), (long)desired, (long)expected);
+   }
+};
+
+#if defined(_M_X64) || defined(_M_IA64)
+template<>
+struct msvc_cas<8>
+{
+   template<class T>
+   static T cas(volatile T *p, T expected, T desired)
+   {
+      return (T)_InterlockedCompareExchange64
+         (reinterpret_cast<volatile __int64*>(p), (__int64)desired, (__int64)expected);
+   }
+};
+#endif
+
+template<class T>
+inline T atomic_cas(volatile T *p, T expected, T desired)
+{  return msvc_cas<sizeof(T)>::cas(p, expected, desired);  }
+
+#endif
+
+//Read-modify-write operations are full barriers. Aligned loads and stores
+//are atomic and a full fence is added to give them acquire/release semantics.
+template<class T>
+class atomic
+{
+   atomic(const atomic &);
+   atomic &operator=(const atomic &);
+
+   public:
+   explicit atomic(T v = T())
+      : m_v(v)
+   {}
+
+   T load(memory_order o = memory_order_seq_cst) const
+   {
+      const T v = m_v;
+      if(o != memory_order_relaxed){
+         full_fence();
+      }
+      return v;
+   }
+
+   void store(T v, memory_order o = memory_order_seq_cst)
+   {
+      if(o != memory_order_relaxed){
+         full_fence();
+      }
+      m_v = v;
+      if(o == memory_order_seq_cst){
+         full_fence();
+      }
+   }
+
+   T exchange(T v, memory_order = memory_order_seq_cst)
+   {
+      T cur = m_v;
+      for(T prev; (prev = atomic_cas(&m_v, cur, v)) != cur; cur = prev){}
+      return cur;
+   }
+
+   T fetch_add(T v, memory_order = memory_order_seq_cst)
+   {
+      T cur = m_v;
+      for(T prev; (prev = atomic_cas(&m_v, cur, T(cur + v))) != cur; cur = prev){}
+      return cur;
+   }
+
+   T fetch_sub(T v, memory_order = memory_order_seq_cst)
+   {
+      T cur = m_v;
+      for(T prev; (prev = atomic_cas(&m_v, cur, T(cur - v))) != cur; cur = prev){}
+      return cur;
+   }
+
+   bool compare_exchange_weak(T &expected, T desired, memory_order o = memory_order_seq_cst)
+   {  return this->compare_exchange_strong(expected, desired, o);  }
+
+   bool compare_exchange_strong(T &expected, T desired, memory_order = memory_order_seq_cst)
+   {
+      const T prev = atomic_cas(&m_v, expected, desired);
+      if(prev == expected){
+         return true;
+      }
+      expected = prev;
+      return false;
+   }
+
+   private:
+   volatile T m_v;
+};
+
+inline void atomic_thread_fence(memory_order o)
+{
+   if(o != memory_order_relaxed){
+      full_fence();
+   }
+}
+
+#endif
+
+}  //namespace move_detail {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_DETAIL_ATOMIC_HPP
@@ -0,0 +1,428 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_DETAIL_FLAT_TREE_HPP
+#define BOOST_MOVE_DETAIL_FLAT_TREE_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/relocate.hpp>
+#include <boost/move/detail/heap_sort.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/assert.hpp>
+#include <algorithm> //std::lower_bound, std::upper_bound
+#include <cstddef>   //std::size_t
+#include <utility>   //std::pair
+#include <new>       //::operator new
+
+namespace boost {
+namespace move_detail {
+
+struct flat_identity
+{
+   template<class T>
+   const T &operator()(const T &x) const
+   {  return x;  }
+};
+
+struct flat_select1st
+{
+   template<class Pair>
+   const typename Pair::first_type &operator()(const Pair &p) const
+   {  return p.first;  }
+};
+
+//Compares values through their keys
+template<class Value, class KeyOfValue, class Compare>
+struct flat_value_compare
+{
+   explicit flat_value_compare(const Compare &c)
+      : m_comp(c)
+   {}
+
+   bool operator()(const Value &a, const Value &b) const
+   {  return m_comp(KeyOfValue()(a), KeyOfValue()(b));  }
+
+   Compare m_comp;
+};
+
+//Compares a value with a key, in both orders, for the binary searches
+template<class Key, class Value, class KeyOfValue, class Compare>
+struct flat_key_compare
+{
+   explicit flat_key_compare(const Compare &c)
+      : m_comp(c)
+   {}
+
+   bool operator()(const Value &a, const Key &k) const
+   {  return m_comp(KeyOfValue()(a), k);  }
+
+   bool operator()(const Key &k, const Value &a) const
+   {  return m_comp(k, KeyOfValue()(a));  }
+
+   Compare m_comp;
+};
+
+//Sorted sequence of values with unique keys shared by flat_set and flat_map.
+//Sequence must be a random access container of Value with begin(), end(),
+//size(), clear(), reserve(), swap(), push_back(), insert(pos, x) and
+//erase(first, last).
+//
+//It's not copy assignable nor movable: the derived classes define their
+//copy and move operations with priv_copy_assign and priv_move_assign.
+template<class Key, class Value, class KeyOfValue, class Compare, class Sequence>
+class flat_tree
+{
+   flat_tree &operator=(const flat_tree &);
+
+   typedef typename Sequence::iterator seq_iterator;
+   //Sets compare values and keys with Compare
+   typedef typename if_c
+      < ::boost::is_same<Key, Value>::value
+      , Compare
+      , flat_value_compare<Value, KeyOfValue, Compare> >::type        value_compare_t;
+   typedef typename if_c
+      < ::boost::is_same<Key, Value>::value
+      , Compare
+      , flat_key_compare<Key, Value, KeyOfValue, Compare> >::type     key_compare_t;
+
+   public:
+   typedef Key                                     key_type;
+   typedef Value                                   value_type;
+   typedef Compare                                 key_compare;
+   typedef Sequence                                sequence_type;
+   typedef typename Sequence::size_type            size_type;
+   typedef typename Sequence::difference_type      difference_type;
+   typedef typename Sequence::const_iterator       const_iterator;
+   //Keys of a set can't be modified through its iterators
+   typedef typename if_c
+      < ::boost::is_same<Key, Value>::value
+      , const_iterator
+      , seq_iterator>::type                        iterator;
+
+   protected:
+   explicit flat_tree(const Compare &comp)
+      : m_comp(comp), m_seq()
+   {}
+
+   flat_tree(const flat_tree &x)
+      : m_comp(x.m_comp), m_seq(x.m_seq)
+   {}
+
+   void priv_copy_assign(const flat_tree &x)
+   {
+      if(this != &x){
+         m_comp = x.m_comp;
+         m_seq  = x.m_seq;
+      }
+   }
+
+   //Swapping the sequence also works for sequences without move semantics
+   //(std::vector in C++03 compilers)
+   void priv_move_assign(flat_tree &x)
+   {
+      if(this != &x){
+         m_comp = x.m_comp;
+         m_seq.clear();
+         m_seq.swap(x.m_seq);
+      }
+   }
+
+   public:
+   iterator begin()              {  return m_seq.begin();  }
+   const_iterator begin() const  {  return m_seq.begin();  }
+   iterator end()                {  return m_seq.end();  }
+   const_iterator end() const    {  return m_seq.end();  }
+
+   size_type size() const        {  return m_seq.size();  }
+   bool empty() const            {  return m_seq.empty();  }
+   key_compare key_comp() const  {  return m_comp;  }
+
+   //! <b>Returns</b>: The underlying sorted sequence.
+   const sequence_type &sequence() const
+   {  return m_seq;  }
+
+   //! <b>Effects</b>: Reserves memory in the underlying sequence for n elements.
+   void reserve(size_type n)
+   {  m_seq.reserve(n);  }
+
+   //! <b>Effects</b>: Erases all the elements.
+   void clear()
+   {  m_seq.clear();  }
+
+   //! <b>Effects</b>: Exchanges the contents of *this and x.
+   void swap(flat_tree &x)
+   {
+      Compare tmp(m_comp);
+      m_comp = x.m_comp;
+      x.m_comp = tmp;
+      m_seq.swap(x.m_seq);
+   }
+
+   //! <b>Returns</b>: An iterator to the first element whose key is not less than k.
+   //!
+   //! <b>Complexity</b>: Logarithmic.
+   iterator lower_bound(const key_type &k)
+   {  return std::lower_bound(m_seq.begin(), m_seq.end(), k, key_compare_t(m_comp));  }
+
+   const_iterator lower_bound(const key_type &k) const
+   {  return std::lower_bound(m_seq.begin(), m_seq.end(), k, key_compare_t(m_comp));  }
+
+   //! <b>Returns</b>: An iterator to the first element whose key is greater than k.
+   //!
+   //! <b>Complexity</b>: Logarithmic.
+   iterator upper_bound(const key_type &k)
+   {  return std::upper_bound(m_seq.begin(), m_seq.end(), k, key_compare_t(m_comp));  }
+
+   const_iterator upper_bound(const key_type &k) const
+   {  return std::upper_bound(m_seq.begin(), m_seq.end(), k, key_compare_t(m_comp));  }
+
+   //! <b>Returns</b>: An iterator to the element with key k or end().
+   //!
+   //! <b>Complexity</b>: Logarithmic.
+   iterator find(const key_type &k)
+   {
+      const seq_iterator i = this->priv_lower_bound(k);
+      return i != m_seq.end() && !m_comp(k, KeyOfValue()(*i)) ? i : m_seq.end();
+   }
+
+   const_iterator find(const key_type &k) const
+   {
+      const const_iterator i = this->lower_bound(k);
+      return i != m_seq.end() && !m_comp(k, KeyOfValue()(*i)) ? i : const_iterator(m_seq.end());
+   }
+
+   //! <b>Returns</b>: 1 if an element with key k exists, 0 otherwise.
+   size_type count(const key_type &k) const
+   {  return this->find(k) != this->end();  }
+
+   //! <b>Returns</b>: std::make_pair(lower_bound(k), upper_bound(k)).
+   std::pair<iterator, iterator> equal_range(const key_type &k)
+   {
+      const iterator i = this->find(k);
+      return std::pair<iterator, iterator>(i, i == this->end() ? i : i + 1);
+   }
+
+   std::pair<const_iterator, const_iterator> equal_range(const key_type &k) const
+   {
+      const const_iterator i = this->find(k);
+      return std::pair<const_iterator, const_iterator>(i, i == this->end() ? i : i + 1);
+   }
+
+   //! <b>Effects</b>: Inserts a copy of x if no element has an equivalent key.
+   //!
+   //! <b>Returns</b>: An iterator to the element with the key of x and
+   //!   true if the insertion took place.
+   //!
+   //! <b>Complexity</b>: Logarithmic search plus linear insertion.
+   std::pair<iterator, bool> insert(const value_type &x)
+   {
+      const seq_iterator i = this->priv_lower_bound(KeyOfValue()(x));
+      if(this->priv_is_key(i, KeyOfValue()(x))){
+         return std::pair<iterator, bool>(i, false);
+      }
+      return std::pair<iterator, bool>(m_seq.insert(i, x), true);
+   }
+
+   //! <b>Effects</b>: Moves x into the container if no element has an
+   //!   equivalent key.
+   //!
+   //! <b>Returns</b>: An iterator to the element with the key of x and
+   //!   true if the insertion took place.
+   //!
+   //! <b>Complexity</b>: Logarithmic search plus linear insertion.
+   std::pair<iterator, bool> insert(BOOST_RV_REF(value_type) x)
+   {
+      const value_type &v = x;
+      const seq_iterator i = this->priv_lower_bound(KeyOfValue()(v));
+      if(this->priv_is_key(i, KeyOfValue()(v))){
+         return std::pair<iterator, bool>(i, false);
+      }
+      return std::pair<iterator, bool>(m_seq.insert(i, ::boost::move(x)), true);
+   }
+
+   //! <b>Effects</b>: Inserts the elements of [first, last) whose keys are not
+   //!   already in the container. Use move iterators to move the elements.
+   //!   If several new elements have equivalent keys, one of them is inserted.
+   //!
+   //!   All the elements are appended to the sequence (so with move
+   //!   iterators every element of the range is moved from), sorted with a
+   //!   heap sort that only moves them, and the ones whose keys are already
+   //!   present are destroyed. Then, unless they all go after the current
+   //!   elements, they are moved to a temporary buffer and merged backwards:
+   //!   the elements of the container greater than the greatest new element
+   //!   are moved to the end with boost::move_backward, the new element is
+   //!   moved before them and so on, so each previous element is moved at
+   //!   most once.
+   //!
+   //! <b>Complexity</b>: O(N + K log(K) + K log(N)) where N is size() and K
+   //!   is distance(first, last), instead of O(N*K) for K insert() calls.
+   //!
+   //! <b>Throws</b>: If a comparison or move operation throws while merging
+   //!   the container is cleared. Otherwise, if an exception is thrown, the
+   //!   container is not modified.
+   template<class InputIt>
+   void insert_batch(InputIt first, InputIt last)
+   {
+      const size_type n = m_seq.size();
+      try{
+         for(; first != last; ++first){
+            m_seq.push_back(*first);
+         }
+         const seq_iterator b = m_seq.begin(), mid = b + n, e = m_seq.end();
+         ::boost::move_detail::heap_sort(mid, e, value_compare_t(m_comp));
+         //Compact the new elements, removing repeated keys
+         seq_iterator out = mid, lo = b;
+         for(seq_iterator it = mid; it != e; ++it){
+            const key_type &k = KeyOfValue()(*it);
+            if(out != mid && !m_comp(KeyOfValue()(out[-1]), k)){
+               continue;
+            }
+            //Keys are increasing so the search continues from the last position
+            lo = std::lower_bound(lo, mid, k, key_compare_t(m_comp));
+            if(lo != mid && !m_comp(k, KeyOfValue()(*lo))){
+               continue;
+            }
+            if(out != it){
+               *out = ::boost::move(*it);
+            }
+            ++out;
+         }
+         m_seq.erase(out, m_seq.end());
+      }
+      catch(...){
+         m_seq.erase(m_seq.begin() + n, m_seq.end());
+         throw;
+      }
+      const size_type added = static_cast<size_type>(m_seq.size() - n);
+      if(added && n && m_comp(KeyOfValue()(*(m_seq.begin() + n)), KeyOfValue()(*(m_seq.begin() + (n - 1))))){
+         this->priv_merge_tail(n, added);
+      }
+   }
+
+   //! <b>Requires</b>: seq is sorted by key_comp() with no equivalent keys.
+   //!
+   //! <b>Effects</b>: The container takes the elements and the memory of seq,
+   //!   destroying its previous elements. Neither elements are moved nor
+   //!   memory allocated.
+   void adopt_sequence(BOOST_RV_REF(sequence_type) seq)
+   {  this->priv_adopt(seq);  }
+
+   #if defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   //C++03 sequences without move emulation (like std::vector) are
+   //passed as lvalues by boost::move
+   template<class S>
+   typename enable_if_c
+      < ::boost::is_same<S, sequence_type>::value && !::boost::has_move_emulation_enabled<S>::value>::type
+      adopt_sequence(S &seq)
+   {  this->priv_adopt(seq);  }
+   #endif
+
+   //! <b>Effects</b>: Moves the underlying sequence out of the container,
+   //!   leaving it empty.
+   sequence_type extract_sequence()
+   {
+      sequence_type seq;
+      seq.swap(m_seq);
+      return ::boost::move(seq);
+   }
+
+   //! <b>Effects</b>: Erases the element pointed by pos.
+   //!
+   //! <b>Returns</b>: An iterator to the element that followed the erased one.
+   iterator erase(const_iterator pos)
+   {
+      const seq_iterator i = m_seq.begin() + (pos - const_iterator(m_seq.begin()));
+      return m_seq.erase(i, i + 1);
+   }
+
+   //! <b>Effects</b>: Erases the element with key k, if any.
+   //!
+   //! <b>Returns</b>: The number of erased elements.
+   size_type erase(const key_type &k)
+   {
+      const seq_iterator i = this->priv_lower_bound(k);
+      if(!this->priv_is_key(i, k)){
+         return 0u;
+      }
+      m_seq.erase(i, i + 1);
+      return 1u;
+   }
+
+   protected:
+   seq_iterator priv_lower_bound(const key_type &k)
+   {  return std::lower_bound(m_seq.begin(), m_seq.end(), k, key_compare_t(m_comp));  }
+
+   bool priv_is_key(const_iterator i, const key_type &k) const
+   {  return i != m_seq.end() && !m_comp(k, KeyOfValue()(*i));  }
+
+   seq_iterator priv_insert_at(seq_iterator pos, BOOST_RV_REF(value_type) x)
+   {  return m_seq.insert(pos, ::boost::move(x));  }
+
+   private:
+
+   void priv_adopt(sequence_type &seq)
+   {
+      BOOST_ASSERT(this->priv_is_sorted_unique(seq));
+      m_seq.clear();
+      m_seq.swap(seq);
+   }
+
+   bool priv_is_sorted_unique(const sequence_type &seq) const
+   {
+      const_iterator i = seq.begin(), e = seq.end();
+      if(i != e){
+         for(const_iterator prev = i++; i != e; prev = i++){
+            if(!m_comp(KeyOfValue()(*prev), KeyOfValue()(*i))){
+               return false;
+            }
+         }
+      }
+      return true;
+   }
+
+   //Merges the k sorted elements after the first n ones
+   void priv_merge_tail(size_type n, size_type k)
+   {
+      value_type *const buf = static_cast<value_type*>(::operator new(k*sizeof(value_type)));
+      value_type *bl = buf;
+      try{
+         const seq_iterator b = m_seq.begin(), mid = b + n;
+         bl = ::boost::uninitialized_move(mid, mid + k, buf);
+         seq_iterator a = mid, dst = mid + k;
+         while(bl != buf){
+            //Elements greater than the greatest pending new element
+            seq_iterator run = a;
+            while(run != b && m_comp(KeyOfValue()(bl[-1]), KeyOfValue()(run[-1]))){
+               --run;
+            }
+            dst = ::boost::move_backward(run, a, dst);
+            a = run;
+            *--dst = ::boost::move(bl[-1]);
+            (--bl)->~value_type();
+         }
+      }
+      catch(...){
+         ::boost::movelib::destroy(buf, bl);
+         ::operator delete(buf);
+         m_seq.clear();
+         throw;
+      }
+      ::operator delete(buf);
+   }
+
+   Compare        m_comp;
+   sequence_type  m_seq;
+};
+
+}  //namespace move_detail {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_DETAIL_FLAT_TREE_HPP
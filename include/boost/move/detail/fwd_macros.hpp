@@ -0,0 +1,51 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_DETAIL_FWD_MACROS_HPP
+#define BOOST_MOVE_DETAIL_FWD_MACROS_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/preprocessor/iteration/local.hpp>
+#include <boost/preprocessor/repetition/enum.hpp>
+#include <boost/preprocessor/repetition/enum_params.hpp>
+#include <boost/preprocessor/repetition/enum_trailing.hpp>
+#include <boost/preprocessor/repetition/enum_trailing_params.hpp>
+#include <boost/preprocessor/control/expr_if.hpp>
+
+//Emplacement functions are generated with BOOST_PP_LOCAL_ITERATE for
+//0 to BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS arguments. Arguments are caught
+//with BOOST_FWD_REF and passed to the constructor with ::boost::forward, so
+//rvalues marked with ::boost::move are moved both in C++03 and C++0x compilers.
+#ifndef BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS
+#define BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS 6
+#endif
+
+//"class P0, class P1, ..." preceded by "template<" and followed by ">" if n > 0
+#define BOOST_MOVE_PP_TEMPLATE_DECL(n)\
+   BOOST_PP_EXPR_IF(n, template<) BOOST_PP_ENUM_PARAMS(n, class P) BOOST_PP_EXPR_IF(n, >)
+//
+
+//"BOOST_FWD_REF(P0) p0, BOOST_FWD_REF(P1) p1, ..."
+#define BOOST_MOVE_PP_PARAM(z, n, data)\
+   BOOST_FWD_REF(P##n) p##n
+//
+
+//"::boost::forward<P0>(p0), ::boost::forward<P1>(p1), ..."
+#define BOOST_MOVE_PP_PARAM_FORWARD(z, n, data)\
+   ::boost::forward<P##n>(p##n)
+//
+
+//Placement new of TYPE at address PTR forwarding n arguments
+#define BOOST_MOVE_PP_CONSTRUCT(n, TYPE, PTR)\
+   ::new(static_cast<void*>(PTR)) TYPE(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_FORWARD, _))
+//
+
+#endif //#ifndef BOOST_MOVE_DETAIL_FWD_MACROS_HPP
@@ -0,0 +1,56 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_DETAIL_HASH_MIX_HPP
+#define BOOST_MOVE_DETAIL_HASH_MIX_HPP
+
+#include <cstddef>   //std::size_t
+
+namespace boost {
+namespace move_detail {
+
+//Spreads the bits of a hash value. Power of two tables select the slot
+//with the low bits, and the identity hash of integers is common, so every
+//bit of the hash must reach the low bits of the result.
+template<class SizeT, std::size_t Bytes = sizeof(SizeT)>
+struct hash_mixer
+{
+   static SizeT mix(SizeT h)
+   {
+      h ^= h >> 16;
+      h *= 0x45d9f3bu;
+      h ^= h >> 16;
+      return h;
+   }
+};
+
+//64 bit values use the finalizer of MurmurHash3 (fmix64)
+template<class SizeT>
+struct hash_mixer<SizeT, 8>
+{
+   static SizeT mix(SizeT h)
+   {
+      h ^= h >> 33;
+      h *= (SizeT(0xff51afd7u) << 32) | SizeT(0xed558ccdu);
+      h ^= h >> 33;
+      h *= (SizeT(0xc4ceb9feu) << 32) | SizeT(0x1a85ec53u);
+      h ^= h >> 33;
+      return h;
+   }
+};
+
+inline std::size_t hash_mix(std::size_t h)
+{  return hash_mixer<std::size_t>::mix(h);  }
+
+}  //namespace move_detail {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_DETAIL_HASH_MIX_HPP
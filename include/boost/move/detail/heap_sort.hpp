@@ -0,0 +1,102 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_DETAIL_HEAP_SORT_HPP
+#define BOOST_MOVE_DETAIL_HEAP_SORT_HPP
+
+#include <boost/move/move.hpp>
+#include <iterator>  //std::iterator_traits
+
+namespace boost {
+namespace move_detail {
+
+//Heap operations that only move elements, so they work with movable-only
+//types in C++03 compilers (std::make_heap and friends copy them).
+//The heap is a max-heap with respect to comp, as in the standard library.
+
+//Moves the hole at first[pos] down until both children are not greater
+//than v and moves v into it
+template<class RandIt, class Compare>
+void heap_sift_hole
+   ( RandIt first
+   , typename std::iterator_traits<RandIt>::difference_type pos
+   , typename std::iterator_traits<RandIt>::difference_type len
+   , typename std::iterator_traits<RandIt>::value_type &v
+   , Compare comp)
+{
+   typedef typename std::iterator_traits<RandIt>::difference_type difference_type;
+   difference_type child;
+   while((child = 2*pos + 1) < len){
+      if(child + 1 < len && comp(first[child], first[child + 1])){
+         ++child;
+      }
+      if(!comp(v, first[child])){
+         break;
+      }
+      first[pos] = ::boost::move(first[child]);
+      pos = child;
+   }
+   first[pos] = ::boost::move(v);
+}
+
+//Moves first[pos] down until both children are not greater than it,
+//leaving a hole at each level instead of swapping
+template<class RandIt, class Compare>
+void heap_sift_down
+   ( RandIt first
+   , typename std::iterator_traits<RandIt>::difference_type pos
+   , typename std::iterator_traits<RandIt>::difference_type len
+   , Compare comp)
+{
+   typedef typename std::iterator_traits<RandIt>::value_type value_type;
+   value_type v(::boost::move(first[pos]));
+   ::boost::move_detail::heap_sift_hole(first, pos, len, v, comp);
+}
+
+template<class RandIt, class Compare>
+void heap_make(RandIt first, RandIt last, Compare comp)
+{
+   typedef typename std::iterator_traits<RandIt>::difference_type difference_type;
+   const difference_type len = last - first;
+   for(difference_type i = len/2; i--; ){
+      ::boost::move_detail::heap_sift_down(first, i, len, comp);
+   }
+}
+
+//Moves the greatest element of the heap [first, last) to last - 1
+//and restores the heap property of [first, last - 1)
+template<class RandIt, class Compare>
+void heap_pop(RandIt first, RandIt last, Compare comp)
+{
+   typedef typename std::iterator_traits<RandIt>::value_type value_type;
+   --last;
+   if(first != last){
+      value_type v(::boost::move(*last));
+      *last  = ::boost::move(*first);
+      *first = ::boost::move(v);
+      ::boost::move_detail::heap_sift_down(first, 0, last - first, comp);
+   }
+}
+
+//Not stable, O(N log N) comparisons and moves and no extra memory
+template<class RandIt, class Compare>
+void heap_sort(RandIt first, RandIt last, Compare comp)
+{
+   ::boost::move_detail::heap_make(first, last, comp);
+   for(; last - first > 1; --last){
+      ::boost::move_detail::heap_pop(first, last, comp);
+   }
+}
+
+}  //namespace move_detail {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_DETAIL_HEAP_SORT_HPP
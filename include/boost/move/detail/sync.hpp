@@ -0,0 +1,281 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_DETAIL_SYNC_HPP
+#define BOOST_MOVE_DETAIL_SYNC_HPP
+
+#include <boost/config.hpp>
+
+//Minimal thread, mutex and condition variable used by the blocking parts of the
+//concurrent utilities. C++0x compilers use the standard library; C++03
+//compilers use POSIX threads or Windows (Vista or newer) primitives.
+#if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_HDR_MUTEX) && \
+    !defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE) && !defined(BOOST_NO_CXX11_HDR_THREAD)
+   #define BOOST_MOVE_SYNC_STD
+   #include <mutex>
+   #include <condition_variable>
+   #include <thread>
+#elif defined(BOOST_HAS_PTHREADS)
+   #define BOOST_MOVE_SYNC_PTHREADS
+   #include <pthread.h>
+   #include <sched.h>
+   #include <stdexcept> //std::runtime_error
+#elif defined(BOOST_WINDOWS)
+   #define BOOST_MOVE_SYNC_WINDOWS
+   #include <windows.h>
+   #include <process.h>
+   #include <stdexcept> //std::runtime_error
+#else
+   #error "Threads are not supported for this platform"
+#endif
+
+//Storage class for thread-local variables of POD type
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL) && !defined(BOOST_NO_RVALUE_REFERENCES)
+   #define BOOST_MOVE_THREAD_LOCAL thread_local
+#elif defined(BOOST_MSVC)
+   #define BOOST_MOVE_THREAD_LOCAL __declspec(thread)
+#else
+   #define BOOST_MOVE_THREAD_LOCAL __thread
+#endif
+
+namespace boost {
+namespace move_detail {
+
+#if defined(BOOST_MOVE_SYNC_STD)
+
+class mutex
+{
+   mutex(const mutex &);
+   mutex &operator=(const mutex &);
+
+   public:
+   mutex() : m_mtx() {}
+   void lock()    {  m_mtx.lock();  }
+   void unlock()  {  m_mtx.unlock();  }
+
+   std::mutex &native()  {  return m_mtx;  }
+
+   private:
+   std::mutex m_mtx;
+};
+
+class condition_variable
+{
+   condition_variable(const condition_variable &);
+   condition_variable &operator=(const condition_variable &);
+
+   public:
+   condition_variable() : m_cv() {}
+
+   //Requires: m is locked by the calling thread
+   void wait(mutex &m)
+   {
+      std::unique_lock<std::mutex> lock(m.native(), std::adopt_lock);
+      m_cv.wait(lock);
+      lock.release();
+   }
+
+   void notify_one()  {  m_cv.notify_one();  }
+   void notify_all()  {  m_cv.notify_all();  }
+
+   private:
+   std::condition_variable m_cv;
+};
+
+inline void thread_yield()
+{  std::this_thread::yield();  }
+
+//Runs fn(arg) in a new thread. The thread must be joined before destruction.
+class thread
+{
+   thread(const thread &);
+   thread &operator=(const thread &);
+
+   public:
+   thread(void (*fn)(void*), void *arg)
+      : m_th(fn, arg)
+   {}
+
+   void join()  {  m_th.join();  }
+
+   private:
+   std::thread m_th;
+};
+
+#elif defined(BOOST_MOVE_SYNC_PTHREADS)
+
+class mutex
+{
+   mutex(const mutex &);
+   mutex &operator=(const mutex &);
+
+   public:
+   mutex()        {  pthread_mutex_init(&m_mtx, 0);  }
+   ~mutex()       {  pthread_mutex_destroy(&m_mtx);  }
+   void lock()    {  pthread_mutex_lock(&m_mtx);  }
+   void unlock()  {  pthread_mutex_unlock(&m_mtx);  }
+
+   pthread_mutex_t &native()  {  return m_mtx;  }
+
+   private:
+   pthread_mutex_t m_mtx;
+};
+
+class condition_variable
+{
+   condition_variable(const condition_variable &);
+   condition_variable &operator=(const condition_variable &);
+
+   public:
+   condition_variable()    {  pthread_cond_init(&m_cv, 0);  }
+   ~condition_variable()   {  pthread_cond_destroy(&m_cv);  }
+
+   void wait(mutex &m)  {  pthread_cond_wait(&m_cv, &m.native());  }
+   void notify_one()    {  pthread_cond_signal(&m_cv);  }
+   void notify_all()    {  pthread_cond_broadcast(&m_cv);  }
+
+   private:
+   pthread_cond_t m_cv;
+};
+
+inline void thread_yield()
+{  sched_yield();  }
+
+struct thread_start
+{
+   void (*fn)(void*);
+   void  *arg;
+};
+
+extern "C" inline void *pthread_thread_proxy(void *p)
+{
+   thread_start *const s = static_cast<thread_start*>(p);
+   s->fn(s->arg);
+   return 0;
+}
+
+class thread
+{
+   thread(const thread &);
+   thread &operator=(const thread &);
+
+   public:
+   thread(void (*fn)(void*), void *arg)
+   {
+      m_start.fn  = fn;
+      m_start.arg = arg;
+      if(pthread_create(&m_th, 0, &pthread_thread_proxy, &m_start)){
+         throw std::runtime_error("pthread_create failed");
+      }
+   }
+
+   void join()  {  pthread_join(m_th, 0);  }
+
+   private:
+   thread_start   m_start;
+   pthread_t      m_th;
+};
+
+#else //BOOST_MOVE_SYNC_WINDOWS
+
+class mutex
+{
+   mutex(const mutex &);
+   mutex &operator=(const mutex &);
+
+   public:
+   mutex()        {  InitializeCriticalSection(&m_cs);  }
+   ~mutex()       {  DeleteCriticalSection(&m_cs);  }
+   void lock()    {  EnterCriticalSection(&m_cs);  }
+   void unlock()  {  LeaveCriticalSection(&m_cs);  }
+
+   CRITICAL_SECTION &native()  {  return m_cs;  }
+
+   private:
+   CRITICAL_SECTION m_cs;
+};
+
+class condition_variable
+{
+   condition_variable(const condition_variable &);
+   condition_variable &operator=(const condition_variable &);
+
+   public:
+   condition_variable()    {  InitializeConditionVariable(&m_cv);  }
+
+   void wait(mutex &m)  {  SleepConditionVariableCS(&m_cv, &m.native(), INFINITE);  }
+   void notify_one()    {  WakeConditionVariable(&m_cv);  }
+   void notify_all()    {  WakeAllConditionVariable(&m_cv);  }
+
+   private:
+   CONDITION_VARIABLE m_cv;
+};
+
+inline void thread_yield()
+{  SwitchToThread();  }
+
+class thread
+{
+   thread(const thread &);
+   thread &operator=(const thread &);
+
+   static unsigned __stdcall proxy(void *p)
+   {
+      thread *const t = static_cast<thread*>(p);
+      t->m_fn(t->m_arg);
+      return 0;
+   }
+
+   public:
+   thread(void (*fn)(void*), void *arg)
+      : m_fn(fn), m_arg(arg)
+   {
+      m_th = reinterpret_cast<HANDLE>(_beginthreadex(0, 0, &thread::proxy, this, 0, 0));
+      if(!m_th){
+         throw std::runtime_error("_beginthreadex failed");
+      }
+   }
+
+   void join()
+   {
+      WaitForSingleObject(m_th, INFINITE);
+      CloseHandle(m_th);
+   }
+
+   private:
+   void (*m_fn)(void*);
+   void  *m_arg;
+   HANDLE m_th;
+};
+
+#endif
+
+class scoped_lock
+{
+   scoped_lock(const scoped_lock &);
+   scoped_lock &operator=(const scoped_lock &);
+
+   public:
+   explicit scoped_lock(mutex &m)
+      : m_mtx(m)
+   {  m_mtx.lock();  }
+
+   ~scoped_lock()
+   {  m_mtx.unlock();  }
+
+   private:
+   mutex &m_mtx;
+};
+
+}  //namespace move_detail {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_DETAIL_SYNC_HPP
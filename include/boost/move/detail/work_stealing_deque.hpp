@@ -0,0 +1,158 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_MOVE_DETAIL_WORK_STEALING_DEQUE_HPP
+#define BOOST_MOVE_DETAIL_WORK_STEALING_DEQUE_HPP
+
+#include <boost/move/detail/atomic.hpp>
+#include <cstddef>   //std::ptrdiff_t
+
+namespace boost {
+namespace move_detail {
+
+//Chase-Lev work-stealing deque of T pointers ("Dynamic Circular Work-Stealing
+//Deque", with the memory orderings of Le, Pop, Cohen and Zappa Nardelli).
+//The owner thread pushes and takes at the bottom (LIFO) and other threads
+//steal from the top (FIFO). The circular array grows when full; replaced
+//arrays are kept until destruction because a thief might still read them.
+//
+//A null pointer is returned when the deque is empty or when a steal
+//loses the race for the top element.
+template<class T>
+class work_stealing_deque
+{
+   work_stealing_deque(const work_stealing_deque &);
+   work_stealing_deque &operator=(const work_stealing_deque &);
+
+   typedef ::boost::move_detail::atomic<T*> atomic_slot;
+
+   struct array_t
+   {
+      std::ptrdiff_t  mask;
+      array_t        *previous;
+      atomic_slot    *slots;
+
+      explicit array_t(std::ptrdiff_t capacity, array_t *prev)
+         : mask(capacity - 1), previous(prev), slots(new atomic_slot[capacity])
+      {}
+
+      ~array_t()
+      {  delete [] slots;  }
+
+      T *get(std::ptrdiff_t i) const
+      {  return slots[i & mask].load(::boost::move_detail::memory_order_relaxed);  }
+
+      void put(std::ptrdiff_t i, T *x)
+      {  slots[i & mask].store(x, ::boost::move_detail::memory_order_relaxed);  }
+   };
+
+   public:
+   //capacity must be a power of two
+   explicit work_stealing_deque(std::ptrdiff_t capacity = 64)
+      : m_top(0), m_bottom(0), m_array(new array_t(capacity, 0))
+   {}
+
+   ~work_stealing_deque()
+   {
+      array_t *a = m_array.load(::boost::move_detail::memory_order_relaxed);
+      while(a){
+         array_t *const prev = a->previous;
+         delete a;
+         a = prev;
+      }
+   }
+
+   //Owner thread only
+   void push(T *x)
+   {
+      const std::ptrdiff_t b = m_bottom.load(::boost::move_detail::memory_order_relaxed);
+      const std::ptrdiff_t t = m_top.load(::boost::move_detail::memory_order_acquire);
+      array_t *a = m_array.load(::boost::move_detail::memory_order_relaxed);
+      if(b - t > a->mask){
+         a = this->priv_grow(a, t, b);
+      }
+      a->put(b, x);
+      m_bottom.store(b + 1, ::boost::move_detail::memory_order_release);
+   }
+
+   //Owner thread only
+   T *take()
+   {
+      const std::ptrdiff_t b = m_bottom.load(::boost::move_detail::memory_order_relaxed) - 1;
+      array_t *const a = m_array.load(::boost::move_detail::memory_order_relaxed);
+      //The store of bottom must be ordered before the load of top (and
+      //the thieves' load of top before their load of bottom)
+      m_bottom.store(b, ::boost::move_detail::memory_order_seq_cst);
+      std::ptrdiff_t t = m_top.load(::boost::move_detail::memory_order_seq_cst);
+      T *x = 0;
+      if(t <= b){
+         x = a->get(b);
+         if(t == b){
+            //Last element: race against thieves
+            if(!m_top.compare_exchange_strong(t, t + 1, ::boost::move_detail::memory_order_seq_cst)){
+               x = 0;
+            }
+            m_bottom.store(b + 1, ::boost::move_detail::memory_order_relaxed);
+         }
+      }
+      else{
+         m_bottom.store(b + 1, ::boost::move_detail::memory_order_relaxed);
+      }
+      return x;
+   }
+
+   //Any thread
+   T *steal()
+   {
+      std::ptrdiff_t t = m_top.load(::boost::move_detail::memory_order_seq_cst);
+      const std::ptrdiff_t b = m_bottom.load(::boost::move_detail::memory_order_seq_cst);
+      if(t < b){
+         array_t *const a = m_array.load(::boost::move_detail::memory_order_acquire);
+         T *const x = a->get(t);
+         if(m_top.compare_exchange_strong(t, t + 1, ::boost::move_detail::memory_order_seq_cst)){
+            return x;
+         }
+      }
+      return 0;
+   }
+
+   //Any thread, approximate
+   bool empty() const
+   {
+      return m_bottom.load(::boost::move_detail::memory_order_relaxed) <=
+             m_top.load(::boost::move_detail::memory_order_relaxed);
+   }
+
+   private:
+   array_t *priv_grow(array_t *a, std::ptrdiff_t t, std::ptrdiff_t b)
+   {
+      array_t *const n = new array_t((a->mask + 1)*2, a);
+      for(std::ptrdiff_t i = t; i != b; ++i){
+         n->put(i, a->get(i));
+      }
+      m_array.store(n, ::boost::move_detail::memory_order_release);
+      return n;
+   }
+
+   //Written by thieves and the owner
+   ::boost::move_detail::atomic<std::ptrdiff_t> m_top;
+   char pad0_[BOOST_MOVE_CACHE_LINE_SIZE - sizeof(::boost::move_detail::atomic<std::ptrdiff_t>)];
+   //Written by the owner
+   ::boost::move_detail::atomic<std::ptrdiff_t> m_bottom;
+   ::boost::move_detail::atomic<array_t*>       m_array;
+   char pad1_[BOOST_MOVE_CACHE_LINE_SIZE - sizeof(::boost::move_detail::atomic<std::ptrdiff_t>)
+             - sizeof(::boost::move_detail::atomic<array_t*>)];
+};
+
+}  //namespace move_detail {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_DETAIL_WORK_STEALING_DEQUE_HPP
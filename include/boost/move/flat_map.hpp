@@ -0,0 +1,138 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_FLAT_MAP_HPP
+#define BOOST_MOVE_FLAT_MAP_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/pair.hpp>
+#include <boost/move/tuple.hpp>
+#include <boost/move/detail/flat_tree.hpp>
+#include <functional>   //std::less
+#include <stdexcept>    //std::out_of_range
+#include <vector>
+
+namespace boost {
+namespace movelib {
+
+//! A map with unique keys whose movelib::pair&lt;Key, T&gt; elements are
+//! stored sorted by key in a random access Sequence, so lookups are binary
+//! searches on contiguous memory. Inserting a single element shifts the
+//! following ones; insert_batch inserts K elements in O(N + K log K) and
+//! adopt_sequence takes an already sorted buffer without moving a single
+//! element.
+//!
+//! Use a small_vector as Sequence to store movable-only mapped values in
+//! C++03 compilers, as std::vector requires copyable elements there.
+//!
+//! Iterators are invalidated by insertions and erasures. The key of an
+//! element must not be modified through an iterator.
+template< class Key, class T, class Compare = std::less<Key>
+        , class Sequence = std::vector< ::boost::movelib::pair<Key, T> > >
+class flat_map
+   : public ::boost::move_detail::flat_tree
+      <Key, ::boost::movelib::pair<Key, T>, ::boost::move_detail::flat_select1st, Compare, Sequence>
+{
+   /// @cond
+   BOOST_COPYABLE_AND_MOVABLE(flat_map)
+   typedef ::boost::move_detail::flat_tree
+      <Key, ::boost::movelib::pair<Key, T>, ::boost::move_detail::flat_select1st, Compare, Sequence> base_t;
+   /// @endcond
+
+   public:
+   typedef T                              mapped_type;
+   typedef typename base_t::key_type      key_type;
+   typedef typename base_t::value_type    value_type;
+   typedef typename base_t::iterator      iterator;
+
+   //! <b>Effects</b>: Constructs an empty map.
+   explicit flat_map(const Compare &comp = Compare())
+      : base_t(comp)
+   {}
+
+   //! <b>Effects</b>: Constructs a map with the elements of [first, last),
+   //!   inserted with insert_batch.
+   template<class InputIt>
+   flat_map(InputIt first, InputIt last, const Compare &comp = Compare())
+      : base_t(comp)
+   {  this->insert_batch(first, last);  }
+
+   //! <b>Effects</b>: Copy constructs the elements of x.
+   flat_map(const flat_map &x)
+      : base_t(x)
+   {}
+
+   //! <b>Effects</b>: Takes the sequence of x, leaving it empty.
+   //!
+   //! <b>Throws</b>: Nothing unless the comparison object throws.
+   flat_map(BOOST_RV_REF(flat_map) x)
+      : base_t(x.key_comp())
+   {  this->priv_move_assign(x);  }
+
+   //! <b>Effects</b>: Copy assigns the elements of x.
+   flat_map &operator=(BOOST_COPY_ASSIGN_REF(flat_map) x)
+   {
+      this->priv_copy_assign(x);
+      return *this;
+   }
+
+   //! <b>Effects</b>: Destroys the elements of *this and takes the sequence
+   //!   of x, leaving it empty.
+   flat_map &operator=(BOOST_RV_REF(flat_map) x)
+   {
+      this->priv_move_assign(x);
+      return *this;
+   }
+
+   //! <b>Effects</b>: If there is no element with key k, inserts one
+   //!   with a value initialized mapped value.
+   //!
+   //! <b>Returns</b>: A reference to the mapped value of key k.
+   T &operator[](const key_type &k)
+   {
+      iterator i = this->priv_lower_bound(k);
+      if(!this->priv_is_key(i, k)){
+         value_type v( ::boost::movelib::piecewise_construct
+                     , ::boost::movelib::forward_as_tuple(k)
+                     , ::boost::movelib::forward_as_tuple());
+         i = this->priv_insert_at(i, ::boost::move(v));
+      }
+      return i->second;
+   }
+
+   //! <b>Returns</b>: A reference to the mapped value of key k.
+   //!
+   //! <b>Throws</b>: std::out_of_range if there is no element with key k.
+   T &at(const key_type &k)
+   {
+      const iterator i = this->find(k);
+      if(i == this->end()){
+         throw std::out_of_range("flat_map::at: key not found");
+      }
+      return i->second;
+   }
+
+   const T &at(const key_type &k) const
+   {
+      const typename base_t::const_iterator i = this->find(k);
+      if(i == this->end()){
+         throw std::out_of_range("flat_map::at: key not found");
+      }
+      return i->second;
+   }
+};
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_FLAT_MAP_HPP
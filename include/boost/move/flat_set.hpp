@@ -0,0 +1,90 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_FLAT_SET_HPP
+#define BOOST_MOVE_FLAT_SET_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/detail/flat_tree.hpp>
+#include <functional>   //std::less
+#include <vector>
+
+namespace boost {
+namespace movelib {
+
+//! A set of unique keys stored sorted in a random access Sequence, so
+//! lookups are binary searches on contiguous memory. Inserting a single
+//! element shifts the following ones; insert_batch inserts K elements in
+//! O(N + K log K) and adopt_sequence takes an already sorted buffer without
+//! moving a single element.
+//!
+//! Use a small_vector as Sequence to store movable-only keys in C++03
+//! compilers, as std::vector requires copyable elements there.
+//!
+//! Iterators are invalidated by insertions and erasures.
+template<class Key, class Compare = std::less<Key>, class Sequence = std::vector<Key> >
+class flat_set
+   : public ::boost::move_detail::flat_tree
+      <Key, Key, ::boost::move_detail::flat_identity, Compare, Sequence>
+{
+   /// @cond
+   BOOST_COPYABLE_AND_MOVABLE(flat_set)
+   typedef ::boost::move_detail::flat_tree
+      <Key, Key, ::boost::move_detail::flat_identity, Compare, Sequence> base_t;
+   /// @endcond
+
+   public:
+   //! <b>Effects</b>: Constructs an empty set.
+   explicit flat_set(const Compare &comp = Compare())
+      : base_t(comp)
+   {}
+
+   //! <b>Effects</b>: Constructs a set with the elements of [first, last),
+   //!   inserted with insert_batch.
+   template<class InputIt>
+   flat_set(InputIt first, InputIt last, const Compare &comp = Compare())
+      : base_t(comp)
+   {  this->insert_batch(first, last);  }
+
+   //! <b>Effects</b>: Copy constructs the elements of x.
+   flat_set(const flat_set &x)
+      : base_t(x)
+   {}
+
+   //! <b>Effects</b>: Takes the sequence of x, leaving it empty.
+   //!
+   //! <b>Throws</b>: Nothing unless the comparison object throws.
+   flat_set(BOOST_RV_REF(flat_set) x)
+      : base_t(x.key_comp())
+   {  this->priv_move_assign(x);  }
+
+   //! <b>Effects</b>: Copy assigns the elements of x.
+   flat_set &operator=(BOOST_COPY_ASSIGN_REF(flat_set) x)
+   {
+      this->priv_copy_assign(x);
+      return *this;
+   }
+
+   //! <b>Effects</b>: Destroys the elements of *this and takes the sequence
+   //!   of x, leaving it empty.
+   flat_set &operator=(BOOST_RV_REF(flat_set) x)
+   {
+      this->priv_move_assign(x);
+      return *this;
+   }
+};
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_FLAT_SET_HPP
@@ -0,0 +1,712 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_FUTURE_HPP
+#define BOOST_MOVE_FUTURE_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/optional.hpp>
+#include <boost/move/detail/atomic.hpp>
+#include <boost/move/detail/sync.hpp>
+#include <boost/type_traits/is_void.hpp>
+#include <boost/type_traits/decay.hpp>
+#include <boost/utility/result_of.hpp>
+#include <boost/assert.hpp>
+#include <stdexcept> //std::logic_error
+#include <algorithm> //std::swap
+
+#if defined(BOOST_NO_RVALUE_REFERENCES) || defined(BOOST_NO_CXX11_HDR_EXCEPTION)
+#include <boost/exception_ptr.hpp>
+#else
+#include <exception>
+#endif
+
+namespace boost {
+namespace movelib {
+
+#if defined(BOOST_NO_RVALUE_REFERENCES) || defined(BOOST_NO_CXX11_HDR_EXCEPTION)
+typedef ::boost::exception_ptr exception_ptr;
+using ::boost::current_exception;
+using ::boost::rethrow_exception;
+
+template<class E>
+inline exception_ptr make_exception_ptr(const E &e)
+{  return ::boost::copy_exception(e);  }
+#else
+//! Type used to store the exception that will be rethrown by future::get().
+//! It's std::exception_ptr in C++0x compilers and boost::exception_ptr otherwise.
+//! Note that boost::current_exception() only preserves the dynamic type of
+//! standard exceptions and exceptions thrown with boost::enable_current_exception.
+typedef std::exception_ptr exception_ptr;
+using std::current_exception;
+using std::rethrow_exception;
+using std::make_exception_ptr;
+#endif
+
+//! Exception thrown by future::get() when the promise was destroyed
+//! without storing a value or an exception.
+class broken_promise : public std::logic_error
+{
+   public:
+   broken_promise()
+      : std::logic_error("broken promise")
+   {}
+};
+
+template<class R>
+class future;
+
+template<class R>
+class promise;
+
+}  //namespace movelib {
+
+/// @cond
+
+namespace move_detail {
+
+struct future_void {};
+
+template<class R>
+class future_state;
+
+//Continuation attached with future::then(). It's run once, by the thread
+//that makes the source state ready, and owns a reference to that state.
+template<class R>
+class future_continuation
+{
+   public:
+   virtual void run_continuation(future_state<R> &src) = 0;
+
+   protected:
+   ~future_continuation()
+   {}
+};
+
+//Shared state of a promise/future pair. It's reference counted and
+//allocated once; derived classes (for example, tasks of a thread pool)
+//can store additional data in the same allocation.
+template<class R>
+class future_state
+{
+   future_state(const future_state &);
+   future_state &operator=(const future_state &);
+
+   public:
+   typedef typename ::boost::move_detail::if_c
+      < ::boost::is_void<R>::value, future_void, R>::type  value_type;
+
+   explicit future_state(int refs)
+      : m_refs(refs), m_mtx(), m_cv(), m_ready(false), m_value(), m_exception(), m_continuation(0)
+   {}
+
+   virtual ~future_state()
+   {}
+
+   void add_ref()
+   {  m_refs.fetch_add(1, ::boost::move_detail::memory_order_relaxed);  }
+
+   void release()
+   {
+      if(m_refs.fetch_sub(1, ::boost::move_detail::memory_order_acq_rel) == 1){
+         delete this;
+      }
+   }
+
+   template<class U>
+   void set_value(BOOST_FWD_REF(U) u)
+   {
+      future_continuation<R> *c;
+      {
+         ::boost::move_detail::scoped_lock lock(m_mtx);
+         BOOST_ASSERT(!m_ready);
+         m_value.emplace(::boost::forward<U>(u));
+         c = this->priv_make_ready();
+      }
+      this->priv_run_continuation(c);
+   }
+
+   void set_exception(const ::boost::movelib::exception_ptr &e)
+   {
+      future_continuation<R> *c;
+      {
+         ::boost::move_detail::scoped_lock lock(m_mtx);
+         BOOST_ASSERT(!m_ready);
+         m_exception = e;
+         c = this->priv_make_ready();
+      }
+      this->priv_run_continuation(c);
+   }
+
+   //Takes the exception from e, so that the calling thread doesn't keep
+   //a reference to it once the state is ready
+   void take_exception(::boost::movelib::exception_ptr &e)
+   {
+      future_continuation<R> *c;
+      {
+         ::boost::move_detail::scoped_lock lock(m_mtx);
+         BOOST_ASSERT(!m_ready);
+         std::swap(m_exception, e);
+         c = this->priv_make_ready();
+      }
+      this->priv_run_continuation(c);
+   }
+
+   //Stores broken_promise if no value was stored
+   void abandon()
+   {
+      future_continuation<R> *c = 0;
+      {
+         ::boost::move_detail::scoped_lock lock(m_mtx);
+         if(m_ready){
+            return;
+         }
+         m_exception = ::boost::movelib::make_exception_ptr(::boost::movelib::broken_promise());
+         c = this->priv_make_ready();
+      }
+      this->priv_run_continuation(c);
+   }
+
+   //Runs c when the state becomes ready, immediately if it's already ready.
+   //The reference owned by the caller is transferred to c.
+   void set_continuation(future_continuation<R> *c)
+   {
+      {
+         ::boost::move_detail::scoped_lock lock(m_mtx);
+         BOOST_ASSERT(!m_continuation);
+         if(!m_ready){
+            m_continuation = c;
+            return;
+         }
+      }
+      c->run_continuation(*this);
+   }
+
+   bool is_ready()
+   {
+      ::boost::move_detail::scoped_lock lock(m_mtx);
+      return m_ready;
+   }
+
+   void wait()
+   {
+      ::boost::move_detail::scoped_lock lock(m_mtx);
+      while(!m_ready){
+         m_cv.wait(m_mtx);
+      }
+   }
+
+   //Waits and returns the stored value by move or rethrows the stored exception.
+   //Can only be called once.
+   value_type get()
+   {
+      this->wait();
+      if(m_exception){
+         //The exception is moved out so that it's destroyed by the thread
+         //that called get(), even if another thread releases the state
+         const ::boost::movelib::exception_ptr e(m_exception);
+         m_exception = ::boost::movelib::exception_ptr();
+         ::boost::movelib::rethrow_exception(e);
+      }
+      value_type v(::boost::move(*m_value));
+      return ::boost::move(v);
+   }
+
+   private:
+   future_continuation<R> *priv_make_ready()
+   {
+      m_ready = true;
+      m_cv.notify_all();
+      return m_continuation;
+   }
+
+   //Called without holding the mutex: the continuation might attach
+   //further continuations or destroy this state
+   void priv_run_continuation(future_continuation<R> *c)
+   {
+      if(c){
+         c->run_continuation(*this);
+      }
+   }
+
+   ::boost::move_detail::atomic<int>            m_refs;
+   ::boost::move_detail::mutex                  m_mtx;
+   ::boost::move_detail::condition_variable     m_cv;
+   bool                                         m_ready;
+   ::boost::movelib::optional<value_type>       m_value;
+   ::boost::movelib::exception_ptr              m_exception;
+   future_continuation<R>                      *m_continuation;
+};
+
+//Computes the result of continuation F for a source future<R>
+template<class R, class F>
+struct continuation_result
+{
+   typedef typename ::boost::decay<F>::type                    callable_type;
+   typedef typename ::boost::result_of<callable_type(R)>::type type;
+};
+
+template<class F>
+struct continuation_result<void, F>
+{
+   typedef typename ::boost::decay<F>::type                    callable_type;
+   typedef typename ::boost::result_of<callable_type()>::type  type;
+};
+
+//Calls f with the value of src (moved) and stores the result in dst
+template<class R, class R2>
+struct continuation_invoker
+{
+   template<class F>
+   static void invoke(F &f, future_state<R> &src, future_state<R2> &dst)
+   {
+      R v(src.get());
+      R2 r(f(::boost::move(v)));
+      dst.set_value(::boost::move(r));
+   }
+};
+
+template<class R>
+struct continuation_invoker<R, void>
+{
+   template<class F>
+   static void invoke(F &f, future_state<R> &src, future_state<void> &dst)
+   {
+      R v(src.get());
+      f(::boost::move(v));
+      dst.set_value(future_void());
+   }
+};
+
+template<class R2>
+struct continuation_invoker<void, R2>
+{
+   template<class F>
+   static void invoke(F &f, future_state<void> &src, future_state<R2> &dst)
+   {
+      src.get();
+      R2 r(f());
+      dst.set_value(::boost::move(r));
+   }
+};
+
+template<>
+struct continuation_invoker<void, void>
+{
+   template<class F>
+   static void invoke(F &f, future_state<void> &src, future_state<void> &dst)
+   {
+      src.get();
+      f();
+      dst.set_value(future_void());
+   }
+};
+
+//The continuation callable and the state of the future returned by then()
+//share a single allocation. The state starts with two references: the
+//returned future's and the one released after the continuation runs.
+template<class R, class F, class R2>
+class continuation_state
+   : public future_state<R2>, public future_continuation<R>
+{
+   public:
+   template<class G>
+   explicit continuation_state(BOOST_FWD_REF(G) g)
+      : future_state<R2>(2), future_continuation<R>(), m_f(::boost::forward<G>(g))
+   {}
+
+   virtual void run_continuation(future_state<R> &src)
+   {
+      ::boost::movelib::exception_ptr e;
+      try{
+         continuation_invoker<R, R2>::invoke(m_f, src, *this);
+      }
+      catch(...){
+         e = ::boost::movelib::current_exception();
+      }
+      src.release();
+      if(e){
+         this->take_exception(e);
+      }
+      this->release();
+   }
+
+   private:
+   F m_f;
+};
+
+}  //namespace move_detail {
+
+/// @endcond
+
+namespace movelib {
+
+/// @cond
+
+namespace future_detail {
+
+template<class R>
+class future_base
+{
+   future_base(const future_base &);
+   future_base &operator=(const future_base &);
+
+   protected:
+   typedef ::boost::move_detail::future_state<R> state_t;
+
+   future_base()
+      : m_state(0)
+   {}
+
+   explicit future_base(state_t *st)
+      : m_state(st)
+   {}
+
+   ~future_base()
+   {
+      if(m_state){
+         m_state->release();
+      }
+   }
+
+   void priv_steal(future_base &x)
+   {
+      m_state = x.m_state;
+      x.m_state = 0;
+   }
+
+   void priv_move_assign(future_base &x)
+   {
+      if(this != &x){
+         if(m_state){
+            m_state->release();
+         }
+         this->priv_steal(x);
+      }
+   }
+
+   template<class Fn, class G>
+   future<typename ::boost::move_detail::continuation_result<R, Fn>::type>
+      priv_then(BOOST_FWD_REF(G) g)
+   {
+      BOOST_ASSERT(m_state);
+      typedef typename ::boost::move_detail::continuation_result<R, Fn>::type   result_t;
+      typedef ::boost::move_detail::continuation_state<R, Fn, result_t>         cont_t;
+      cont_t *const c = new cont_t(::boost::forward<G>(g));
+      future<result_t> ret(c);
+      state_t *const st = m_state;
+      m_state = 0;
+      st->set_continuation(c);
+      return ::boost::move(ret);
+   }
+
+   //Releases the state after extracting the result
+   typename state_t::value_type priv_get()
+   {
+      BOOST_ASSERT(m_state);
+      state_t *const st = m_state;
+      m_state = 0;
+      try{
+         typename state_t::value_type v(st->get());
+         st->release();
+         return ::boost::move(v);
+      }
+      catch(...){
+         st->release();
+         throw;
+      }
+   }
+
+   public:
+   //! <b>Returns</b>: true if *this refers to a shared state.
+   bool valid() const
+   {  return m_state != 0;  }
+
+   //! <b>Requires</b>: valid().
+   //!
+   //! <b>Returns</b>: true if the result is available.
+   bool is_ready() const
+   {  BOOST_ASSERT(m_state);  return m_state->is_ready();  }
+
+   //! <b>Requires</b>: valid().
+   //!
+   //! <b>Effects</b>: Blocks until the result is available.
+   void wait() const
+   {  BOOST_ASSERT(m_state);  m_state->wait();  }
+
+   #if defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   template<class F>
+   future<typename ::boost::move_detail::continuation_result<R, F>::type>
+      then(const F &f)
+   {
+      return this->template priv_then
+         <typename ::boost::move_detail::continuation_result<R, F>::callable_type>(f);
+   }
+
+   template<class F>
+   future<typename ::boost::move_detail::continuation_result<R, F>::type>
+      then(BOOST_RV_REF(F) f)
+   {  return this->template priv_then<F>(f);  }
+   #else
+   //! <b>Requires</b>: valid().
+   //!
+   //! <b>Effects</b>: Moves (or copies, if f is an lvalue) f into a new shared
+   //!   state and attaches it as a continuation: when the result of *this is
+   //!   available, f is called with the value moved out of the shared state
+   //!   (or without arguments for future<void>). The continuation is run by the
+   //!   thread that makes the result available, or by the calling thread if
+   //!   it's already available. If *this holds an exception, f is not called
+   //!   and the exception is propagated. valid() is false after the call.
+   //!
+   //! <b>Returns</b>: A future that will hold the result of f or the exception
+   //!   propagated or thrown by f.
+   //!
+   //! <b>Throws</b>: std::bad_alloc or any exception thrown by the
+   //!   constructor of the callable. In that case *this is not modified.
+   template<class F>
+   future<typename ::boost::move_detail::continuation_result<R, F>::type>
+      then(F &&f)
+   {
+      return this->template priv_then
+         <typename ::boost::move_detail::continuation_result<R, F>::callable_type>(::boost::forward<F>(f));
+   }
+   #endif
+
+   protected:
+   state_t *m_state;
+};
+
+template<class R>
+class promise_base
+{
+   promise_base(const promise_base &);
+   promise_base &operator=(const promise_base &);
+
+   protected:
+   typedef ::boost::move_detail::future_state<R> state_t;
+
+   explicit promise_base(state_t *st)
+      : m_state(st), m_future_retrieved(false)
+   {}
+
+   ~promise_base()
+   {  this->priv_abandon();  }
+
+   void priv_steal(promise_base &x)
+   {
+      m_state = x.m_state;
+      m_future_retrieved = x.m_future_retrieved;
+      x.m_state = 0;
+   }
+
+   void priv_move_assign(promise_base &x)
+   {
+      if(this != &x){
+         this->priv_abandon();
+         this->priv_steal(x);
+      }
+   }
+
+   void priv_abandon()
+   {
+      if(m_state){
+         m_state->abandon();
+         m_state->release();
+         m_state = 0;
+      }
+   }
+
+   state_t *priv_retrieve_state()
+   {
+      BOOST_ASSERT(m_state && !m_future_retrieved);
+      m_future_retrieved = true;
+      m_state->add_ref();
+      return m_state;
+   }
+
+   public:
+   //! <b>Effects</b>: Stores e in the shared state and makes it ready.
+   void set_exception(const exception_ptr &e)
+   {  BOOST_ASSERT(m_state);  m_state->set_exception(e);  }
+
+   protected:
+   state_t *m_state;
+   bool     m_future_retrieved;
+};
+
+}  //namespace future_detail {
+
+/// @endcond
+
+//! A single-shot, movable-only handle to a result that will be produced
+//! by a promise or a task. Unlike boost::shared_future, get() moves the
+//! result out of the shared state, so movable-only types are supported.
+template<class R>
+class future
+   : public future_detail::future_base<R>
+{
+   /// @cond
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(future)
+   typedef future_detail::future_base<R> base_t;
+   /// @endcond
+
+   public:
+   //! <b>Effects</b>: Constructs a future without shared state.
+   future()
+      : base_t()
+   {}
+
+   /// @cond
+   explicit future(typename base_t::state_t *st)
+      : base_t(st)
+   {}
+   /// @endcond
+
+   //! <b>Effects</b>: Takes the shared state of x.
+   future(BOOST_RV_REF(future) x)
+      : base_t()
+   {  this->priv_steal(x);  }
+
+   //! <b>Effects</b>: Releases the state of *this and takes the shared state of x.
+   future& operator=(BOOST_RV_REF(future) x)
+   {
+      this->priv_move_assign(x);
+      return *this;
+   }
+
+   //! <b>Requires</b>: valid().
+   //!
+   //! <b>Effects</b>: Waits until the result is available and releases the
+   //!   shared state. valid() is false after the call.
+   //!
+   //! <b>Returns</b>: The stored value, move constructed.
+   //!
+   //! <b>Throws</b>: The stored exception, if any.
+   R get()
+   {  return this->priv_get();  }
+};
+
+template<>
+class future<void>
+   : public future_detail::future_base<void>
+{
+   /// @cond
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(future)
+   typedef future_detail::future_base<void> base_t;
+   /// @endcond
+
+   public:
+   future()
+      : base_t()
+   {}
+
+   /// @cond
+   explicit future(base_t::state_t *st)
+      : base_t(st)
+   {}
+   /// @endcond
+
+   future(BOOST_RV_REF(future) x)
+      : base_t()
+   {  this->priv_steal(x);  }
+
+   future& operator=(BOOST_RV_REF(future) x)
+   {
+      this->priv_move_assign(x);
+      return *this;
+   }
+
+   void get()
+   {  this->priv_get();  }
+};
+
+//! The producer side of a promise/future pair. The shared state is
+//! allocated once, when the promise is constructed. If the promise is
+//! destroyed without storing a result, the future receives broken_promise.
+template<class R>
+class promise
+   : public future_detail::promise_base<R>
+{
+   /// @cond
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(promise)
+   typedef future_detail::promise_base<R> base_t;
+   /// @endcond
+
+   public:
+   //! <b>Effects</b>: Allocates the shared state.
+   promise()
+      : base_t(new typename base_t::state_t(1))
+   {}
+
+   //! <b>Effects</b>: Takes the shared state of x.
+   promise(BOOST_RV_REF(promise) x)
+      : base_t(0)
+   {  this->priv_steal(x);  }
+
+   //! <b>Effects</b>: Abandons the state of *this and takes the shared state of x.
+   promise& operator=(BOOST_RV_REF(promise) x)
+   {
+      this->priv_move_assign(x);
+      return *this;
+   }
+
+   //! <b>Requires</b>: Can only be called once.
+   //!
+   //! <b>Returns</b>: A future that shares the state with *this.
+   future<R> get_future()
+   {  return future<R>(this->priv_retrieve_state());  }
+
+   //! <b>Effects</b>: Stores a copy of r and makes the state ready.
+   void set_value(const R &r)
+   {  BOOST_ASSERT(this->m_state);  this->m_state->set_value(r);  }
+
+   //! <b>Effects</b>: Moves r to the shared state and makes it ready.
+   void set_value(BOOST_RV_REF(R) r)
+   {  BOOST_ASSERT(this->m_state);  this->m_state->set_value(::boost::move(r));  }
+};
+
+template<>
+class promise<void>
+   : public future_detail::promise_base<void>
+{
+   /// @cond
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(promise)
+   typedef future_detail::promise_base<void> base_t;
+   /// @endcond
+
+   public:
+   promise()
+      : base_t(new base_t::state_t(1))
+   {}
+
+   promise(BOOST_RV_REF(promise) x)
+      : base_t(0)
+   {  this->priv_steal(x);  }
+
+   promise& operator=(BOOST_RV_REF(promise) x)
+   {
+      this->priv_move_assign(x);
+      return *this;
+   }
+
+   future<void> get_future()
+   {  return future<void>(this->priv_retrieve_state());  }
+
+   void set_value()
+   {  BOOST_ASSERT(this->m_state);  this->m_state->set_value(::boost::move_detail::future_void());  }
+};
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_FUTURE_HPP
@@ -0,0 +1,721 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_HASH_MAP_HPP
+#define BOOST_MOVE_HASH_MAP_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/relocate.hpp>
+#include <boost/move/pair.hpp>
+#include <boost/move/tuple.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
+#include <boost/move/detail/hash_mix.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>      //std::size_t
+#include <cstring>      //std::memcpy, std::memset
+#include <functional>   //std::equal_to
+#include <iterator>     //std::forward_iterator_tag
+#include <stdexcept>    //std::out_of_range
+#include <utility>      //std::pair
+#include <new>          //placement new
+
+namespace boost {
+
+/// @cond
+
+namespace move_detail {
+
+//Iterates the occupied slots of a hash_map. Each slot has a probe
+//distance, 0 meaning that the slot is empty.
+template<class Value, class Ref, class Ptr>
+class hash_map_iterator
+{
+   public:
+   typedef std::forward_iterator_tag   iterator_category;
+   typedef Value                       value_type;
+   typedef std::ptrdiff_t              difference_type;
+   typedef Ptr                         pointer;
+   typedef Ref                         reference;
+
+   hash_map_iterator()
+      : m_dist(0), m_end(0), m_value(0)
+   {}
+
+   hash_map_iterator(const unsigned *dist, const unsigned *end, Value *value)
+      : m_dist(dist), m_end(end), m_value(value)
+   {  this->skip_empty();  }
+
+   //Conversion from iterator to const_iterator
+   hash_map_iterator(const hash_map_iterator<Value, Value&, Value*> &x)
+      : m_dist(x.dist()), m_end(x.end()), m_value(x.value())
+   {}
+
+   reference operator*() const   {  return *m_value;  }
+   pointer operator->() const    {  return m_value;  }
+
+   hash_map_iterator &operator++()
+   {
+      ++m_dist;
+      ++m_value;
+      this->skip_empty();
+      return *this;
+   }
+
+   hash_map_iterator operator++(int)
+   {
+      hash_map_iterator tmp(*this);
+      ++*this;
+      return tmp;
+   }
+
+   friend bool operator==(const hash_map_iterator &a, const hash_map_iterator &b)
+   {  return a.m_dist == b.m_dist;  }
+
+   friend bool operator!=(const hash_map_iterator &a, const hash_map_iterator &b)
+   {  return a.m_dist != b.m_dist;  }
+
+   const unsigned *dist() const  {  return m_dist;  }
+   const unsigned *end() const   {  return m_end;  }
+   Value *value() const          {  return m_value;  }
+
+   private:
+   void skip_empty()
+   {
+      while(m_dist != m_end && !*m_dist){
+         ++m_dist;
+         ++m_value;
+      }
+   }
+
+   const unsigned *m_dist;
+   const unsigned *m_end;
+   Value          *m_value;
+};
+
+}  //namespace move_detail {
+
+/// @endcond
+
+namespace movelib {
+
+//! An unordered map with unique keys that stores its movelib::pair&lt;Key, T&gt;
+//! elements directly in an array (open addressing), without a node
+//! allocation per element. Collisions are resolved with Robin Hood linear
+//! probing: an element displaces the elements that are closer to their
+//! ideal slot, so probe sequences are short even with a load factor of
+//! 7/8, and erasure shifts the following elements back instead of leaving
+//! tombstones.
+//!
+//! When the table grows, elements are relocated to the new array: with
+//! std::memcpy if <i>is_trivially_relocatable&lt;value_type&gt;</i> is
+//! true, otherwise move constructing each one and destroying the source
+//! in the same step (skipping the destructor when
+//! <i>has_trivial_destructor_after_move</i> is true). Use reserve() to
+//! avoid rehashing in latency sensitive paths.
+//!
+//! Works with movable-only (BOOST_MOVABLE_BUT_NOT_COPYABLE) keys and values
+//! in C++03 compilers. The move constructor of value_type and the hash
+//! function must not throw.
+//!
+//! Insertions and erasures invalidate iterators and references, as
+//! elements are moved inside the array. The key of an element must not be
+//! modified through an iterator.
+template< class Key, class T
+        , class Hash = ::boost::hash<Key>
+        , class Pred = std::equal_to<Key> >
+class hash_map
+{
+   /// @cond
+   BOOST_COPYABLE_AND_MOVABLE(hash_map)
+   /// @endcond
+
+   public:
+   typedef Key                                     key_type;
+   typedef T                                       mapped_type;
+   typedef ::boost::movelib::pair<Key, T>          value_type;
+   typedef Hash                                    hasher;
+   typedef Pred                                    key_equal;
+   typedef std::size_t                             size_type;
+   typedef std::ptrdiff_t                          difference_type;
+   typedef value_type &                            reference;
+   typedef const value_type &                      const_reference;
+   typedef ::boost::move_detail::hash_map_iterator
+      <value_type, value_type&, value_type*>                   iterator;
+   typedef ::boost::move_detail::hash_map_iterator
+      <value_type, const value_type&, const value_type*>       const_iterator;
+
+   /// @cond
+   private:
+   BOOST_STATIC_ASSERT(::boost::alignment_of<value_type>::value <= ::boost::alignment_of< ::boost::detail::max_align>::value);
+   typedef typename ::boost::aligned_storage
+      <sizeof(value_type), ::boost::alignment_of<value_type>::value>::type storage_t;
+   static const size_type min_capacity = 8u;
+   /// @endcond
+
+   public:
+   //! <b>Effects</b>: Constructs an empty map. No memory is allocated.
+   explicit hash_map(const Hash &h = Hash(), const Pred &eq = Pred())
+      : m_hash(h), m_eq(eq), m_dist(0), m_values(0), m_mask(0), m_size(0)
+   {}
+
+   //! <b>Effects</b>: Constructs an empty map that can hold n elements
+   //!   without rehashing.
+   explicit hash_map(size_type n, const Hash &h = Hash(), const Pred &eq = Pred())
+      : m_hash(h), m_eq(eq), m_dist(0), m_values(0), m_mask(0), m_size(0)
+   {  this->reserve(n);  }
+
+   //! <b>Effects</b>: Copy constructs the elements of x into the same slots,
+   //!   without hashing any key.
+   hash_map(const hash_map &x)
+      : m_hash(x.m_hash), m_eq(x.m_eq), m_dist(0), m_values(0), m_mask(0), m_size(0)
+   {
+      if(x.m_size){
+         this->priv_allocate(x.capacity());
+         try{
+            for(size_type i = 0; i != x.capacity(); ++i){
+               if(x.m_dist[i]){
+                  ::new(static_cast<void*>(m_values + i)) value_type(x.m_values[i]);
+                  m_dist[i] = x.m_dist[i];
+               }
+            }
+         }
+         catch(...){
+            this->priv_destroy_all();
+            this->priv_deallocate();
+            throw;
+         }
+         m_size = x.m_size;
+      }
+   }
+
+   //! <b>Effects</b>: Takes the table of x, leaving it empty.
+   //!
+   //! <b>Throws</b>: Nothing.
+   hash_map(BOOST_RV_REF(hash_map) x)
+      : m_hash(x.m_hash), m_eq(x.m_eq), m_dist(x.m_dist), m_values(x.m_values)
+      , m_mask(x.m_mask), m_size(x.m_size)
+   {
+      x.m_dist   = 0;
+      x.m_values = 0;
+      x.m_mask   = 0;
+      x.m_size   = 0;
+   }
+
+   //! <b>Effects</b>: Destroys the elements and releases the table.
+   ~hash_map()
+   {
+      this->priv_destroy_all();
+      this->priv_deallocate();
+   }
+
+   //! <b>Effects</b>: Copy assigns x. If an exception is thrown *this is not modified.
+   hash_map &operator=(BOOST_COPY_ASSIGN_REF(hash_map) x)
+   {
+      if(this != &x){
+         hash_map tmp(static_cast<const hash_map&>(x));
+         this->swap(tmp);
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Destroys the elements of *this and takes the table of x,
+   //!   leaving it empty.
+   hash_map &operator=(BOOST_RV_REF(hash_map) x)
+   {
+      if(this != &x){
+         hash_map tmp(::boost::move(x));
+         this->swap(tmp);
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Exchanges the contents of *this and x.
+   void swap(hash_map &x)
+   {
+      ::boost::move_detail::move_swap(m_hash, x.m_hash);
+      ::boost::move_detail::move_swap(m_eq, x.m_eq);
+      unsigned *const d = m_dist;      m_dist = x.m_dist;      x.m_dist = d;
+      value_type *const v = m_values;  m_values = x.m_values;  x.m_values = v;
+      const size_type m = m_mask;      m_mask = x.m_mask;      x.m_mask = m;
+      const size_type s = m_size;      m_size = x.m_size;      x.m_size = s;
+   }
+
+   iterator begin()
+   {  return iterator(m_dist, m_dist + this->capacity(), m_values);  }
+
+   const_iterator begin() const
+   {  return const_iterator(m_dist, m_dist + this->capacity(), m_values);  }
+
+   iterator end()
+   {  return iterator(m_dist + this->capacity(), m_dist + this->capacity(), m_values + this->capacity());  }
+
+   const_iterator end() const
+   {  return const_iterator(m_dist + this->capacity(), m_dist + this->capacity(), m_values + this->capacity());  }
+
+   size_type size() const     {  return m_size;  }
+   bool empty() const         {  return !m_size;  }
+
+   //! <b>Returns</b>: The number of slots of the table, a power of two.
+   size_type capacity() const {  return m_dist ? m_mask + 1u : 0u;  }
+
+   //! <b>Returns</b>: size()/capacity(), or 0 if no table is allocated.
+   float load_factor() const
+   {  return m_dist ? float(m_size)/float(this->capacity()) : 0.f;  }
+
+   hasher hash_function() const  {  return m_hash;  }
+   key_equal key_eq() const      {  return m_eq;  }
+
+   //! <b>Effects</b>: Grows the table, if needed, so that n elements can be
+   //!   inserted without rehashing.
+   void reserve(size_type n)
+   {
+      size_type cap = this->capacity() ? this->capacity() : size_type(min_capacity);
+      while(priv_max_load(cap) < n){
+         cap *= 2u;
+      }
+      if(cap != this->capacity()){
+         this->priv_rehash(cap);
+      }
+   }
+
+   //! <b>Effects</b>: Destroys all the elements. The table is kept.
+   void clear()
+   {
+      this->priv_destroy_all();
+      m_size = 0;
+   }
+
+   //! <b>Returns</b>: An iterator to the element with key k or end().
+   iterator find(const key_type &k)
+   {
+      size_type idx;
+      unsigned d;
+      return this->priv_find(k, idx, d) ? this->priv_iterator(idx) : this->end();
+   }
+
+   const_iterator find(const key_type &k) const
+   {
+      size_type idx;
+      unsigned d;
+      return this->priv_find(k, idx, d) ? const_iterator(this->const_cast_this()->priv_iterator(idx)) : this->end();
+   }
+
+   //! <b>Returns</b>: 1 if an element with key k exists, 0 otherwise.
+   size_type count(const key_type &k) const
+   {
+      size_type idx;
+      unsigned d;
+      return this->priv_find(k, idx, d);
+   }
+
+   //! <b>Returns</b>: A reference to the mapped value of key k.
+   //!
+   //! <b>Throws</b>: std::out_of_range if there is no element with key k.
+   T &at(const key_type &k)
+   {
+      const iterator i = this->find(k);
+      if(i == this->end()){
+         throw std::out_of_range("hash_map::at: key not found");
+      }
+      return i->second;
+   }
+
+   const T &at(const key_type &k) const
+   {
+      const const_iterator i = this->find(k);
+      if(i == this->end()){
+         throw std::out_of_range("hash_map::at: key not found");
+      }
+      return i->second;
+   }
+
+   //! <b>Effects</b>: If there is no element with key k, inserts one
+   //!   with a copy of k and a value initialized mapped value.
+   //!
+   //! <b>Returns</b>: A reference to the mapped value of key k.
+   T &operator[](const key_type &k)
+   {  return this->try_emplace(k).first->second;  }
+
+   //! <b>Effects</b>: If there is no element with key k, inserts one
+   //!   moving k and with a value initialized mapped value.
+   //!
+   //! <b>Returns</b>: A reference to the mapped value of key k.
+   T &operator[](BOOST_RV_REF(key_type) k)
+   {  return this->try_emplace(::boost::move(k)).first->second;  }
+
+   //! <b>Effects</b>: Inserts a copy of x if no element has an equivalent key.
+   //!
+   //! <b>Returns</b>: An iterator to the element with the key of x and
+   //!   true if the insertion took place.
+   std::pair<iterator, bool> insert(const value_type &x)
+   {
+      size_type idx;
+      if(this->priv_find_or_prepare(x.first, idx)){
+         return std::pair<iterator, bool>(this->priv_iterator(idx), false);
+      }
+      try{
+         ::new(static_cast<void*>(m_values + idx)) value_type(x);
+      }
+      catch(...){
+         this->priv_cancel_insert(idx);
+         throw;
+      }
+      ++m_size;
+      return std::pair<iterator, bool>(this->priv_iterator(idx), true);
+   }
+
+   //! <b>Effects</b>: Moves x into the map if no element has an equivalent key.
+   //!
+   //! <b>Returns</b>: An iterator to the element with the key of x and
+   //!   true if the insertion took place.
+   std::pair<iterator, bool> insert(BOOST_RV_REF(value_type) x)
+   {
+      const value_type &v = x;
+      size_type idx;
+      if(this->priv_find_or_prepare(v.first, idx)){
+         return std::pair<iterator, bool>(this->priv_iterator(idx), false);
+      }
+      ::new(static_cast<void*>(m_values + idx)) value_type(::boost::move(x));
+      ++m_size;
+      return std::pair<iterator, bool>(this->priv_iterator(idx), true);
+   }
+
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   //! <b>Effects</b>: Constructs a value_type forwarding args with
+   //!   boost::forward and moves it into the map if no element has an
+   //!   equivalent key. Otherwise the constructed value is destroyed.
+   //!   args must not refer to elements of the map.
+   //!
+   //! <b>Returns</b>: An iterator to the element with the key of the
+   //!   constructed value and true if the insertion took place.
+   template<class ...Args>
+   std::pair<iterator, bool> emplace(Args&&... args);
+
+   //! <b>Effects</b>: If no element has key k, inserts an element whose key
+   //!   is copy constructed from k and whose mapped value is constructed
+   //!   forwarding args with boost::forward. Otherwise args are not touched,
+   //!   so movable arguments are not moved from. args must not refer to
+   //!   elements of the map.
+   //!
+   //! <b>Returns</b>: An iterator to the element with key k and true if
+   //!   the insertion took place.
+   template<class ...Args>
+   std::pair<iterator, bool> try_emplace(const key_type &k, Args&&... args);
+
+   //! <b>Effects</b>: Same as the previous overload, but the key of the
+   //!   inserted element is move constructed from k.
+   template<class ...Args>
+   std::pair<iterator, bool> try_emplace(key_type &&k, Args&&... args);
+   #else
+   #define BOOST_PP_LOCAL_MACRO(n)                                                        \
+   BOOST_MOVE_PP_TEMPLATE_DECL(n)                                                         \
+   std::pair<iterator, bool> emplace(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM, _))            \
+   {                                                                                      \
+      storage_t tmp_storage;                                                              \
+      value_type *const tmp = BOOST_MOVE_PP_CONSTRUCT(n, value_type, &tmp_storage);       \
+      size_type idx;                                                                      \
+      bool found;                                                                         \
+      try{                                                                                \
+         found = this->priv_find_or_prepare(tmp->first, idx);                             \
+      }                                                                                   \
+      catch(...){                                                                         \
+         tmp->~value_type();                                                              \
+         throw;                                                                           \
+      }                                                                                   \
+      if(found){                                                                          \
+         tmp->~value_type();                                                              \
+         return std::pair<iterator, bool>(this->priv_iterator(idx), false);               \
+      }                                                                                   \
+      this->priv_relocate_one(m_values + idx, tmp);                                       \
+      ++m_size;                                                                           \
+      return std::pair<iterator, bool>(this->priv_iterator(idx), true);                   \
+   }                                                                                      \
+                                                                                          \
+   BOOST_MOVE_PP_TEMPLATE_DECL(n)                                                         \
+   std::pair<iterator, bool> try_emplace                                                  \
+      (const key_type &k BOOST_PP_ENUM_TRAILING(n, BOOST_MOVE_PP_PARAM, _))               \
+   {                                                                                      \
+      size_type idx;                                                                      \
+      if(this->priv_find_or_prepare(k, idx)){                                             \
+         return std::pair<iterator, bool>(this->priv_iterator(idx), false);               \
+      }                                                                                   \
+      try{                                                                                \
+         ::new(static_cast<void*>(m_values + idx)) value_type                             \
+            ( ::boost::movelib::piecewise_construct                                       \
+            , ::boost::movelib::forward_as_tuple(k)                                       \
+            , ::boost::movelib::forward_as_tuple                                          \
+               (BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_FORWARD, _)));                       \
+      }                                                                                   \
+      catch(...){                                                                         \
+         this->priv_cancel_insert(idx);                                                   \
+         throw;                                                                           \
+      }                                                                                   \
+      ++m_size;                                                                           \
+      return std::pair<iterator, bool>(this->priv_iterator(idx), true);                   \
+   }                                                                                      \
+                                                                                          \
+   BOOST_MOVE_PP_TEMPLATE_DECL(n)                                                         \
+   std::pair<iterator, bool> try_emplace                                                  \
+      (BOOST_RV_REF(key_type) k BOOST_PP_ENUM_TRAILING(n, BOOST_MOVE_PP_PARAM, _))        \
+   {                                                                                      \
+      size_type idx;                                                                      \
+      if(this->priv_find_or_prepare(static_cast<const key_type&>(k), idx)){               \
+         return std::pair<iterator, bool>(this->priv_iterator(idx), false);               \
+      }                                                                                   \
+      try{                                                                                \
+         ::new(static_cast<void*>(m_values + idx)) value_type                             \
+            ( ::boost::movelib::piecewise_construct                                       \
+            , ::boost::movelib::forward_as_tuple(::boost::move(k))                        \
+            , ::boost::movelib::forward_as_tuple                                          \
+               (BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_FORWARD, _)));                       \
+      }                                                                                   \
+      catch(...){                                                                         \
+         this->priv_cancel_insert(idx);                                                   \
+         throw;                                                                           \
+      }                                                                                   \
+      ++m_size;                                                                           \
+      return std::pair<iterator, bool>(this->priv_iterator(idx), true);                   \
+   }                                                                                      \
+   //
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+   #endif
+
+   //! <b>Effects</b>: Erases the element with key k, if any, shifting back
+   //!   the elements that follow it in its probe sequence.
+   //!
+   //! <b>Returns</b>: The number of erased elements.
+   size_type erase(const key_type &k)
+   {
+      size_type idx;
+      unsigned d;
+      if(!this->priv_find(k, idx, d)){
+         return 0u;
+      }
+      this->priv_erase_at(idx);
+      return 1u;
+   }
+
+   //! <b>Effects</b>: Erases the element pointed by pos, shifting back
+   //!   the elements that follow it in its probe sequence. All iterators
+   //!   are invalidated.
+   void erase(const_iterator pos)
+   {
+      BOOST_ASSERT(pos != this->end());
+      this->priv_erase_at(static_cast<size_type>(pos.dist() - m_dist));
+   }
+
+   /// @cond
+   private:
+
+   hash_map *const_cast_this() const
+   {  return const_cast<hash_map*>(this);  }
+
+   static size_type priv_max_load(size_type cap)
+   {  return cap - cap/8u;  }
+
+   size_type priv_home(const key_type &k) const
+   {  return ::boost::move_detail::hash_mix(m_hash(k)) & m_mask;  }
+
+   iterator priv_iterator(size_type idx)
+   {  return iterator(m_dist + idx, m_dist + this->capacity(), m_values + idx);  }
+
+   //Returns true and the slot of k if found. Otherwise idx is the slot
+   //where k would be inserted and d its probe distance there.
+   bool priv_find(const key_type &k, size_type &idx, unsigned &d) const
+   {
+      if(!m_dist){
+         return false;
+      }
+      idx = this->priv_home(k);
+      d = 1u;
+      while(m_dist[idx] >= d){
+         if(m_dist[idx] == d && m_eq(m_values[idx].first, k)){
+            return true;
+         }
+         idx = (idx + 1u) & m_mask;
+         ++d;
+      }
+      return false;
+   }
+
+   //Same as priv_find for a key known not to be in the table
+   void priv_insertion_slot(const key_type &k, size_type &idx, unsigned &d) const
+   {
+      idx = this->priv_home(k);
+      d = 1u;
+      while(m_dist[idx] >= d){
+         idx = (idx + 1u) & m_mask;
+         ++d;
+      }
+   }
+
+   //Returns true and the slot of k if found. Otherwise grows the table if
+   //needed and returns in idx an empty slot where k must be constructed.
+   bool priv_find_or_prepare(const key_type &k, size_type &idx)
+   {
+      unsigned d;
+      if(this->priv_find(k, idx, d)){
+         return true;
+      }
+      if(!m_dist || m_size == priv_max_load(this->capacity())){
+         this->priv_rehash(m_dist ? this->capacity()*2u : size_type(min_capacity));
+         this->priv_insertion_slot(k, idx, d);
+      }
+      this->priv_make_room(idx);
+      m_dist[idx] = d;
+      return false;
+   }
+
+   //Undoes priv_find_or_prepare if the construction of the element throws
+   void priv_cancel_insert(size_type idx)
+   {  this->priv_shift_back(idx);  }
+
+   void priv_erase_at(size_type idx)
+   {
+      m_values[idx].~value_type();
+      --m_size;
+      this->priv_shift_back(idx);
+   }
+
+   //Robin Hood insertion: the element at idx and the following ones up to
+   //the next empty slot are moved one slot forward (so their probe
+   //distance grows by one), leaving idx free
+   void priv_make_room(size_type idx)
+   {
+      size_type e = idx;
+      while(m_dist[e]){
+         e = (e + 1u) & m_mask;
+      }
+      while(e != idx){
+         const size_type prev = (e - 1u) & m_mask;
+         priv_relocate_one(m_values + e, m_values + prev);
+         m_dist[e] = m_dist[prev] + 1u;
+         e = prev;
+      }
+      m_dist[idx] = 0u;
+   }
+
+   //Backward shift deletion: idx holds no element and the following
+   //elements that are not in their ideal slot are moved one slot back
+   void priv_shift_back(size_type idx)
+   {
+      size_type next = (idx + 1u) & m_mask;
+      while(m_dist[next] > 1u){
+         priv_relocate_one(m_values + idx, m_values + next);
+         m_dist[idx] = m_dist[next] - 1u;
+         idx = next;
+         next = (next + 1u) & m_mask;
+      }
+      m_dist[idx] = 0u;
+   }
+
+   //Move constructs *dst from *src and destroys *src
+   static void priv_relocate_one(value_type *dst, value_type *src)
+   {
+      if(::boost::movelib::is_trivially_relocatable<value_type>::value){
+         std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(value_type));
+      }
+      else{
+         ::new(static_cast<void*>(dst)) value_type(::boost::move(*src));
+         if(!::boost::has_trivial_destructor_after_move<value_type>::value){
+            src->~value_type();
+         }
+      }
+   }
+
+   void priv_rehash(size_type new_cap)
+   {
+      BOOST_ASSERT(priv_max_load(new_cap) >= m_size);
+      unsigned *const old_dist = m_dist;
+      value_type *const old_values = m_values;
+      const size_type old_cap = this->capacity();
+      m_dist = 0;
+      m_values = 0;
+      try{
+         this->priv_allocate(new_cap);
+      }
+      catch(...){
+         m_dist = old_dist;
+         m_values = old_values;
+         throw;
+      }
+      for(size_type i = 0; i != old_cap; ++i){
+         if(old_dist[i]){
+            size_type idx;
+            unsigned d;
+            this->priv_insertion_slot(old_values[i].first, idx, d);
+            this->priv_make_room(idx);
+            priv_relocate_one(m_values + idx, old_values + i);
+            m_dist[idx] = d;
+         }
+      }
+      ::operator delete(old_dist);
+      ::operator delete(old_values);
+   }
+
+   void priv_allocate(size_type cap)
+   {
+      BOOST_ASSERT(!m_dist && !(cap & (cap - 1u)));
+      unsigned *const d = static_cast<unsigned*>(::operator new(cap*sizeof(unsigned)));
+      try{
+         m_values = static_cast<value_type*>(::operator new(cap*sizeof(value_type)));
+      }
+      catch(...){
+         ::operator delete(d);
+         throw;
+      }
+      std::memset(d, 0, cap*sizeof(unsigned));
+      m_dist = d;
+      m_mask = cap - 1u;
+   }
+
+   void priv_deallocate()
+   {
+      ::operator delete(m_dist);
+      ::operator delete(m_values);
+      m_dist = 0;
+      m_values = 0;
+      m_mask = 0;
+   }
+
+   void priv_destroy_all()
+   {
+      for(size_type i = 0, cap = this->capacity(); i != cap; ++i){
+         if(m_dist[i]){
+            if(!::boost::has_trivial_destructor<value_type>::value){
+               m_values[i].~value_type();
+            }
+            m_dist[i] = 0u;
+         }
+      }
+   }
+
+   Hash           m_hash;
+   Pred           m_eq;
+   unsigned      *m_dist;
+   value_type    *m_values;
+   size_type      m_mask;
+   size_type      m_size;
+   /// @endcond
+};
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_HASH_MAP_HPP
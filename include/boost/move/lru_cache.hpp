@@ -0,0 +1,589 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_LRU_CACHE_HPP
+#define BOOST_MOVE_LRU_CACHE_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/pair.hpp>
+#include <boost/move/optional.hpp>
+#include <boost/move/detail/hash_mix.hpp>
+#include <boost/move/detail/atomic.hpp>
+#include <boost/move/detail/sync.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>      //std::size_t
+#include <functional>   //std::equal_to
+#include <new>          //placement new
+
+namespace boost {
+namespace movelib {
+
+//! Default eviction handler of lru_cache: the evicted value is destroyed.
+struct lru_discard
+{
+   template<class K, class V>
+   void operator()(const K &, const V &) const
+   {}
+};
+
+//! Counters of an lru_cache. Hits and misses are counted by get(), take()
+//! and visit(); evictions are the entries removed to make room for put().
+struct lru_cache_stats
+{
+   std::size_t hits;
+   std::size_t misses;
+   std::size_t evictions;
+};
+
+//! A cache of at most capacity() entries that evicts the least recently
+//! used entry when a new key is put in a full cache.
+//!
+//! Entries are stored in a slab allocated at construction, linked in
+//! recency order and in the chains of a hash table with intrusive indices,
+//! so no memory is allocated after construction. Values are moved in by
+//! put() and moved out by take() and by eviction: the EvictionHandler is
+//! called as handler(key, ::boost::move(value)) before the entry is
+//! destroyed, so it receives a V&amp;&amp; (an rv&lt;V&gt;&amp; in C++03
+//! compilers for types with move emulation) and can move the value to
+//! another tier without copying it.
+//!
+//! Works with movable-only (BOOST_MOVABLE_BUT_NOT_COPYABLE) values in C++03
+//! compilers. Keys are copied into the cache. The cache is not thread-safe:
+//! see sharded_lru_cache.
+template< class Key, class T
+        , class EvictionHandler = lru_discard
+        , class Hash = ::boost::hash<Key>
+        , class Pred = std::equal_to<Key> >
+class lru_cache
+{
+   /// @cond
+   lru_cache(const lru_cache &);
+   lru_cache &operator=(const lru_cache &);
+
+   typedef ::boost::movelib::pair<Key, T> value_type;
+   BOOST_STATIC_ASSERT(::boost::alignment_of<value_type>::value <= ::boost::alignment_of< ::boost::detail::max_align>::value);
+   typedef typename ::boost::aligned_storage
+      <sizeof(value_type), ::boost::alignment_of<value_type>::value>::type storage_t;
+
+   struct entry
+   {
+      std::size_t    m_prev;     //More recently used entry
+      std::size_t    m_next;     //Less recently used entry or next free entry
+      std::size_t    m_chain;    //Next entry of the hash bucket
+      std::size_t    m_hash;
+      storage_t      m_storage;
+
+      value_type &value()
+      {  return *static_cast<value_type*>(static_cast<void*>(&m_storage));  }
+
+      const value_type &value() const
+      {  return *static_cast<const value_type*>(static_cast<const void*>(&m_storage));  }
+   };
+
+   static const std::size_t npos = std::size_t(-1);
+   /// @endcond
+
+   public:
+   typedef Key             key_type;
+   typedef T               mapped_type;
+   typedef std::size_t     size_type;
+
+   //! <b>Requires</b>: capacity > 0.
+   //!
+   //! <b>Effects</b>: Allocates the slab for capacity entries and the hash buckets.
+   explicit lru_cache( size_type capacity, const EvictionHandler &handler = EvictionHandler()
+                     , const Hash &h = Hash(), const Pred &eq = Pred())
+      : m_evict(handler), m_hash(h), m_eq(eq)
+      , m_slab(0), m_buckets(0), m_mask(0), m_capacity(capacity), m_size(0)
+      , m_head(npos), m_tail(npos), m_free(npos)
+   {
+      BOOST_ASSERT(capacity > 0);
+      size_type nbuckets = 1u;
+      while(nbuckets < capacity){
+         nbuckets *= 2u;
+      }
+      m_slab = static_cast<entry*>(::operator new(capacity*sizeof(entry)));
+      try{
+         m_buckets = static_cast<size_type*>(::operator new(nbuckets*sizeof(size_type)));
+      }
+      catch(...){
+         ::operator delete(m_slab);
+         throw;
+      }
+      m_mask = nbuckets - 1u;
+      for(size_type i = 0; i != nbuckets; ++i){
+         m_buckets[i] = npos;
+      }
+      for(size_type i = capacity; i--; ){
+         m_slab[i].m_next = m_free;
+         m_free = i;
+      }
+      this->reset_stats();
+   }
+
+   //! <b>Effects</b>: Destroys the entries without calling the eviction handler.
+   ~lru_cache()
+   {
+      this->clear();
+      ::operator delete(m_buckets);
+      ::operator delete(m_slab);
+   }
+
+   size_type size() const     {  return m_size;  }
+   size_type capacity() const {  return m_capacity;  }
+   bool empty() const         {  return !m_size;  }
+
+   //! <b>Returns</b>: A pointer to the value of key k, or null. The entry
+   //!   becomes the most recently used. Counts a hit or a miss.
+   T *get(const key_type &k)
+   {
+      const size_type i = this->priv_find(k, m_hash(k));
+      if(i == npos){
+         ++m_stats.misses;
+         return 0;
+      }
+      ++m_stats.hits;
+      this->priv_touch(i);
+      return &m_slab[i].value().second;
+   }
+
+   //! <b>Returns</b>: A pointer to the value of key k, or null. Neither
+   //!   the recency order nor the counters are modified.
+   const T *peek(const key_type &k) const
+   {
+      const size_type i = this->priv_find(k, m_hash(k));
+      return i == npos ? 0 : &m_slab[i].value().second;
+   }
+
+   //! <b>Returns</b>: true if key k is in the cache.
+   bool contains(const key_type &k) const
+   {  return this->peek(k) != 0;  }
+
+   //! <b>Effects</b>: If key k is in the cache, copy assigns v to its value.
+   //!   Otherwise inserts a copy of k and v, evicting the least recently
+   //!   used entry if the cache is full. The entry becomes the most
+   //!   recently used.
+   //!
+   //! <b>Returns</b>: true if a new entry was inserted.
+   //!
+   //! <b>Throws</b>: If the eviction handler throws, nothing is inserted and
+   //!   the least recently used entry stays in the cache, but its value may
+   //!   have been moved from. If copying k or v throws, the entry is not
+   //!   inserted (an entry may have been evicted to make room for it).
+   bool put(const key_type &k, const T &v)
+   {
+      const std::size_t h = m_hash(k);
+      size_type i = this->priv_find(k, h);
+      if(i != npos){
+         m_slab[i].value().second = v;
+         this->priv_touch(i);
+         return false;
+      }
+      i = this->priv_free_slot();
+      try{
+         ::new(static_cast<void*>(&m_slab[i].m_storage)) value_type(k, v);
+      }
+      catch(...){
+         this->priv_release_slot(i);
+         throw;
+      }
+      this->priv_link(i, h);
+      return true;
+   }
+
+   //! <b>Effects</b>: Same as the previous overload, but v is moved into
+   //!   the cache.
+   bool put(const key_type &k, BOOST_RV_REF(T) v)
+   {
+      const std::size_t h = m_hash(k);
+      size_type i = this->priv_find(k, h);
+      if(i != npos){
+         m_slab[i].value().second = ::boost::move(v);
+         this->priv_touch(i);
+         return false;
+      }
+      i = this->priv_free_slot();
+      try{
+         ::new(static_cast<void*>(&m_slab[i].m_storage)) value_type(k, ::boost::move(v));
+      }
+      catch(...){
+         this->priv_release_slot(i);
+         throw;
+      }
+      this->priv_link(i, h);
+      return true;
+   }
+
+   //! <b>Effects</b>: Removes the entry of key k, if any, moving its value
+   //!   out. Counts a hit or a miss.
+   //!
+   //! <b>Returns</b>: The value of key k, or a disengaged optional.
+   optional<T> take(const key_type &k)
+   {
+      optional<T> r;
+      const size_type i = this->priv_find(k, m_hash(k));
+      if(i == npos){
+         ++m_stats.misses;
+      }
+      else{
+         ++m_stats.hits;
+         r = ::boost::move(m_slab[i].value().second);
+         this->priv_remove(i);
+      }
+      return ::boost::move(r);
+   }
+
+   //! <b>Effects</b>: Removes the entry of key k, if any.
+   //!
+   //! <b>Returns</b>: true if an entry was removed.
+   bool erase(const key_type &k)
+   {
+      const size_type i = this->priv_find(k, m_hash(k));
+      if(i == npos){
+         return false;
+      }
+      this->priv_remove(i);
+      return true;
+   }
+
+   //! <b>Effects</b>: Destroys all the entries without calling the eviction
+   //!   handler. The counters are not modified.
+   void clear()
+   {
+      while(m_head != npos){
+         this->priv_remove(m_head);
+      }
+   }
+
+   //! <b>Returns</b>: The hit, miss and eviction counters.
+   lru_cache_stats stats() const
+   {  return m_stats;  }
+
+   //! <b>Effects</b>: Sets the counters to zero.
+   void reset_stats()
+   {
+      m_stats.hits = 0u;
+      m_stats.misses = 0u;
+      m_stats.evictions = 0u;
+   }
+
+   EvictionHandler &eviction_handler()
+   {  return m_evict;  }
+
+   /// @cond
+   private:
+
+   size_type priv_find(const key_type &k, std::size_t h) const
+   {
+      size_type i = m_buckets[::boost::move_detail::hash_mix(h) & m_mask];
+      while(i != npos && !(m_slab[i].m_hash == h && m_eq(m_slab[i].value().first, k))){
+         i = m_slab[i].m_chain;
+      }
+      return i;
+   }
+
+   //Returns an unused entry, evicting the least recently used one if needed.
+   //If the handler throws the entry is kept, possibly with a moved-from value.
+   size_type priv_free_slot()
+   {
+      if(m_free == npos){
+         const size_type lru = m_tail;
+         value_type &v = m_slab[lru].value();
+         m_evict(static_cast<const key_type&>(v.first), ::boost::move(v.second));
+         ++m_stats.evictions;
+         this->priv_remove(lru);
+      }
+      const size_type i = m_free;
+      m_free = m_slab[i].m_next;
+      return i;
+   }
+
+   //Links a constructed entry as the most recently used one
+   void priv_link(size_type i, std::size_t h)
+   {
+      entry &e = m_slab[i];
+      size_type &bucket = m_buckets[::boost::move_detail::hash_mix(h) & m_mask];
+      e.m_hash  = h;
+      e.m_chain = bucket;
+      bucket    = i;
+      e.m_prev  = npos;
+      e.m_next  = m_head;
+      if(m_head != npos){
+         m_slab[m_head].m_prev = i;
+      }
+      else{
+         m_tail = i;
+      }
+      m_head = i;
+      ++m_size;
+   }
+
+   void priv_unlink_recency(size_type i)
+   {
+      entry &e = m_slab[i];
+      (e.m_prev != npos ? m_slab[e.m_prev].m_next : m_head) = e.m_next;
+      (e.m_next != npos ? m_slab[e.m_next].m_prev : m_tail) = e.m_prev;
+   }
+
+   void priv_touch(size_type i)
+   {
+      if(m_head != i){
+         this->priv_unlink_recency(i);
+         entry &e = m_slab[i];
+         e.m_prev = npos;
+         e.m_next = m_head;
+         m_slab[m_head].m_prev = i;
+         m_head = i;
+      }
+   }
+
+   //Unlinks and destroys an entry and returns it to the free list
+   void priv_remove(size_type i)
+   {
+      entry &e = m_slab[i];
+      size_type *link = &m_buckets[::boost::move_detail::hash_mix(e.m_hash) & m_mask];
+      while(*link != i){
+         link = &m_slab[*link].m_chain;
+      }
+      *link = e.m_chain;
+      this->priv_unlink_recency(i);
+      e.value().~value_type();
+      this->priv_release_slot(i);
+      --m_size;
+   }
+
+   //Returns an unused slot to the free list
+   void priv_release_slot(size_type i)
+   {
+      m_slab[i].m_next = m_free;
+      m_free = i;
+   }
+
+   EvictionHandler   m_evict;
+   Hash              m_hash;
+   Pred              m_eq;
+   entry            *m_slab;
+   size_type        *m_buckets;
+   size_type         m_mask;
+   const size_type   m_capacity;
+   size_type         m_size;
+   size_type         m_head;
+   size_type         m_tail;
+   size_type         m_free;
+   lru_cache_stats   m_stats;
+   /// @endcond
+};
+
+//! An LRU cache for multi-threaded use split in shards, each one an
+//! lru_cache protected by its own mutex. Keys are assigned to shards by
+//! hash, so threads using different keys rarely contend, and each shard
+//! evicts its own least recently used entry.
+//!
+//! There are no functions returning references to the values, as another
+//! thread might evict them: use take() or visit(). The eviction handler of
+//! each shard is a copy of the one supplied and it's called while the
+//! shard's mutex is locked.
+template< class Key, class T
+        , class EvictionHandler = lru_discard
+        , class Hash = ::boost::hash<Key>
+        , class Pred = std::equal_to<Key> >
+class sharded_lru_cache
+{
+   /// @cond
+   sharded_lru_cache(const sharded_lru_cache &);
+   sharded_lru_cache &operator=(const sharded_lru_cache &);
+
+   typedef lru_cache<Key, T, EvictionHandler, Hash, Pred> cache_t;
+
+   struct shard
+   {
+      shard(std::size_t capacity, const EvictionHandler &handler, const Hash &h, const Pred &eq)
+         : m_mtx(), m_cache(capacity, handler, h, eq)
+      {}
+
+      mutable ::boost::move_detail::mutex m_mtx;
+      cache_t                             m_cache;
+      //Keeps the mutexes of different shards in different cache lines
+      char                                m_pad[BOOST_MOVE_CACHE_LINE_SIZE];
+   };
+   /// @endcond
+
+   public:
+   typedef Key             key_type;
+   typedef T               mapped_type;
+   typedef std::size_t     size_type;
+
+   //! <b>Requires</b>: capacity > 0 and shards > 0.
+   //!
+   //! <b>Effects</b>: Constructs shards caches of capacity/shards entries
+   //!   (rounded up).
+   sharded_lru_cache( size_type capacity, size_type shards
+                    , const EvictionHandler &handler = EvictionHandler()
+                    , const Hash &h = Hash(), const Pred &eq = Pred())
+      : m_hash(h), m_shards(0), m_count(0)
+   {
+      BOOST_ASSERT(capacity > 0 && shards > 0);
+      const size_type per_shard = (capacity + shards - 1u)/shards;
+      m_shards = static_cast<shard*>(::operator new(shards*sizeof(shard)));
+      try{
+         for(; m_count != shards; ++m_count){
+            ::new(static_cast<void*>(m_shards + m_count)) shard(per_shard, handler, h, eq);
+         }
+      }
+      catch(...){
+         this->priv_destroy();
+         throw;
+      }
+   }
+
+   ~sharded_lru_cache()
+   {  this->priv_destroy();  }
+
+   size_type shard_count() const
+   {  return m_count;  }
+
+   size_type capacity() const
+   {  return m_count*m_shards[0].m_cache.capacity();  }
+
+   //! <b>Returns</b>: The sum of the sizes of the shards, each one read
+   //!   with its mutex locked.
+   size_type size() const
+   {
+      size_type n = 0;
+      for(size_type i = 0; i != m_count; ++i){
+         ::boost::move_detail::scoped_lock lock(m_shards[i].m_mtx);
+         n += m_shards[i].m_cache.size();
+      }
+      return n;
+   }
+
+   //! <b>Effects</b>: lru_cache::put on the shard of k.
+   bool put(const key_type &k, const T &v)
+   {
+      shard &s = this->priv_shard(k);
+      ::boost::move_detail::scoped_lock lock(s.m_mtx);
+      return s.m_cache.put(k, v);
+   }
+
+   //! <b>Effects</b>: lru_cache::put on the shard of k, moving v.
+   bool put(const key_type &k, BOOST_RV_REF(T) v)
+   {
+      shard &s = this->priv_shard(k);
+      ::boost::move_detail::scoped_lock lock(s.m_mtx);
+      return s.m_cache.put(k, ::boost::move(v));
+   }
+
+   //! <b>Effects</b>: lru_cache::take on the shard of k.
+   optional<T> take(const key_type &k)
+   {
+      shard &s = this->priv_shard(k);
+      optional<T> r;
+      {
+         ::boost::move_detail::scoped_lock lock(s.m_mtx);
+         r = s.m_cache.take(k);
+      }
+      return ::boost::move(r);
+   }
+
+   //! <b>Effects</b>: If key k is in the cache, calls f(value) with the
+   //!   shard's mutex locked and makes the entry the most recently used.
+   //!   Counts a hit or a miss.
+   //!
+   //! <b>Returns</b>: true if f was called.
+   template<class F>
+   bool visit(const key_type &k, F f)
+   {
+      shard &s = this->priv_shard(k);
+      ::boost::move_detail::scoped_lock lock(s.m_mtx);
+      T *const v = s.m_cache.get(k);
+      if(v){
+         f(*v);
+      }
+      return v != 0;
+   }
+
+   bool contains(const key_type &k) const
+   {
+      const shard &s = this->priv_shard(k);
+      ::boost::move_detail::scoped_lock lock(s.m_mtx);
+      return s.m_cache.contains(k);
+   }
+
+   bool erase(const key_type &k)
+   {
+      shard &s = this->priv_shard(k);
+      ::boost::move_detail::scoped_lock lock(s.m_mtx);
+      return s.m_cache.erase(k);
+   }
+
+   void clear()
+   {
+      for(size_type i = 0; i != m_count; ++i){
+         ::boost::move_detail::scoped_lock lock(m_shards[i].m_mtx);
+         m_shards[i].m_cache.clear();
+      }
+   }
+
+   //! <b>Returns</b>: The sum of the counters of the shards.
+   lru_cache_stats stats() const
+   {
+      lru_cache_stats r = { 0u, 0u, 0u };
+      for(size_type i = 0; i != m_count; ++i){
+         ::boost::move_detail::scoped_lock lock(m_shards[i].m_mtx);
+         const lru_cache_stats s = m_shards[i].m_cache.stats();
+         r.hits      += s.hits;
+         r.misses    += s.misses;
+         r.evictions += s.evictions;
+      }
+      return r;
+   }
+
+   void reset_stats()
+   {
+      for(size_type i = 0; i != m_count; ++i){
+         ::boost::move_detail::scoped_lock lock(m_shards[i].m_mtx);
+         m_shards[i].m_cache.reset_stats();
+      }
+   }
+
+   /// @cond
+   private:
+
+   //The shard is selected with differently mixed bits than the bucket
+   //of the shard's table, so keys of a shard use all its buckets
+   shard &priv_shard(const key_type &k) const
+   {  return m_shards[::boost::move_detail::hash_mix(m_hash(k) ^ 0x9e3779b9u) % m_count];  }
+
+   void priv_destroy()
+   {
+      while(m_count){
+         m_shards[--m_count].~shard();
+      }
+      ::operator delete(m_shards);
+   }
+
+   Hash        m_hash;
+   shard      *m_shards;
+   size_type   m_count;
+   /// @endcond
+};
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_LRU_CACHE_HPP
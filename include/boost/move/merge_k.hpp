@@ -0,0 +1,368 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_MERGE_K_HPP
+#define BOOST_MOVE_MERGE_K_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/algorithm.hpp>
+#include <boost/move/future.hpp>
+#include <boost/move/small_vector.hpp>
+#include <boost/move/thread_pool.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>    //std::lower_bound, std::sort
+#include <cstddef>      //std::size_t
+#include <functional>   //std::less
+#include <iterator>     //std::iterator_traits, std::distance
+#include <new>          //placement new
+#include <vector>
+
+namespace boost {
+
+/// @cond
+
+namespace move_detail {
+
+//Loser tree over the heads of k sorted runs. m_tree[0] holds the index of
+//the run with the smallest head and m_tree[i] (0 < i < k) the loser of the
+//match played at node i. Leaf i is node k + i, so the path from a leaf to
+//the root has ceil(log2(k)) matches. Exhausted runs lose every match and
+//ties are won by the run with the lower index, which makes the merge stable.
+template<class It, class Compare>
+class merge_k_tree
+{
+   merge_k_tree(const merge_k_tree &);
+   merge_k_tree &operator=(const merge_k_tree &);
+
+   public:
+   template<class RangeIt>
+   merge_k_tree(RangeIt first, RangeIt last, Compare comp)
+      : m_cur(), m_end(), m_tree(), m_comp(comp), m_k(0), m_active(0)
+   {
+      for(; first != last; ++first){
+         m_cur.push_back((*first).first);
+         m_end.push_back((*first).second);
+         if(m_cur.back() != m_end.back()){
+            ++m_active;
+         }
+      }
+      m_k = m_cur.size();
+      if(!m_k){
+         return;
+      }
+      //Play all the matches bottom-up, keeping the winners in the upper half
+      std::vector<std::size_t> winner(2*m_k);
+      m_tree.resize(m_k);
+      for(std::size_t i = 0; i != m_k; ++i){
+         winner[m_k + i] = i;
+      }
+      for(std::size_t n = m_k - 1; n != 0; --n){
+         const std::size_t a = winner[2*n], b = winner[2*n + 1];
+         const bool a_wins = this->priv_beats(a, b);
+         winner[n]  = a_wins ? a : b;
+         m_tree[n]  = a_wins ? b : a;
+      }
+      m_tree[0] = m_k == 1 ? 0 : winner[1];
+   }
+
+   //Number of non exhausted runs
+   std::size_t active() const
+   {  return m_active;  }
+
+   std::size_t top_run() const
+   {  return m_tree[0];  }
+
+   It &top()
+   {  BOOST_ASSERT(m_active);  return m_cur[m_tree[0]];  }
+
+   It &end_of(std::size_t run)
+   {  return m_end[run];  }
+
+   //Advances the run with the smallest head and replays its path
+   void pop()
+   {
+      std::size_t w = m_tree[0];
+      if(++m_cur[w] == m_end[w]){
+         --m_active;
+      }
+      for(std::size_t n = (m_k + w)/2; n != 0; n /= 2){
+         if(this->priv_beats(m_tree[n], w)){
+            const std::size_t tmp = m_tree[n];
+            m_tree[n] = w;
+            w = tmp;
+         }
+      }
+      m_tree[0] = w;
+   }
+
+   private:
+   bool priv_beats(std::size_t a, std::size_t b) const
+   {
+      if(m_cur[a] == m_end[a]){
+         return false;
+      }
+      if(m_cur[b] == m_end[b]){
+         return true;
+      }
+      return a < b ? !m_comp(*m_cur[b], *m_cur[a]) : m_comp(*m_cur[a], *m_cur[b]);
+   }
+
+   std::vector<It>            m_cur;
+   std::vector<It>            m_end;
+   std::vector<std::size_t>   m_tree;
+   Compare                    m_comp;
+   std::size_t                m_k;
+   std::size_t                m_active;
+};
+
+template<class RangeIt>
+struct merge_k_iterator
+{
+   typedef typename std::iterator_traits<RangeIt>::value_type::first_type type;
+};
+
+//Task of parallel_merge_k: merges the pieces of a part of the output
+template<class Range, class RandomIt, class Compare>
+struct merge_k_part
+{
+   typedef void result_type;
+
+   const Range *first;
+   const Range *last;
+   RandomIt     out;
+   Compare      comp;
+
+   void operator()() const;
+};
+
+}  //namespace move_detail {
+
+/// @endcond
+
+namespace movelib {
+
+//! <b>Requires</b>: [first, last) is a sequence of ranges, each one an
+//!   object with members first and second (std::pair or movelib::pair of
+//!   input iterators) delimiting a range sorted by comp.
+//!
+//! <b>Effects</b>: Merges the k ranges into the range starting at out,
+//!   move assigning every element (use back_move_inserter to append to a
+//!   container). The merge is stable: equivalent elements keep the order
+//!   of their ranges and, within a range, their relative order.
+//!
+//!   A loser tree over the heads of the ranges selects each element with
+//!   ceil(log2(k)) comparisons. When a single range is left, its remaining
+//!   elements are moved with one call to ::boost::move.
+//!
+//! <b>Returns</b>: The end of the output range.
+//!
+//! <b>Complexity</b>: O(N log k) comparisons and N move assignments, where
+//!   N is the total number of elements. Allocates O(k) memory.
+template<class RangeIt, class OutputIt, class Compare>
+OutputIt merge_k(RangeIt first, RangeIt last, OutputIt out, Compare comp)
+{
+   typedef typename ::boost::move_detail::merge_k_iterator<RangeIt>::type  it_t;
+   ::boost::move_detail::merge_k_tree<it_t, Compare> tree(first, last, comp);
+   while(tree.active() > 1){
+      *out = ::boost::move(*tree.top());
+      ++out;
+      tree.pop();
+   }
+   if(tree.active()){
+      out = ::boost::move(tree.top(), tree.end_of(tree.top_run()), out);
+   }
+   return out;
+}
+
+//! <b>Effects</b>: merge_k(first, last, out, std::less&lt;value_type&gt;()).
+template<class RangeIt, class OutputIt>
+OutputIt merge_k(RangeIt first, RangeIt last, OutputIt out)
+{
+   typedef typename ::boost::move_detail::merge_k_iterator<RangeIt>::type  it_t;
+   typedef typename std::iterator_traits<it_t>::value_type                 value_type;
+   return ::boost::movelib::merge_k(first, last, out, std::less<value_type>());
+}
+
+//! <b>Effects</b>: Same as merge_k, but the elements are move constructed
+//!   in the uninitialized storage starting at out.
+//!
+//! <b>Returns</b>: The end of the constructed range.
+//!
+//! <b>Throws</b>: If a comparison or a move constructor throws, the
+//!   elements constructed in the output are destroyed. The input ranges
+//!   are left in a valid but unspecified state.
+template<class RangeIt, class ForwardIt, class Compare>
+ForwardIt uninitialized_merge_k(RangeIt first, RangeIt last, ForwardIt out, Compare comp)
+{
+   typedef typename ::boost::move_detail::merge_k_iterator<RangeIt>::type  it_t;
+   typedef typename std::iterator_traits<it_t>::value_type                 value_type;
+   ::boost::move_detail::merge_k_tree<it_t, Compare> tree(first, last, comp);
+   ForwardIt cur = out;
+   try{
+      while(tree.active()){
+         ::new(static_cast<void*>(&*cur)) value_type(::boost::move(*tree.top()));
+         ++cur;
+         tree.pop();
+      }
+   }
+   catch(...){
+      for(; out != cur; ++out){
+         (*out).~value_type();
+      }
+      throw;
+   }
+   return cur;
+}
+
+//! <b>Effects</b>: uninitialized_merge_k(first, last, out, std::less&lt;value_type&gt;()).
+template<class RangeIt, class ForwardIt>
+ForwardIt uninitialized_merge_k(RangeIt first, RangeIt last, ForwardIt out)
+{
+   typedef typename ::boost::move_detail::merge_k_iterator<RangeIt>::type  it_t;
+   typedef typename std::iterator_traits<it_t>::value_type                 value_type;
+   return ::boost::movelib::uninitialized_merge_k(first, last, out, std::less<value_type>());
+}
+
+//! <b>Requires</b>: The ranges have random access iterators and out is a
+//!   random access iterator to a range with room for all the elements.
+//!   Must not be called from a task running in pool.
+//!
+//! <b>Effects</b>: Same as merge_k, but the output is split in parts that
+//!   are merged in parallel: one by the calling thread and the others by
+//!   tasks submitted to pool.
+//!
+//!   Splitter keys are chosen by sorting a sample of every range. Each
+//!   part merges, from every range, the elements not less than the previous
+//!   splitter and less than the next one, found with binary searches, so
+//!   equivalent elements go to the same part and the merge stays stable.
+//!   A part is written at the position given by the number of elements
+//!   of the preceding parts.
+//!
+//! <b>Returns</b>: out + N, where N is the total number of elements.
+//!
+//! <b>Throws</b>: The first exception thrown by the merge of a part,
+//!   after all the parts have finished.
+template<class RangeIt, class RandomIt, class Compare>
+RandomIt parallel_merge_k(thread_pool &pool, RangeIt first, RangeIt last, RandomIt out, Compare comp)
+{
+   typedef typename ::boost::move_detail::merge_k_iterator<RangeIt>::type  it_t;
+   typedef typename std::iterator_traits<RangeIt>::value_type              range_t;
+   typedef ::boost::move_detail::merge_k_part<range_t, RandomIt, Compare>  task_t;
+   //Each part should have enough elements to pay for the task
+   const std::size_t min_part_size = 4096u;
+   const std::size_t oversampling = 16u;
+
+   const std::vector<range_t> runs(first, last);
+   const std::size_t k = runs.size();
+   std::size_t total = 0;
+   for(std::size_t r = 0; r != k; ++r){
+      total += std::size_t(runs[r].second - runs[r].first);
+   }
+   std::size_t parts = pool.size() + 1u;
+   if(parts > total/min_part_size){
+      parts = total/min_part_size;
+   }
+   if(k < 2 || parts < 2){
+      return ::boost::movelib::merge_k(runs.begin(), runs.end(), out, comp);
+   }
+
+   //Sample every range proportionally to its length and select splitters
+   std::vector<it_t> samples;
+   const std::size_t sample_count = parts*oversampling;
+   for(std::size_t r = 0; r != k; ++r){
+      const std::size_t n = std::size_t(runs[r].second - runs[r].first);
+      const std::size_t s = (n*sample_count + total - 1u)/total;
+      for(std::size_t j = 0; j != s; ++j){
+         samples.push_back(runs[r].first + std::ptrdiff_t(n*(2u*j + 1u)/(2u*s)));
+      }
+   }
+   const ::boost::move_detail::indirect_compare<it_t, Compare> dcomp = { comp };
+   std::sort(samples.begin(), samples.end(), dcomp);
+
+   //pieces[p*k + r] is the piece of range r merged by part p
+   std::vector<range_t> pieces(parts*k);
+   std::vector<std::size_t> offsets(parts + 1u, 0u);
+   for(std::size_t r = 0; r != k; ++r){
+      it_t lo = runs[r].first;
+      for(std::size_t p = 0; p != parts; ++p){
+         it_t hi = runs[r].second;
+         if(p + 1u != parts){
+            const it_t &splitter = samples[samples.size()*(p + 1u)/parts];
+            hi = std::lower_bound(lo, runs[r].second, *splitter, comp);
+         }
+         pieces[p*k + r].first  = lo;
+         pieces[p*k + r].second = hi;
+         offsets[p + 1u] += std::size_t(hi - lo);
+         lo = hi;
+      }
+   }
+   for(std::size_t p = 0; p != parts; ++p){
+      offsets[p + 1u] += offsets[p];
+   }
+
+   //Submit all parts but the first one, merged by this thread
+   small_vector<future<void>, 16> futures;
+   std::size_t submitted = 1u;
+   try{
+      for(; submitted != parts; ++submitted){
+         const task_t t = { &pieces[submitted*k], &pieces[submitted*k] + k
+                          , out + std::ptrdiff_t(offsets[submitted]), comp };
+         future<void> f(pool.submit(t));
+         futures.push_back(::boost::move(f));
+      }
+      const task_t t0 = { &pieces[0], &pieces[0] + k, out, comp };
+      t0();
+   }
+   catch(...){
+      //The tasks refer to pieces: wait for them before unwinding
+      for(std::size_t i = 0; i != futures.size(); ++i){
+         futures[i].wait();
+      }
+      throw;
+   }
+   //get() rethrows the exception of a task, so wait for all the tasks first
+   for(std::size_t i = 0; i != futures.size(); ++i){
+      futures[i].wait();
+   }
+   for(std::size_t i = 0; i != futures.size(); ++i){
+      futures[i].get();
+   }
+   return out + std::ptrdiff_t(total);
+}
+
+//! <b>Effects</b>: parallel_merge_k(pool, first, last, out, std::less&lt;value_type&gt;()).
+template<class RangeIt, class RandomIt>
+RandomIt parallel_merge_k(thread_pool &pool, RangeIt first, RangeIt last, RandomIt out)
+{
+   typedef typename ::boost::move_detail::merge_k_iterator<RangeIt>::type  it_t;
+   typedef typename std::iterator_traits<it_t>::value_type                 value_type;
+   return ::boost::movelib::parallel_merge_k(pool, first, last, out, std::less<value_type>());
+}
+
+}  //namespace movelib {
+
+/// @cond
+
+namespace move_detail {
+
+template<class Range, class RandomIt, class Compare>
+void merge_k_part<Range, RandomIt, Compare>::operator()() const
+{  ::boost::movelib::merge_k(first, last, out, comp);  }
+
+}  //namespace move_detail {
+
+/// @endcond
+
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_MERGE_K_HPP
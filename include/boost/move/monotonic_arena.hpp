@@ -0,0 +1,375 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_MONOTONIC_ARENA_HPP
+#define BOOST_MOVE_MONOTONIC_ARENA_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/relocate.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>   //std::size_t
+#include <new>       //std::bad_alloc, placement new
+
+namespace boost {
+namespace movelib {
+
+//! A bump-pointer memory arena. Memory is obtained from ::operator new in
+//! chunks of geometrically growing size (or from a user supplied buffer) and
+//! it's only returned when the arena is reset or destroyed, so a whole
+//! request can allocate many small objects and free them with a single
+//! reset(). The most recent allocation can be deallocated or resized in
+//! place, which lets a buffer at the end of the arena grow without moving.
+//!
+//! The arena is not thread-safe.
+class monotonic_arena
+{
+   /// @cond
+   monotonic_arena(const monotonic_arena &);
+   monotonic_arena &operator=(const monotonic_arena &);
+
+   struct chunk
+   {
+      chunk       *m_prev;
+      std::size_t  m_size;
+   };
+
+   union header_storage
+   {
+      chunk                   c;
+      ::boost::detail::max_align  a;
+   };
+   /// @endcond
+
+   public:
+   typedef std::size_t size_type;
+
+   //! Alignment of the memory returned by allocate() by default.
+   static const size_type max_alignment = ::boost::alignment_of< ::boost::detail::max_align>::value;
+
+   //! <b>Effects</b>: Constructs an arena whose first chunk will have
+   //!   at least initial_size bytes.
+   explicit monotonic_arena(size_type initial_size = 1024u)
+      : m_cur(0), m_end(0), m_chunks(0)
+      , m_buffer(0), m_buffer_size(0), m_next_size(initial_size ? initial_size : 1u)
+   {}
+
+   //! <b>Effects</b>: Constructs an arena that allocates from the buffer
+   //!   [buffer, buffer + size) before using the heap. The buffer is not owned.
+   monotonic_arena(void *buffer, size_type size)
+      : m_cur(static_cast<char*>(buffer)), m_end(static_cast<char*>(buffer) + size), m_chunks(0)
+      , m_buffer(static_cast<char*>(buffer)), m_buffer_size(size), m_next_size(size ? size : 1u)
+   {}
+
+   //! <b>Effects</b>: Returns all chunks to the heap.
+   ~monotonic_arena()
+   {  this->priv_free_chunks(0);  }
+
+   //! <b>Requires</b>: align is a power of two.
+   //!
+   //! <b>Returns</b>: bytes of uninitialized memory aligned to align.
+   //!
+   //! <b>Throws</b>: std::bad_alloc if a new chunk can't be allocated.
+   void *allocate(size_type bytes, size_type align = max_alignment)
+   {
+      BOOST_ASSERT(align && !(align & (align - 1)));
+      char *p = priv_align_up(m_cur, align);
+      if(!m_cur || p > m_end || size_type(m_end - p) < bytes){
+         this->priv_new_chunk(bytes, align);
+         p = priv_align_up(m_cur, align);
+      }
+      m_cur = p + bytes;
+      return p;
+   }
+
+   //! <b>Effects</b>: If p is the most recent allocation, its memory is
+   //!   reused by the next allocation. Otherwise, does nothing: the memory
+   //!   is reclaimed by reset().
+   void deallocate(void *p, size_type bytes)
+   {
+      if(static_cast<char*>(p) + bytes == m_cur){
+         m_cur = static_cast<char*>(p);
+      }
+   }
+
+   //! <b>Requires</b>: p was allocated from *this with old_bytes bytes.
+   //!
+   //! <b>Effects</b>: If p is the most recent allocation and the current
+   //!   chunk has enough space, changes its size to new_bytes.
+   //!
+   //! <b>Returns</b>: true if the allocation was resized.
+   bool try_expand_in_place(void *p, size_type old_bytes, size_type new_bytes)
+   {
+      char *const b = static_cast<char*>(p);
+      if(b + old_bytes != m_cur || size_type(m_end - b) < new_bytes){
+         return false;
+      }
+      m_cur = b + new_bytes;
+      return true;
+   }
+
+   //! <b>Effects</b>: Makes all memory available again. The most recently
+   //!   allocated chunk (the biggest one) is kept and the rest are freed.
+   //!
+   //! <b>Requires</b>: No object allocated from the arena is used after the call.
+   void reset()
+   {
+      if(m_chunks){
+         this->priv_free_chunks(m_chunks);
+         m_chunks->m_prev = 0;
+         m_cur = priv_chunk_begin(m_chunks);
+         m_end = reinterpret_cast<char*>(m_chunks) + m_chunks->m_size;
+      }
+      else{
+         m_cur = m_buffer;
+      }
+   }
+
+   //! <b>Effects</b>: Frees all chunks. Next allocations use the initial
+   //!   buffer, if any.
+   //!
+   //! <b>Requires</b>: No object allocated from the arena is used after the call.
+   void release()
+   {
+      this->priv_free_chunks(0);
+      m_chunks = 0;
+      m_cur = m_buffer;
+      m_end = m_buffer + m_buffer_size;
+   }
+
+   //! <b>Returns</b>: The number of bytes that can be allocated, with
+   //!   alignment 1, without allocating a new chunk.
+   size_type remaining() const
+   {  return size_type(m_end - m_cur);  }
+
+   /// @cond
+   private:
+
+   static char *priv_align_up(char *p, size_type align)
+   {
+      const std::size_t addr = reinterpret_cast<std::size_t>(p);
+      return p + ((align - (addr & (align - 1))) & (align - 1));
+   }
+
+   static char *priv_chunk_begin(chunk *c)
+   {  return reinterpret_cast<char*>(c) + sizeof(header_storage);  }
+
+   void priv_new_chunk(size_type bytes, size_type align)
+   {
+      const size_type needed = bytes + align + sizeof(header_storage);
+      if(needed < bytes){
+         throw std::bad_alloc();
+      }
+      size_type size = m_next_size + sizeof(header_storage);
+      while(size < needed){
+         size *= 2u;
+      }
+      chunk *const c = static_cast<chunk*>(::operator new(size));
+      c->m_prev = m_chunks;
+      c->m_size = size;
+      m_chunks = c;
+      m_cur = priv_chunk_begin(c);
+      m_end = reinterpret_cast<char*>(c) + size;
+      m_next_size = size*2u;
+   }
+
+   //Frees every chunk except keep
+   void priv_free_chunks(chunk *keep)
+   {
+      chunk *c = m_chunks;
+      while(c){
+         chunk *const prev = c->m_prev;
+         if(c != keep){
+            ::operator delete(c);
+         }
+         c = prev;
+      }
+   }
+
+   char        *m_cur;
+   char        *m_end;
+   chunk       *m_chunks;
+   char        *m_buffer;
+   size_type    m_buffer_size;
+   size_type    m_next_size;
+   /// @endcond
+};
+
+//! Trait that tells whether an allocator has a member
+//! <i>bool try_expand_in_place(pointer p, size_type old_n, size_type new_n)</i>
+//! that resizes the allocation without moving it. It's false by default and
+//! specialized for the allocators of this library. Used by grow_buffer().
+template<class Allocator>
+struct supports_expand_in_place
+   : ::boost::integral_constant<bool, false>
+{};
+
+//! A standard allocator that obtains memory from a monotonic_arena.
+//! Deallocation only reclaims memory if it's the last allocation of the
+//! arena. Copies and rebound copies share the arena and compare equal.
+template<class T>
+class arena_allocator
+{
+   public:
+   typedef T                  value_type;
+   typedef T *                pointer;
+   typedef const T *          const_pointer;
+   typedef T &                reference;
+   typedef const T &          const_reference;
+   typedef std::size_t        size_type;
+   typedef std::ptrdiff_t     difference_type;
+
+   //Containers using different arenas can't exchange memory,
+   //so move assignment moves elements (see move_assign_container)
+   typedef ::boost::false_type   propagate_on_container_move_assignment;
+   typedef ::boost::false_type   is_always_equal;
+
+   template<class U>
+   struct rebind
+   {  typedef arena_allocator<U> other;  };
+
+   //! <b>Effects</b>: Constructs an allocator that uses arena.
+   explicit arena_allocator(monotonic_arena &arena)
+      : m_arena(&arena)
+   {}
+
+   template<class U>
+   arena_allocator(const arena_allocator<U> &other)
+      : m_arena(&other.arena())
+   {}
+
+   //! <b>Returns</b>: Memory for n objects of type T.
+   //!
+   //! <b>Throws</b>: std::bad_alloc.
+   pointer allocate(size_type n, const void * = 0)
+   {
+      if(n > this->max_size()){
+         throw std::bad_alloc();
+      }
+      return static_cast<pointer>(m_arena->allocate(n*sizeof(T), ::boost::alignment_of<T>::value));
+   }
+
+   void deallocate(pointer p, size_type n)
+   {  m_arena->deallocate(p, n*sizeof(T));  }
+
+   //! <b>Returns</b>: true if the allocation p of old_n objects was resized to
+   //!   new_n objects without moving it (it must be the last allocation of the
+   //!   arena and fit in the current chunk).
+   bool try_expand_in_place(pointer p, size_type old_n, size_type new_n)
+   {
+      return new_n <= this->max_size() &&
+             m_arena->try_expand_in_place(p, old_n*sizeof(T), new_n*sizeof(T));
+   }
+
+   size_type max_size() const
+   {  return size_type(-1)/sizeof(T);  }
+
+   void construct(pointer p, const T &v)
+   {  ::new(static_cast<void*>(p)) T(v);  }
+
+   void destroy(pointer p)
+   {  p->~T();  }
+
+   pointer address(reference r) const
+   {  return &r;  }
+
+   const_pointer address(const_reference r) const
+   {  return &r;  }
+
+   monotonic_arena &arena() const
+   {  return *m_arena;  }
+
+   /// @cond
+   private:
+   monotonic_arena *m_arena;
+   /// @endcond
+};
+
+template<class T, class U>
+inline bool operator==(const arena_allocator<T> &a, const arena_allocator<U> &b)
+{  return &a.arena() == &b.arena();  }
+
+template<class T, class U>
+inline bool operator!=(const arena_allocator<T> &a, const arena_allocator<U> &b)
+{  return &a.arena() != &b.arena();  }
+
+template<class T>
+struct supports_expand_in_place< arena_allocator<T> >
+   : ::boost::integral_constant<bool, true>
+{};
+
+}  //namespace movelib {
+
+/// @cond
+
+namespace move_detail {
+
+template<class Allocator, class T>
+inline bool try_expand_in_place(Allocator &a, T *p, std::size_t old_n, std::size_t new_n, ::boost::true_type)
+{  return a.try_expand_in_place(p, old_n, new_n);  }
+
+template<class Allocator, class T>
+inline bool try_expand_in_place(Allocator &, T *, std::size_t, std::size_t, ::boost::false_type)
+{  return false;  }
+
+}  //namespace move_detail {
+
+/// @endcond
+
+namespace movelib {
+
+//! <b>Requires</b>: p is null or was allocated from a with old_capacity
+//!   elements, of which the first size are constructed; new_capacity >= size.
+//!
+//! <b>Effects</b>: Obtains a buffer of new_capacity elements for the elements
+//!   in [p, p + size). If supports_expand_in_place&lt;Allocator&gt; is true
+//!   and the allocator can resize p in place, nothing is moved. Otherwise
+//!   the elements are relocated to a new allocation with
+//!   uninitialized_relocate, which uses std::memcpy for trivially relocatable
+//!   types and skips destructor calls when has_trivial_destructor_after_move
+//!   is true, and p is deallocated (a no-op for the arena allocators
+//!   unless p is the last allocation).
+//!
+//! <b>Returns</b>: The buffer holding the elements.
+//!
+//! <b>Throws</b>: If the allocation or a move constructor throws, p and its
+//!   elements are unchanged.
+template<class Allocator, class T>
+T *grow_buffer(Allocator &a, T *p, std::size_t size, std::size_t old_capacity, std::size_t new_capacity)
+{
+   BOOST_ASSERT(size <= old_capacity && size <= new_capacity);
+   if(p && ::boost::move_detail::try_expand_in_place
+         (a, p, old_capacity, new_capacity, supports_expand_in_place<Allocator>())){
+      return p;
+   }
+   T *const n = a.allocate(new_capacity);
+   try{
+      ::boost::movelib::uninitialized_relocate(p, p + size, n);
+   }
+   catch(...){
+      a.deallocate(n, new_capacity);
+      throw;
+   }
+   if(p){
+      a.deallocate(p, old_capacity);
+   }
+   return n;
+}
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_MONOTONIC_ARENA_HPP
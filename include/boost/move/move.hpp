@@ -137,6 +137,18 @@ struct is_lvalue_reference<T&>
    : public integral_constant<bool, true>
 {};
 
+//is_class
+template <class T>
+class is_class
+{
+   typedef char true_t;
+   class false_t { char dummy[2]; };
+   template <class U> static true_t dispatch(int U::*);
+   template <class U> static false_t dispatch(...);
+   public:
+   enum { value = sizeof(dispatch<T>(0)) == sizeof(true_t) };
+};
+
 //has_trivial_destructor
 template<class T>
 struct has_trivial_destructor
@@ -231,13 +243,30 @@ struct is_base_of
 
 namespace boost {
 
+/// @cond
+
+namespace move_detail {
+
+//Base of rv<T> when T is not a class, so that BOOST_RV_REF(int)
+//can appear in overload sets without instantiation errors
+struct nat{};
+
+}  //namespace move_detail {
+
+/// @endcond
+
 //////////////////////////////////////////////////////////////////////////////
 //
 //                            struct rv
 //
 //////////////////////////////////////////////////////////////////////////////
 template <class T>
-class rv : public T
+class rv
+   : public BOOST_MOVE_MPL_NS::if_c
+      < BOOST_MOVE_BOOST_NS::is_class<T>::value
+      , T
+      , ::boost::move_detail::nat
+      >::type
 {
    rv();
    ~rv();
@@ -771,6 +800,9 @@ class back_move_insert_iterator
    back_move_insert_iterator& operator=(typename C::reference x)
    { container_m->push_back(boost::move(x)); return *this; }
 
+   back_move_insert_iterator& operator=(BOOST_RV_REF(typename C::value_type) x)
+   { container_m->push_back(boost::move(x)); return *this; }
+
    back_move_insert_iterator& operator*()     { return *this; }
    back_move_insert_iterator& operator++()    { return *this; }
    back_move_insert_iterator& operator++(int) { return *this; }
@@ -806,6 +838,9 @@ public:
    front_move_insert_iterator& operator=(typename C::reference x)
    { container_m->push_front(boost::move(x)); return *this; }
 
+   front_move_insert_iterator& operator=(BOOST_RV_REF(typename C::value_type) x)
+   { container_m->push_front(boost::move(x)); return *this; }
+
    front_move_insert_iterator& operator*()     { return *this; }
    front_move_insert_iterator& operator++()    { return *this; }
    front_move_insert_iterator& operator++(int) { return *this; }
@@ -845,6 +880,13 @@ class move_insert_iterator
       return *this;
    }
 
+   move_insert_iterator& operator=(BOOST_RV_REF(typename C::value_type) x)
+   {
+      pos_ = container_m->insert(pos_, ::boost::move(x));
+      ++pos_;
+      return *this;
+   }
+
    move_insert_iterator& operator*()     { return *this; }
    move_insert_iterator& operator++()    { return *this; }
    move_insert_iterator& operator++(int) { return *this; }
@@ -858,6 +900,235 @@ inline move_insert_iterator<C> move_inserter(C& x, typename C::iterator it)
    return move_insert_iterator<C>(x, it);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+//
+//                         segmented_iterator_traits
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! Containers that store their elements in several contiguous blocks
+//! (like movelib::deque) specialize this trait for their iterators so that
+//! move and move_backward process a whole block at a time. A specialization
+//! defines is_segmented_iterator as true and:
+//!
+//! - segment_iterator: an iterator to the blocks,
+//! - local_iterator: a pointer to the elements of a block,
+//! - static segment_iterator segment(It): the block of an iterator,
+//! - static local_iterator local(It): the position inside its block,
+//! - static local_iterator begin(segment_iterator) and end(segment_iterator):
+//!   the elements of a block,
+//! - static It compose(segment_iterator, local_iterator): the iterator
+//!   to a position of a block, which can be end(segment).
+template <class It>
+struct segmented_iterator_traits
+{
+   static const bool is_segmented_iterator = false;
+};
+
+/// @cond
+
+namespace move_detail {
+
+template <class It>
+struct is_segmented_iterator
+   : BOOST_MOVE_BOOST_NS::integral_constant<bool, segmented_iterator_traits<It>::is_segmented_iterator>
+{};
+
+//Contiguous ranges are moved with the standard algorithms, so that
+//elements with trivial assignment are moved with a single memmove
+template <class T>
+T *move_contiguous(T *f, T *l, T *r, BOOST_MOVE_BOOST_NS::integral_constant<bool, true>)
+{
+   while (f != l) {
+      *r = ::boost::move(*f);
+      ++f; ++r;
+   }
+   return r;
+}
+
+template <class T>
+T *move_contiguous(T *f, T *l, T *r, BOOST_MOVE_BOOST_NS::integral_constant<bool, false>)
+{
+   #if !defined(BOOST_NO_RVALUE_REFERENCES)
+   return std::move(f, l, r);
+   #else
+   return std::copy(f, l, r);
+   #endif
+}
+
+template <class T>
+T *move_backward_contiguous(T *f, T *l, T *r, BOOST_MOVE_BOOST_NS::integral_constant<bool, true>)
+{
+   while (f != l) {
+      --l; --r;
+      *r = ::boost::move(*l);
+   }
+   return r;
+}
+
+template <class T>
+T *move_backward_contiguous(T *f, T *l, T *r, BOOST_MOVE_BOOST_NS::integral_constant<bool, false>)
+{
+   #if !defined(BOOST_NO_RVALUE_REFERENCES)
+   return std::move_backward(f, l, r);
+   #else
+   return std::copy_backward(f, l, r);
+   #endif
+}
+
+//Emulated movable types must be moved one by one in C++03 compilers
+template <class T>
+struct move_contiguous_one_by_one
+   #if !defined(BOOST_NO_RVALUE_REFERENCES)
+   : BOOST_MOVE_BOOST_NS::integral_constant<bool, false>
+   #else
+   : BOOST_MOVE_BOOST_NS::integral_constant<bool, has_move_emulation_enabled<T>::value>
+   #endif
+{};
+
+//move: the output is not segmented
+template <typename I, typename O>
+O move_to(I f, I l, O r, BOOST_MOVE_BOOST_NS::integral_constant<bool, false>)
+{
+   while (f != l) {
+      *r = ::boost::move(*f);
+      ++f; ++r;
+   }
+   return r;
+}
+
+template <class T>
+T *move_to(T *f, T *l, T *r, BOOST_MOVE_BOOST_NS::integral_constant<bool, false>)
+{  return move_detail::move_contiguous(f, l, r, move_contiguous_one_by_one<T>());  }
+
+//move: the output is segmented, only contiguous inputs are split
+template <typename I, typename O>
+O move_to(I f, I l, O r, BOOST_MOVE_BOOST_NS::integral_constant<bool, true>)
+{  return move_detail::move_to(f, l, r, BOOST_MOVE_BOOST_NS::integral_constant<bool, false>());  }
+
+template <class T, typename O>
+O move_to(T *f, T *l, O r, BOOST_MOVE_BOOST_NS::integral_constant<bool, true>)
+{
+   typedef segmented_iterator_traits<O> traits;
+   if (f == l) {
+      return r;
+   }
+   typename traits::segment_iterator s = traits::segment(r);
+   typename traits::local_iterator o = traits::local(r);
+   while (true) {
+      typename traits::local_iterator const e = traits::end(s);
+      T *const m = (l - f) < (e - o) ? l : f + (e - o);
+      o = move_detail::move_to(f, m, o, BOOST_MOVE_BOOST_NS::integral_constant<bool, false>());
+      f = m;
+      if (f == l) {
+         return traits::compose(s, o);
+      }
+      ++s;
+      o = traits::begin(s);
+   }
+}
+
+//move: the input is not segmented
+template <typename I, typename O>
+O move_from(I f, I l, O r, BOOST_MOVE_BOOST_NS::integral_constant<bool, false>)
+{  return move_detail::move_to(f, l, r, is_segmented_iterator<O>());  }
+
+//move: the input is segmented, every block is moved as a contiguous range
+template <typename I, typename O>
+O move_from(I f, I l, O r, BOOST_MOVE_BOOST_NS::integral_constant<bool, true>)
+{
+   typedef segmented_iterator_traits<I> traits;
+   if (f == l) {
+      return r;
+   }
+   typename traits::segment_iterator sf = traits::segment(f);
+   typename traits::segment_iterator const sl = traits::segment(l);
+   if (sf == sl) {
+      return move_detail::move_to(traits::local(f), traits::local(l), r, is_segmented_iterator<O>());
+   }
+   r = move_detail::move_to(traits::local(f), traits::end(sf), r, is_segmented_iterator<O>());
+   for (++sf; sf != sl; ++sf) {
+      r = move_detail::move_to(traits::begin(sf), traits::end(sf), r, is_segmented_iterator<O>());
+   }
+   return move_detail::move_to(traits::begin(sl), traits::local(l), r, is_segmented_iterator<O>());
+}
+
+//move_backward: the output is not segmented
+template <typename I, typename O>
+O move_backward_to(I f, I l, O r, BOOST_MOVE_BOOST_NS::integral_constant<bool, false>)
+{
+   while (f != l) {
+      --l; --r;
+      *r = ::boost::move(*l);
+   }
+   return r;
+}
+
+template <class T>
+T *move_backward_to(T *f, T *l, T *r, BOOST_MOVE_BOOST_NS::integral_constant<bool, false>)
+{  return move_detail::move_backward_contiguous(f, l, r, move_contiguous_one_by_one<T>());  }
+
+//move_backward: the output is segmented, only contiguous inputs are split
+template <typename I, typename O>
+O move_backward_to(I f, I l, O r, BOOST_MOVE_BOOST_NS::integral_constant<bool, true>)
+{  return move_detail::move_backward_to(f, l, r, BOOST_MOVE_BOOST_NS::integral_constant<bool, false>());  }
+
+template <class T, typename O>
+O move_backward_to(T *f, T *l, O r, BOOST_MOVE_BOOST_NS::integral_constant<bool, true>)
+{
+   typedef segmented_iterator_traits<O> traits;
+   if (f == l) {
+      return r;
+   }
+   typename traits::segment_iterator s = traits::segment(r);
+   typename traits::local_iterator o = traits::local(r);
+   //The position before the beginning of a block is the end of the previous one
+   if (o == traits::begin(s)) {
+      --s;
+      o = traits::end(s);
+   }
+   while (true) {
+      typename traits::local_iterator const b = traits::begin(s);
+      T *const m = (l - f) < (o - b) ? f : l - (o - b);
+      o = move_detail::move_backward_to(m, l, o, BOOST_MOVE_BOOST_NS::integral_constant<bool, false>());
+      l = m;
+      if (f == l) {
+         return traits::compose(s, o);
+      }
+      --s;
+      o = traits::end(s);
+   }
+}
+
+//move_backward: the input is not segmented
+template <typename I, typename O>
+O move_backward_from(I f, I l, O r, BOOST_MOVE_BOOST_NS::integral_constant<bool, false>)
+{  return move_detail::move_backward_to(f, l, r, is_segmented_iterator<O>());  }
+
+//move_backward: the input is segmented, every block is moved as a contiguous range
+template <typename I, typename O>
+O move_backward_from(I f, I l, O r, BOOST_MOVE_BOOST_NS::integral_constant<bool, true>)
+{
+   typedef segmented_iterator_traits<I> traits;
+   if (f == l) {
+      return r;
+   }
+   typename traits::segment_iterator const sf = traits::segment(f);
+   typename traits::segment_iterator sl = traits::segment(l);
+   if (sf == sl) {
+      return move_detail::move_backward_to(traits::local(f), traits::local(l), r, is_segmented_iterator<O>());
+   }
+   r = move_detail::move_backward_to(traits::begin(sl), traits::local(l), r, is_segmented_iterator<O>());
+   for (--sl; sl != sf; --sl) {
+      r = move_detail::move_backward_to(traits::begin(sl), traits::end(sl), r, is_segmented_iterator<O>());
+   }
+   return move_detail::move_backward_to(traits::local(f), traits::end(sf), r, is_segmented_iterator<O>());
+}
+
+}  //namespace move_detail {
+
+/// @endcond
+
 //////////////////////////////////////////////////////////////////////////////
 //
 //                               move
@@ -874,15 +1145,15 @@ inline move_insert_iterator<C> move_inserter(C& x, typename C::iterator it)
 //! <b>Requires</b>: result shall not be in the range [first,last).
 //!
 //! <b>Complexity</b>: Exactly last - first move assignments.
+//!
+//! <b>Note</b>: If first or result are segmented iterators (see
+//!   segmented_iterator_traits), the range is moved block by block, and
+//!   elements with a trivial assignment are moved with a memmove per block.
 template <typename I, // I models InputIterator
           typename O> // O models OutputIterator
 O move(I f, I l, O result)
 {
-   while (f != l) {
-      *result = ::boost::move(*f);
-      ++f; ++result;
-   }
-   return result;
+   return ::boost::move_detail::move_from(f, l, result, ::boost::move_detail::is_segmented_iterator<I>());
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -901,15 +1172,13 @@ O move(I f, I l, O result)
 //! <b>Returns</b>: result - (last - first).
 //!
 //! <b>Complexity</b>: Exactly last - first assignments.
+//!
+//! <b>Note</b>: Segmented iterators are handled as in move.
 template <typename I, // I models BidirectionalIterator
 typename O> // O models BidirectionalIterator
 O move_backward(I f, I l, O result)
 {
-   while (f != l) {
-      --l; --result;
-      *result = ::boost::move(*l);
-   }
-   return result;
+   return ::boost::move_detail::move_backward_from(f, l, result, ::boost::move_detail::is_segmented_iterator<I>());
 }
 
 //////////////////////////////////////////////////////////////////////////////
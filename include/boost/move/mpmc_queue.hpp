@@ -0,0 +1,345 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_MPMC_QUEUE_HPP
+#define BOOST_MOVE_MPMC_QUEUE_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/relocate.hpp>
+#include <boost/move/wait_strategy.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
+#include <boost/move/detail/atomic.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/static_assert.hpp>
+#include <cstddef>   //std::size_t, std::ptrdiff_t
+#include <new>       //placement new
+
+/// @cond
+
+namespace boost {
+namespace move_detail {
+
+template<class T>
+struct mpmc_cell
+{
+   typedef typename ::boost::aligned_storage
+      <sizeof(T), ::boost::alignment_of<T>::value>::type storage_t;
+
+   T &value()
+   {  return *static_cast<T*>(static_cast<void*>(&m_storage));  }
+
+   ::boost::move_detail::atomic<std::size_t> m_seq;
+   //false if the constructor of the element threw after claiming the cell
+   bool      m_constructed;
+   storage_t m_storage;
+};
+
+}  //namespace move_detail {
+}  //namespace boost {
+
+/// @endcond
+
+namespace boost {
+namespace movelib {
+
+//! A bounded lock-free queue for any number of producer and consumer
+//! threads, based on an array of slots with per-slot sequence numbers.
+//!
+//! A producer claims a slot with a single compare-and-swap on the enqueue
+//! index, move constructs the element in place and publishes it by
+//! updating the slot's sequence number; consumers proceed symmetrically.
+//! Movable-only (BOOST_MOVABLE_BUT_NOT_COPYABLE) types are supported.
+//!
+//! The try_ operations never block. push, emplace and pop wait using
+//! WaitStrategy (spin_wait by default, or blocking_wait) until they succeed.
+template<class T, class WaitStrategy = spin_wait>
+class mpmc_queue
+{
+   /// @cond
+   mpmc_queue(const mpmc_queue &);
+   mpmc_queue &operator=(const mpmc_queue &);
+
+   typedef ::boost::move_detail::mpmc_cell<T>         cell_t;
+   typedef ::boost::move_detail::atomic<std::size_t>  atomic_index;
+   BOOST_STATIC_ASSERT(::boost::alignment_of<T>::value <= ::boost::alignment_of< ::boost::detail::max_align>::value);
+   /// @endcond
+
+   public:
+   typedef T               value_type;
+   typedef std::size_t     size_type;
+   typedef WaitStrategy    wait_strategy;
+
+   //! <b>Effects</b>: Constructs an empty queue that can hold at least n elements.
+   //!   The capacity is n rounded up to a power of two (at least 2).
+   explicit mpmc_queue(size_type n)
+      : m_cells(0), m_mask(priv_round_capacity(n) - 1), m_enqueue(0), m_dequeue(0), m_wait()
+   {
+      m_cells = static_cast<cell_t*>(::operator new((m_mask + 1)*sizeof(cell_t)));
+      for(size_type i = 0; i != m_mask + 1; ++i){
+         ::new(static_cast<void*>(&m_cells[i].m_seq)) atomic_index(i);
+      }
+   }
+
+   //! <b>Requires</b>: No thread is accessing the queue.
+   //!
+   //! <b>Effects</b>: Destroys the elements still in the queue.
+   ~mpmc_queue()
+   {
+      const size_type enq = m_enqueue.load(::boost::move_detail::memory_order_acquire);
+      for(size_type pos = m_dequeue.load(::boost::move_detail::memory_order_acquire); pos != enq; ++pos){
+         if(m_cells[pos & m_mask].m_constructed){
+            m_cells[pos & m_mask].value().~T();
+         }
+      }
+      for(size_type i = 0; i != m_mask + 1; ++i){
+         m_cells[i].m_seq.~atomic_index();
+      }
+      ::operator delete(m_cells);
+   }
+
+   //! <b>Returns</b>: The maximum number of elements in the queue.
+   size_type capacity() const
+   {  return m_mask + 1;  }
+
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   //! <b>Effects</b>: If the queue is not full, constructs a new element
+   //!   forwarding args to T's constructor.
+   //!
+   //! <b>Returns</b>: false if the queue was full. Arguments are not
+   //!   consumed in that case.
+   template<class ...Args>
+   bool try_emplace(Args&&... args);
+
+   //! <b>Effects</b>: Constructs a new element forwarding args to T's
+   //!   constructor, waiting while the queue is full.
+   template<class ...Args>
+   void emplace(Args&&... args);
+   #else
+   #define BOOST_PP_LOCAL_MACRO(n)                                                     \
+   BOOST_MOVE_PP_TEMPLATE_DECL(n)                                                      \
+   bool try_emplace(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM, _))                          \
+   {                                                                                   \
+      size_type pos;                                                                   \
+      cell_t *const cell = this->priv_claim_enqueue(pos);                              \
+      if(!cell){                                                                       \
+         return false;                                                                 \
+      }                                                                                \
+      try{                                                                             \
+         BOOST_MOVE_PP_CONSTRUCT(n, T, &cell->m_storage);                              \
+      }                                                                                \
+      catch(...){                                                                      \
+         this->priv_abandon_enqueue(cell, pos);                                        \
+         throw;                                                                        \
+      }                                                                                \
+      cell->m_constructed = true;                                                      \
+      cell->m_seq.store(pos + 1, ::boost::move_detail::memory_order_release);          \
+      m_wait.notify();                                                                 \
+      return true;                                                                     \
+   }                                                                                   \
+                                                                                       \
+   BOOST_MOVE_PP_TEMPLATE_DECL(n)                                                      \
+   void emplace(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM, _))                              \
+   {                                                                                   \
+      for(;;){                                                                         \
+         const typename WaitStrategy::ticket_type t = m_wait.prepare_wait();           \
+         if(this->try_emplace(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_FORWARD, _))){      \
+            return;                                                                    \
+         }                                                                             \
+         m_wait.wait(t);                                                               \
+      }                                                                                \
+   }                                                                                   \
+   //
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+   #endif
+
+   //! <b>Effects</b>: If the queue is not full, moves x to the queue.
+   //!
+   //! <b>Returns</b>: false if the queue was full. In that case x is not modified.
+   bool try_push(BOOST_RV_REF(T) x)
+   {  return this->try_emplace(::boost::move(x));  }
+
+   //! <b>Effects</b>: If the queue is not full, pushes a copy of x.
+   //!
+   //! <b>Returns</b>: false if the queue was full.
+   bool try_push(const T &x)
+   {  return this->try_emplace(x);  }
+
+   //! <b>Effects</b>: Moves x to the queue, waiting while the queue is full.
+   void push(BOOST_RV_REF(T) x)
+   {  this->emplace(::boost::move(x));  }
+
+   //! <b>Effects</b>: Pushes a copy of x, waiting while the queue is full.
+   void push(const T &x)
+   {  this->emplace(x);  }
+
+   //! <b>Effects</b>: If the queue is not empty, move assigns the oldest
+   //!   element to x and removes it.
+   //!
+   //! <b>Returns</b>: false if the queue was empty.
+   bool try_pop(T &x)
+   {
+      return this->pop_bulk(&x, 1u) != 0;
+   }
+
+   //! <b>Effects</b>: Move assigns the oldest element to x and removes it,
+   //!   waiting while the queue is empty.
+   void pop(T &x)
+   {
+      for(;;){
+         const typename WaitStrategy::ticket_type t = m_wait.prepare_wait();
+         if(this->try_pop(x)){
+            return;
+         }
+         m_wait.wait(t);
+      }
+   }
+
+   //! <b>Effects</b>: Claims up to max_n consecutive published elements with
+   //!   a single compare-and-swap, move assigns them to out (oldest first) and
+   //!   removes them. out can be a back_move_inserter. Does not wait.
+   //!
+   //! <b>Returns</b>: The number of elements removed.
+   //!
+   //! <b>Throws</b>: If assigning an element to out throws, that element
+   //!   and the rest of the claimed ones are destroyed and removed.
+   template<class O>
+   size_type pop_bulk(O out, size_type max_n = size_type(-1))
+   {
+      size_type got = 0;
+      while(max_n && !got){
+         size_type pos;
+         const size_type n = this->priv_claim_dequeue(pos, max_n);
+         if(!n){
+            return 0;
+         }
+         size_type i = 0;
+         try{
+            for(; i != n; ++i){
+               cell_t &cell = m_cells[(pos + i) & m_mask];
+               if(cell.m_constructed){
+                  *out = ::boost::move(cell.value());
+                  ++out;
+                  ++got;
+                  if(!::boost::has_trivial_destructor_after_move<T>::value){
+                     cell.value().~T();
+                  }
+               }
+               cell.m_seq.store(pos + i + m_mask + 1, ::boost::move_detail::memory_order_release);
+            }
+         }
+         catch(...){
+            //The claim can't be undone: the elements not handed out are
+            //lost, but their cells must be released or producers that
+            //wrap around to them would wait forever
+            for(size_type j = i; j != n; ++j){
+               cell_t &cell = m_cells[(pos + j) & m_mask];
+               if(cell.m_constructed){
+                  cell.value().~T();
+               }
+               cell.m_seq.store(pos + j + m_mask + 1, ::boost::move_detail::memory_order_release);
+            }
+            m_wait.notify();
+            throw;
+         }
+         m_wait.notify();
+      }
+      return got;
+   }
+
+   /// @cond
+   private:
+
+   static size_type priv_round_capacity(size_type n)
+   {
+      size_type c = 2u;
+      while(c < n){
+         c <<= 1;
+      }
+      return c;
+   }
+
+   //Returns the claimed cell or null if the queue is full
+   cell_t *priv_claim_enqueue(size_type &pos)
+   {
+      pos = m_enqueue.load(::boost::move_detail::memory_order_relaxed);
+      for(;;){
+         cell_t *const cell = &m_cells[pos & m_mask];
+         const size_type seq = cell->m_seq.load(::boost::move_detail::memory_order_acquire);
+         const std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq - pos);
+         if(dif == 0){
+            if(m_enqueue.compare_exchange_weak(pos, pos + 1, ::boost::move_detail::memory_order_relaxed)){
+               return cell;
+            }
+         }
+         else if(dif < 0){
+            return 0;
+         }
+         else{
+            pos = m_enqueue.load(::boost::move_detail::memory_order_relaxed);
+         }
+      }
+   }
+
+   //Claims up to max_n consecutive published cells starting at pos.
+   //Returns the number of claimed cells, zero if the queue is empty
+   size_type priv_claim_dequeue(size_type &pos, size_type max_n)
+   {
+      pos = m_dequeue.load(::boost::move_detail::memory_order_relaxed);
+      for(;;){
+         size_type n = 0;
+         while(n != max_n && n <= m_mask &&
+               m_cells[(pos + n) & m_mask].m_seq.load(::boost::move_detail::memory_order_acquire) == pos + n + 1){
+            ++n;
+         }
+         if(!n){
+            const size_type seq = m_cells[pos & m_mask].m_seq.load(::boost::move_detail::memory_order_acquire);
+            if(static_cast<std::ptrdiff_t>(seq - (pos + 1)) < 0){
+               return 0;
+            }
+            //Another consumer has claimed the cell
+            pos = m_dequeue.load(::boost::move_detail::memory_order_relaxed);
+         }
+         else if(m_dequeue.compare_exchange_weak(pos, pos + n, ::boost::move_detail::memory_order_relaxed)){
+            return n;
+         }
+      }
+   }
+
+   //The cell was claimed but the constructor threw. The claim can't be
+   //undone, so the cell is published as empty and consumers skip it.
+   void priv_abandon_enqueue(cell_t *cell, size_type pos)
+   {
+      cell->m_constructed = false;
+      cell->m_seq.store(pos + 1, ::boost::move_detail::memory_order_release);
+      m_wait.notify();
+   }
+
+   char pad0_[BOOST_MOVE_CACHE_LINE_SIZE];
+   cell_t      *m_cells;
+   size_type    m_mask;
+   char pad1_[BOOST_MOVE_CACHE_LINE_SIZE - sizeof(cell_t*) - sizeof(size_type)];
+   atomic_index m_enqueue;
+   char pad2_[BOOST_MOVE_CACHE_LINE_SIZE - sizeof(atomic_index)];
+   atomic_index m_dequeue;
+   char pad3_[BOOST_MOVE_CACHE_LINE_SIZE - sizeof(atomic_index)];
+   WaitStrategy m_wait;
+   /// @endcond
+};
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_MPMC_QUEUE_HPP
@@ -0,0 +1,292 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_OPTIONAL_HPP
+#define BOOST_MOVE_OPTIONAL_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/relocate.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/assert.hpp>
+#include <cstring>   //std::memcpy
+#include <new>       //placement new
+
+namespace boost {
+namespace movelib {
+
+//! An optional value of type T stored in place, without default
+//! constructing T and without heap allocation.
+//!
+//! Moving an optional relocates the contained value: the value is
+//! move constructed (or memcpy-ed if T is trivially relocatable) and the
+//! source is left disengaged. A moved-from optional is always empty, so
+//! <i>has_trivial_destructor_after_move&lt;optional&lt;T&gt; &gt;</i> is true
+//! and containers of optionals can skip destructor calls after relocation.
+template<class T>
+class optional
+{
+   /// @cond
+   BOOST_COPYABLE_AND_MOVABLE(optional)
+   typedef typename ::boost::aligned_storage
+      <sizeof(T), ::boost::alignment_of<T>::value>::type storage_t;
+   typedef bool optional::*unspecified_bool_type;
+   /// @endcond
+
+   public:
+   typedef T value_type;
+
+   //! <b>Effects</b>: Constructs a disengaged optional.
+   //!
+   //! <b>Throws</b>: Nothing.
+   optional()
+      : m_engaged(false)
+   {}
+
+   //! <b>Effects</b>: Constructs an engaged optional copy constructing x.
+   optional(const T &x)
+      : m_engaged(false)
+   {  this->emplace(x);  }
+
+   //! <b>Effects</b>: Constructs an engaged optional move constructing x.
+   optional(BOOST_RV_REF(T) x)
+      : m_engaged(false)
+   {  this->emplace(::boost::move(x));  }
+
+   //! <b>Effects</b>: Copy constructs the value of x, if any.
+   optional(const optional &x)
+      : m_engaged(false)
+   {
+      if(x.m_engaged){
+         this->emplace(*x);
+      }
+   }
+
+   //! <b>Effects</b>: Relocates the value of x, if any, to *this.
+   //!   x is left disengaged.
+   //!
+   //! <b>Throws</b>: Nothing unless T's move constructor throws.
+   optional(BOOST_RV_REF(optional) x)
+      : m_engaged(false)
+   {  this->priv_relocate_from(x);  }
+
+   //! <b>Effects</b>: Destroys the contained value, if any.
+   ~optional()
+   {  this->reset();  }
+
+   //! <b>Effects</b>: Copy assigns the value of x. If only one of the
+   //!   optionals is engaged the value is constructed or destroyed.
+   optional& operator=(BOOST_COPY_ASSIGN_REF(optional) x)
+   {
+      if(this != &x){
+         if(m_engaged && x.m_engaged){
+            **this = *x;
+         }
+         else if(x.m_engaged){
+            this->emplace(*x);
+         }
+         else{
+            this->reset();
+         }
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: If both optionals are engaged, move assigns the value
+   //!   of x and destroys it. Otherwise relocates the value of x, if any,
+   //!   to *this. x is left disengaged.
+   optional& operator=(BOOST_RV_REF(optional) x)
+   {
+      if(this != &x){
+         if(m_engaged && x.m_engaged){
+            **this = ::boost::move(*x);
+            x.priv_destroy_after_move();
+         }
+         else{
+            this->reset();
+            this->priv_relocate_from(x);
+         }
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Copy assigns x to the contained value
+   //!   or constructs it if *this is disengaged.
+   optional& operator=(const T &x)
+   {
+      if(m_engaged){
+         **this = x;
+      }
+      else{
+         this->emplace(x);
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Move assigns x to the contained value
+   //!   or move constructs it if *this is disengaged.
+   optional& operator=(BOOST_RV_REF(T) x)
+   {
+      if(m_engaged){
+         **this = ::boost::move(x);
+      }
+      else{
+         this->emplace(::boost::move(x));
+      }
+      return *this;
+   }
+
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   //! <b>Effects</b>: Destroys the contained value, if any, and constructs
+   //!   a new value in place forwarding args to T's constructor.
+   //!
+   //! <b>Returns</b>: A reference to the new value.
+   //!
+   //! <b>Throws</b>: If T's constructor throws, *this is left disengaged.
+   template<class ...Args>
+   T &emplace(Args&&... args);
+   #else
+   #define BOOST_PP_LOCAL_MACRO(n)                                                     \
+   BOOST_MOVE_PP_TEMPLATE_DECL(n)                                                      \
+   T &emplace(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM, _))                                \
+   {                                                                                   \
+      this->reset();                                                                   \
+      T *p = BOOST_MOVE_PP_CONSTRUCT(n, T, &m_storage);                                \
+      m_engaged = true;                                                                \
+      return *p;                                                                       \
+   }                                                                                   \
+   //
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+   #endif
+
+   //! <b>Effects</b>: Destroys the contained value, if any.
+   //!
+   //! <b>Throws</b>: Nothing.
+   void reset()
+   {
+      if(m_engaged){
+         this->get().~T();
+         m_engaged = false;
+      }
+   }
+
+   //! <b>Effects</b>: Exchanges the contents of *this and x.
+   void swap(optional &x)
+   {
+      //Relocate only engaged values, so that the compiler can see that
+      //the storage being read is initialized
+      if(m_engaged && x.m_engaged){
+         optional tmp;
+         tmp.priv_relocate_from(x);
+         x.priv_relocate_from(*this);
+         this->priv_relocate_from(tmp);
+      }
+      else if(m_engaged){
+         x.priv_relocate_from(*this);
+      }
+      else if(x.m_engaged){
+         this->priv_relocate_from(x);
+      }
+   }
+
+   //! <b>Returns</b>: true if *this contains a value.
+   bool is_initialized() const
+   {  return m_engaged;  }
+
+   //! <b>Returns</b>: An object convertible to true if *this contains a value.
+   operator unspecified_bool_type() const
+   {  return m_engaged ? &optional::m_engaged : 0;  }
+
+   bool operator!() const
+   {  return !m_engaged;  }
+
+   //! <b>Requires</b>: *this is engaged.
+   //!
+   //! <b>Returns</b>: A reference to the contained value.
+   T &get()
+   {  BOOST_ASSERT(m_engaged);  return *static_cast<T*>(static_cast<void*>(&m_storage));  }
+
+   const T &get() const
+   {  BOOST_ASSERT(m_engaged);  return *static_cast<const T*>(static_cast<const void*>(&m_storage));  }
+
+   T &operator*()             {  return this->get();  }
+   const T &operator*() const {  return this->get();  }
+   T *operator->()            {  return &this->get();  }
+   const T *operator->() const{  return &this->get();  }
+
+   //! <b>Returns</b>: A pointer to the contained value or null if *this is disengaged.
+   T *get_ptr()               {  return m_engaged ? &this->get() : 0;  }
+   const T *get_ptr() const   {  return m_engaged ? &this->get() : 0;  }
+
+   /// @cond
+   private:
+
+   void priv_destroy_after_move()
+   {
+      if(!::boost::has_trivial_destructor_after_move<T>::value){
+         this->get().~T();
+      }
+      m_engaged = false;
+   }
+
+   void priv_relocate_from(optional &x)
+   {
+      BOOST_ASSERT(!m_engaged);
+      if(x.m_engaged){
+         if(::boost::movelib::is_trivially_relocatable<T>::value){
+            std::memcpy(static_cast<void*>(&m_storage), static_cast<const void*>(&x.get()), sizeof(T));
+            x.m_engaged = false;
+         }
+         else{
+            ::new(static_cast<void*>(&m_storage)) T(::boost::move(x.get()));
+            x.priv_destroy_after_move();
+         }
+         m_engaged = true;
+      }
+   }
+
+   storage_t m_storage;
+   bool      m_engaged;
+   /// @endcond
+};
+
+}  //namespace movelib {
+
+//! A moved-from optional is disengaged, so its destructor is a no-op.
+template<class T>
+struct has_trivial_destructor_after_move< ::boost::movelib::optional<T> >
+{
+   static const bool value = true;
+};
+
+template<class T>
+struct has_nothrow_move< ::boost::movelib::optional<T> >
+{
+   static const bool value = ::boost::has_nothrow_move<T>::value ||
+                             ::boost::movelib::is_trivially_relocatable<T>::value;
+};
+
+namespace movelib {
+
+template<class T>
+struct is_trivially_relocatable< ::boost::movelib::optional<T> >
+   : ::boost::movelib::is_trivially_relocatable<T>
+{};
+
+}  //namespace movelib {
+
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_OPTIONAL_HPP
@@ -0,0 +1,209 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_PAIR_HPP
+#define BOOST_MOVE_PAIR_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/relocate.hpp>
+#include <boost/move/tuple.hpp>
+#include <boost/preprocessor/logical/or.hpp>
+#include <boost/preprocessor/logical/and.hpp>
+#include <boost/preprocessor/arithmetic/inc.hpp>
+#include <boost/preprocessor/tuple/elem.hpp>
+#include <utility>   //std::pair
+
+/// @cond
+
+#if defined(BOOST_NO_RVALUE_REFERENCES)
+#define BOOST_MOVE_PAIR_TUPLE_ARG(z, n, TUPLE_TYPE)\
+   ::boost::move_detail::tuple_getter<n>::get(BOOST_PP_TUPLE_ELEM(2, 0, TUPLE_TYPE))
+#else
+#define BOOST_MOVE_PAIR_TUPLE_ARG(z, n, TUPLE_TYPE)\
+   ::boost::forward<BOOST_PP_CAT(BOOST_PP_TUPLE_ELEM(2, 1, TUPLE_TYPE), n)>\
+      (::boost::move_detail::tuple_getter<n>::get(BOOST_PP_TUPLE_ELEM(2, 0, TUPLE_TYPE)))
+#endif
+
+//Piecewise constructor taking a tuple of n arguments for first and a tuple of m arguments for second
+#define BOOST_MOVE_PAIR_PIECEWISE(z, m, n)                                                \
+   BOOST_PP_EXPR_IF(BOOST_PP_OR(n, m), template<)                                        \
+      BOOST_PP_ENUM_PARAMS(n, class A) BOOST_PP_COMMA_IF(BOOST_PP_AND(n, m))               \
+      BOOST_PP_ENUM_PARAMS(m, class B)                                                    \
+   BOOST_PP_EXPR_IF(BOOST_PP_OR(n, m), >)                                                \
+   pair( piecewise_construct_t                                                            \
+       , tuple<BOOST_PP_ENUM_PARAMS(n, A)> a                                              \
+       , tuple<BOOST_PP_ENUM_PARAMS(m, B)> b)                                             \
+      : first(BOOST_PP_ENUM(n, BOOST_MOVE_PAIR_TUPLE_ARG, (a, A)))                        \
+      , second(BOOST_PP_ENUM(m, BOOST_MOVE_PAIR_TUPLE_ARG, (b, B)))                       \
+   {  (void)a; (void)b;  }                                                                \
+//
+
+/// @endcond
+
+namespace boost {
+namespace movelib {
+
+//! A pair of values with move semantics in C++03 and C++0x compilers.
+//!
+//! Unlike std::pair in C++03, moving a pair moves both members and
+//! members can be constructed in place from tuples of arguments
+//! using piecewise_construct and forward_as_tuple.
+template<class T1, class T2>
+struct pair
+{
+   /// @cond
+   BOOST_COPYABLE_AND_MOVABLE(pair)
+   /// @endcond
+
+   public:
+   typedef T1 first_type;
+   typedef T2 second_type;
+
+   T1 first;
+   T2 second;
+
+   //! <b>Effects</b>: Value initializes both members.
+   pair()
+      : first(), second()
+   {}
+
+   //! <b>Effects</b>: Constructs both members forwarding u and v.
+   template<class U, class V>
+   pair(BOOST_FWD_REF(U) u, BOOST_FWD_REF(V) v)
+      : first(::boost::forward<U>(u)), second(::boost::forward<V>(v))
+   {}
+
+   //! <b>Effects</b>: Copy constructs both members.
+   pair(const pair &x)
+      : first(x.first), second(x.second)
+   {}
+
+   //! <b>Effects</b>: Move constructs both members.
+   pair(BOOST_RV_REF(pair) x)
+      : first(::boost::move(x.first)), second(::boost::move(x.second))
+   {}
+
+   //! <b>Effects</b>: Copy constructs both members from p.
+   template<class U, class V>
+   pair(const std::pair<U, V> &p)
+      : first(p.first), second(p.second)
+   {}
+
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   //! <b>Effects</b>: Constructs first passing the elements of a as
+   //!   arguments and second passing the elements of b. Elements obtained
+   //!   with forward_as_tuple(::boost::move(x)) are moved into place, so
+   //!   movable-only and non-movable types can be constructed without
+   //!   temporaries.
+   template<class ...A, class ...B>
+   pair(piecewise_construct_t, tuple<A...> a, tuple<B...> b);
+   #else
+   #define BOOST_PP_LOCAL_MACRO(n)                                                     \
+   BOOST_PP_REPEAT(BOOST_PP_INC(BOOST_MOVE_TUPLE_LIMIT), BOOST_MOVE_PAIR_PIECEWISE, n)  \
+   //
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_TUPLE_LIMIT)
+   #include BOOST_PP_LOCAL_ITERATE()
+   #endif
+
+   //! <b>Effects</b>: Copy assigns both members.
+   pair &operator=(BOOST_COPY_ASSIGN_REF(pair) x)
+   {
+      first  = x.first;
+      second = x.second;
+      return *this;
+   }
+
+   //! <b>Effects</b>: Move assigns both members.
+   pair &operator=(BOOST_RV_REF(pair) x)
+   {
+      first  = ::boost::move(x.first);
+      second = ::boost::move(x.second);
+      return *this;
+   }
+
+   //! <b>Effects</b>: Copy assigns both members from p.
+   template<class U, class V>
+   pair &operator=(const std::pair<U, V> &p)
+   {
+      first  = p.first;
+      second = p.second;
+      return *this;
+   }
+
+   //! <b>Effects</b>: Swaps both members using move construction and assignment.
+   void swap(pair &x)
+   {
+      ::boost::move_detail::move_swap(first,  x.first);
+      ::boost::move_detail::move_swap(second, x.second);
+   }
+};
+
+template<class T1, class T2>
+inline bool operator==(const pair<T1, T2> &x, const pair<T1, T2> &y)
+{  return x.first == y.first && x.second == y.second;  }
+
+template<class T1, class T2>
+inline bool operator<(const pair<T1, T2> &x, const pair<T1, T2> &y)
+{  return x.first < y.first || (!(y.first < x.first) && x.second < y.second);  }
+
+template<class T1, class T2>
+inline bool operator!=(const pair<T1, T2> &x, const pair<T1, T2> &y)
+{  return !(x == y);  }
+
+template<class T1, class T2>
+inline bool operator>(const pair<T1, T2> &x, const pair<T1, T2> &y)
+{  return y < x;  }
+
+template<class T1, class T2>
+inline bool operator>=(const pair<T1, T2> &x, const pair<T1, T2> &y)
+{  return !(x < y);  }
+
+template<class T1, class T2>
+inline bool operator<=(const pair<T1, T2> &x, const pair<T1, T2> &y)
+{  return !(y < x);  }
+
+template<class T1, class T2>
+inline void swap(pair<T1, T2> &x, pair<T1, T2> &y)
+{  x.swap(y);  }
+
+//! A pair is trivially relocatable if both members are.
+template<class T1, class T2>
+struct is_trivially_relocatable< ::boost::movelib::pair<T1, T2> >
+{
+   static const bool value = ::boost::movelib::is_trivially_relocatable<T1>::value &&
+                             ::boost::movelib::is_trivially_relocatable<T2>::value;
+};
+
+}  //namespace movelib {
+
+template<class T1, class T2>
+struct has_nothrow_move< ::boost::movelib::pair<T1, T2> >
+{
+   static const bool value =
+      (::boost::has_nothrow_move<T1>::value || ::boost::movelib::is_trivially_relocatable<T1>::value) &&
+      (::boost::has_nothrow_move<T2>::value || ::boost::movelib::is_trivially_relocatable<T2>::value);
+};
+
+template<class T1, class T2>
+struct has_trivial_destructor_after_move< ::boost::movelib::pair<T1, T2> >
+{
+   static const bool value = ::boost::has_trivial_destructor_after_move<T1>::value &&
+                             ::boost::has_trivial_destructor_after_move<T2>::value;
+};
+
+}  //namespace boost {
+
+#undef BOOST_MOVE_PAIR_TUPLE_ARG
+#undef BOOST_MOVE_PAIR_PIECEWISE
+
+#endif //#ifndef BOOST_MOVE_PAIR_HPP
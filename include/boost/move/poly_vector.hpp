@@ -0,0 +1,446 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_POLY_VECTOR_HPP
+#define BOOST_MOVE_POLY_VECTOR_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/relocate.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>   //std::size_t
+#include <cstring>   //std::memcpy
+#include <iterator>  //std::random_access_iterator_tag
+#include <new>       //::operator new
+#include <vector>
+
+namespace boost {
+
+/// @cond
+
+namespace move_detail {
+
+//Type-erased operations of a type stored in a poly_vector
+struct poly_vtable
+{
+   std::size_t size;
+   std::size_t align;
+   bool        trivially_relocatable;
+   void      (*move_construct)(void *dst, void *src);
+   //Null if the destructor needs not to be called after a move
+   void      (*destroy_after_move)(void *p);
+   void      (*destroy)(void *p);
+};
+
+template<class D>
+struct poly_vtable_holder
+{
+   static void move_construct(void *dst, void *src)
+   {  ::new(dst) D(::boost::move(*static_cast<D*>(src)));  }
+
+   static void destroy(void *p)
+   {  static_cast<D*>(p)->~D();  }
+
+   static const poly_vtable vtable;
+};
+
+template<class D>
+const poly_vtable poly_vtable_holder<D>::vtable =
+{  sizeof(D)
+,  ::boost::alignment_of<D>::value
+,  ::boost::movelib::is_trivially_relocatable<D>::value
+,  &poly_vtable_holder<D>::move_construct
+,  ::boost::has_trivial_destructor_after_move<D>::value ? 0 : &poly_vtable_holder<D>::destroy
+,  &poly_vtable_holder<D>::destroy
+};
+
+struct poly_entry
+{
+   std::size_t          obj_off;    //Offset of the complete object
+   std::size_t          base_off;   //Offset of the Base subobject
+   const poly_vtable   *vtable;
+};
+
+template<class Base, class Entry, class Char>
+class poly_iterator
+{
+   public:
+   typedef Base                              value_type;
+   typedef Base &                            reference;
+   typedef Base *                            pointer;
+   typedef std::ptrdiff_t                    difference_type;
+   typedef std::random_access_iterator_tag   iterator_category;
+
+   poly_iterator()
+      : m_entry(0), m_buf(0)
+   {}
+
+   poly_iterator(Entry *e, Char *buf)
+      : m_entry(e), m_buf(buf)
+   {}
+
+   //Conversion from iterator to const_iterator
+   template<class B2, class E2, class C2>
+   poly_iterator(const poly_iterator<B2, E2, C2> &o)
+      : m_entry(o.entry()), m_buf(o.buffer())
+   {}
+
+   reference operator*() const
+   {  return *reinterpret_cast<Base*>(m_buf + m_entry->base_off);  }
+
+   pointer operator->() const
+   {  return &**this;   }
+
+   reference operator[](difference_type n) const
+   {  return *(*this + n);   }
+
+   poly_iterator& operator++()   {  ++m_entry; return *this;  }
+   poly_iterator& operator--()   {  --m_entry; return *this;  }
+   poly_iterator  operator++(int){  poly_iterator tmp(*this); ++m_entry; return tmp;  }
+   poly_iterator  operator--(int){  poly_iterator tmp(*this); --m_entry; return tmp;  }
+
+   poly_iterator& operator+=(difference_type n) {  m_entry += n; return *this;  }
+   poly_iterator& operator-=(difference_type n) {  m_entry -= n; return *this;  }
+
+   friend poly_iterator operator+(poly_iterator i, difference_type n) {  return i += n;  }
+   friend poly_iterator operator+(difference_type n, poly_iterator i) {  return i += n;  }
+   friend poly_iterator operator-(poly_iterator i, difference_type n) {  return i -= n;  }
+
+   friend difference_type operator-(const poly_iterator &x, const poly_iterator &y)
+   {  return x.m_entry - y.m_entry;  }
+
+   friend bool operator==(const poly_iterator &x, const poly_iterator &y) {  return x.m_entry == y.m_entry;  }
+   friend bool operator!=(const poly_iterator &x, const poly_iterator &y) {  return x.m_entry != y.m_entry;  }
+   friend bool operator< (const poly_iterator &x, const poly_iterator &y) {  return x.m_entry <  y.m_entry;  }
+   friend bool operator<=(const poly_iterator &x, const poly_iterator &y) {  return x.m_entry <= y.m_entry;  }
+   friend bool operator> (const poly_iterator &x, const poly_iterator &y) {  return x.m_entry >  y.m_entry;  }
+   friend bool operator>=(const poly_iterator &x, const poly_iterator &y) {  return x.m_entry >= y.m_entry;  }
+
+   Entry *entry() const  {  return m_entry;  }
+   Char  *buffer() const {  return m_buf;  }
+
+   private:
+   Entry *m_entry;
+   Char  *m_buf;
+};
+
+}  //namespace move_detail {
+
+/// @endcond
+
+namespace movelib {
+
+//! A sequence container of polymorphic objects that stores objects of
+//! different types derived from Base back-to-back in a single buffer.
+//! An offset table records the position of every object, so iterating
+//! the container is a linear scan of memory instead of chasing a pointer
+//! per element as in a vector of clone_ptr&lt;Base&gt;.
+//!
+//! When the buffer grows, objects are relocated with their move constructor
+//! through a per-type table of operations. Objects whose type is trivially
+//! relocatable (see <i>is_trivially_relocatable</i>) are relocated with
+//! std::memcpy, and if all stored objects are trivially relocatable
+//! the whole buffer is relocated with a single std::memcpy.
+//!
+//! The alignment of the stored types can't exceed the alignment
+//! guaranteed by ::operator new.
+template<class Base>
+class poly_vector
+{
+   /// @cond
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(poly_vector)
+   typedef ::boost::move_detail::poly_entry     entry_t;
+   typedef ::boost::move_detail::poly_vtable    vtable_t;
+   typedef ::boost::detail::max_align           max_align_t;
+   /// @endcond
+
+   public:
+   typedef Base                                 value_type;
+   typedef Base &                               reference;
+   typedef const Base &                         const_reference;
+   typedef std::size_t                          size_type;
+   typedef std::ptrdiff_t                       difference_type;
+   typedef ::boost::move_detail::poly_iterator
+      <Base, const entry_t, char>               iterator;
+   typedef ::boost::move_detail::poly_iterator
+      <const Base, const entry_t, const char>   const_iterator;
+
+   //! <b>Effects</b>: Constructs an empty poly_vector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   poly_vector()
+      : m_buf(0), m_used(0), m_capacity(0), m_entries(), m_nontrivial(0)
+   {}
+
+   //! <b>Effects</b>: Move constructor. Steals the buffer of x, leaving x empty.
+   //!
+   //! <b>Throws</b>: Nothing.
+   poly_vector(BOOST_RV_REF(poly_vector) x)
+      : m_buf(x.m_buf), m_used(x.m_used), m_capacity(x.m_capacity)
+      , m_entries(), m_nontrivial(x.m_nontrivial)
+   {
+      m_entries.swap(x.m_entries);
+      x.m_buf = 0;
+      x.m_used = x.m_capacity = x.m_nontrivial = 0;
+   }
+
+   //! <b>Effects</b>: Move assignment. Destroys the stored objects and
+   //!   steals the buffer of x, leaving x empty.
+   //!
+   //! <b>Throws</b>: Nothing.
+   poly_vector& operator=(BOOST_RV_REF(poly_vector) x)
+   {
+      if(this != &x){
+         this->clear();
+         ::operator delete(m_buf);
+         m_buf        = x.m_buf;
+         m_used       = x.m_used;
+         m_capacity   = x.m_capacity;
+         m_nontrivial = x.m_nontrivial;
+         m_entries.swap(x.m_entries);
+         x.m_buf = 0;
+         x.m_used = x.m_capacity = x.m_nontrivial = 0;
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Destroys all stored objects and releases the buffer.
+   ~poly_vector()
+   {
+      this->clear();
+      ::operator delete(m_buf);
+   }
+
+   iterator begin()
+   {  return iterator(this->entries(), m_buf);  }
+
+   iterator end()
+   {  return iterator(this->entries() + m_entries.size(), m_buf);  }
+
+   const_iterator begin() const
+   {  return const_iterator(this->entries(), m_buf);  }
+
+   const_iterator end() const
+   {  return const_iterator(this->entries() + m_entries.size(), m_buf);  }
+
+   //! <b>Returns</b>: The number of stored objects.
+   size_type size() const
+   {  return m_entries.size();  }
+
+   bool empty() const
+   {  return m_entries.empty();  }
+
+   //! <b>Returns</b>: The number of bytes of the object buffer in use,
+   //!   including alignment padding.
+   size_type storage_size() const
+   {  return m_used;  }
+
+   //! <b>Returns</b>: The capacity in bytes of the object buffer.
+   size_type storage_capacity() const
+   {  return m_capacity;  }
+
+   reference operator[](size_type n)
+   {  BOOST_ASSERT(n < this->size());  return this->begin()[difference_type(n)];  }
+
+   const_reference operator[](size_type n) const
+   {  BOOST_ASSERT(n < this->size());  return this->begin()[difference_type(n)];  }
+
+   reference back()
+   {  BOOST_ASSERT(!this->empty());  return this->operator[](this->size() - 1);  }
+
+   const_reference back() const
+   {  BOOST_ASSERT(!this->empty());  return this->operator[](this->size() - 1);  }
+
+   //! <b>Effects</b>: Makes sure the object buffer can hold at least
+   //!   <i>bytes</i> bytes and the offset table <i>n</i> objects without reallocating.
+   void reserve(size_type bytes, size_type n = 0)
+   {
+      m_entries.reserve(n);
+      if(bytes > m_capacity){
+         this->priv_reallocate(bytes);
+      }
+   }
+
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   //! <b>Effects</b>: Constructs an object of type D at the end of the
+   //!   buffer forwarding args to D's constructor.
+   //!
+   //! <b>Returns</b>: A reference to the new object.
+   template<class D, class ...Args>
+   D &emplace_back(Args&&... args);
+   #else
+   #define BOOST_PP_LOCAL_MACRO(n)                                                     \
+   template<class D BOOST_PP_ENUM_TRAILING_PARAMS(n, class P)>                         \
+   D &emplace_back(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM, _))                           \
+   {                                                                                   \
+      void *p = this->priv_prepare_back< D >();                                        \
+      D *d = BOOST_MOVE_PP_CONSTRUCT(n, D, p);                                         \
+      this->priv_commit_back(d, &::boost::move_detail::poly_vtable_holder<D>::vtable); \
+      return *d;                                                                       \
+   }                                                                                   \
+   //
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+   #endif
+
+   //! <b>Effects</b>: Copy constructs a D at the end of the buffer.
+   template<class D>
+   D &push_back(const D &d)
+   {  return this->template emplace_back<D>(d);  }
+
+   #if defined(BOOST_NO_RVALUE_REFERENCES) || defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   //! <b>Effects</b>: Move constructs a D at the end of the buffer.
+   template<class D>
+   D &push_back(BOOST_RV_REF(D) d)
+   {  return this->template emplace_back<D>(::boost::move(d));  }
+   #else
+   template<class D>
+   typename BOOST_MOVE_BOOST_NS::disable_if
+      < ::boost::move_detail::is_lvalue_reference<D>, D& >::type
+      push_back(D &&d)
+   {  return this->template emplace_back<D>(::boost::move(d));  }
+   #endif
+
+   //! <b>Effects</b>: Destroys the last object.
+   //!
+   //! <b>Throws</b>: Nothing.
+   void pop_back()
+   {
+      BOOST_ASSERT(!this->empty());
+      const entry_t &e = m_entries.back();
+      e.vtable->destroy(m_buf + e.obj_off);
+      if(!e.vtable->trivially_relocatable){
+         --m_nontrivial;
+      }
+      m_used = e.obj_off;
+      m_entries.pop_back();
+   }
+
+   //! <b>Effects</b>: Destroys all objects in reverse order of insertion.
+   //!   The buffer is not released.
+   //!
+   //! <b>Throws</b>: Nothing.
+   void clear()
+   {
+      while(!m_entries.empty()){
+         this->pop_back();
+      }
+      m_used = 0;
+   }
+
+   /// @cond
+   private:
+
+   const entry_t *entries() const
+   {  return m_entries.empty() ? 0 : &m_entries[0];  }
+
+   static size_type align_up(size_type n, size_type a)
+   {  return (n + a - 1) & ~(a - 1);  }
+
+   template<class D>
+   void *priv_prepare_back()
+   {
+      BOOST_STATIC_ASSERT((::boost::is_base_of<Base, D>::value));
+      BOOST_STATIC_ASSERT((::boost::alignment_of<D>::value <= ::boost::alignment_of<max_align_t>::value));
+      const size_type off = align_up(m_used, ::boost::alignment_of<D>::value);
+      if(off + sizeof(D) > m_capacity){
+         const size_type new_cap = m_capacity*2 > off + sizeof(D) ? m_capacity*2 : off + sizeof(D);
+         this->priv_reallocate(new_cap);
+      }
+      //Reserve the slot in the offset table before constructing the object
+      if(m_entries.size() == m_entries.capacity()){
+         m_entries.reserve(m_entries.empty() ? 8 : m_entries.size()*2);
+      }
+      return m_buf + off;
+   }
+
+   template<class D>
+   void priv_commit_back(D *d, const vtable_t *vt)
+   {
+      entry_t e;
+      e.obj_off  = static_cast<size_type>(reinterpret_cast<char*>(d) - m_buf);
+      e.base_off = static_cast<size_type>(reinterpret_cast<char*>(static_cast<Base*>(d)) - m_buf);
+      e.vtable   = vt;
+      m_entries.push_back(e);
+      m_used = e.obj_off + sizeof(D);
+      if(!vt->trivially_relocatable){
+         ++m_nontrivial;
+      }
+   }
+
+   void priv_reallocate(size_type new_cap)
+   {
+      char *new_buf = static_cast<char*>(::operator new(new_cap));
+      if(m_buf){
+         //Objects keep their offsets, so the offset table is still valid
+         if(!m_nontrivial){
+            std::memcpy(new_buf, m_buf, m_used);
+         }
+         else{
+            this->priv_relocate_to(new_buf);
+         }
+         ::operator delete(m_buf);
+      }
+      m_buf = new_buf;
+      m_capacity = new_cap;
+   }
+
+   void priv_relocate_to(char *new_buf)
+   {
+      const entry_t *const beg = this->entries();
+      const entry_t *const end = beg + m_entries.size();
+      const entry_t *e = beg;
+      //Construct every object in the new buffer first so that the old
+      //buffer is left intact if a move constructor throws.
+      try{
+         for(; e != end; ++e){
+            if(e->vtable->trivially_relocatable){
+               std::memcpy(new_buf + e->obj_off, m_buf + e->obj_off, e->vtable->size);
+            }
+            else{
+               e->vtable->move_construct(new_buf + e->obj_off, m_buf + e->obj_off);
+            }
+         }
+      }
+      catch(...){
+         for(const entry_t *d = beg; d != e; ++d){
+            if(!d->vtable->trivially_relocatable){
+               d->vtable->destroy(new_buf + d->obj_off);
+            }
+         }
+         ::operator delete(new_buf);
+         throw;
+      }
+      for(e = beg; e != end; ++e){
+         if(!e->vtable->trivially_relocatable && e->vtable->destroy_after_move){
+            e->vtable->destroy_after_move(m_buf + e->obj_off);
+         }
+      }
+   }
+
+   char                   *m_buf;
+   size_type               m_used;
+   size_type               m_capacity;
+   std::vector<entry_t>    m_entries;
+   size_type               m_nontrivial;
+   /// @endcond
+};
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_POLY_VECTOR_HPP
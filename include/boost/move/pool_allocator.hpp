@@ -0,0 +1,247 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_POOL_ALLOCATOR_HPP
+#define BOOST_MOVE_POOL_ALLOCATOR_HPP
+
+#include <boost/move/monotonic_arena.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>   //std::size_t
+#include <new>       //std::bad_alloc, placement new
+
+namespace boost {
+namespace movelib {
+
+//! A pool of fixed-size memory blocks kept in a free list. Blocks are carved
+//! from chunks obtained from ::operator new or, if an upstream arena is
+//! supplied, from that arena (so the whole pool is freed when the arena is
+//! reset). Blocks are aligned to monotonic_arena::max_alignment.
+//!
+//! The pool is not thread-safe.
+class fixed_pool
+{
+   /// @cond
+   fixed_pool(const fixed_pool &);
+   fixed_pool &operator=(const fixed_pool &);
+
+   struct node
+   {
+      node *m_next;
+   };
+   /// @endcond
+
+   public:
+   typedef std::size_t size_type;
+
+   //! <b>Effects</b>: Constructs a pool of blocks of at least block_size bytes
+   //!   that obtains blocks_per_chunk blocks at once from the upstream arena,
+   //!   or from the heap if upstream is null.
+   explicit fixed_pool(size_type block_size, monotonic_arena *upstream = 0, size_type blocks_per_chunk = 32u)
+      : m_block_size(priv_round_block_size(block_size)), m_blocks_per_chunk(blocks_per_chunk ? blocks_per_chunk : 1u)
+      , m_upstream(upstream), m_free(0), m_chunks(0)
+   {}
+
+   //! <b>Effects</b>: Frees the chunks obtained from the heap. Chunks obtained
+   //!   from an upstream arena are reclaimed by the arena.
+   ~fixed_pool()
+   {
+      while(m_chunks){
+         node *const next = m_chunks->m_next;
+         ::operator delete(m_chunks);
+         m_chunks = next;
+      }
+   }
+
+   //! <b>Returns</b>: The size of each block, a multiple of monotonic_arena::max_alignment.
+   size_type block_size() const
+   {  return m_block_size;  }
+
+   //! <b>Returns</b>: A block of block_size() bytes.
+   //!
+   //! <b>Throws</b>: std::bad_alloc.
+   void *allocate()
+   {
+      if(!m_free){
+         this->priv_refill();
+      }
+      node *const n = m_free;
+      m_free = n->m_next;
+      return n;
+   }
+
+   //! <b>Requires</b>: p was obtained from allocate().
+   //!
+   //! <b>Effects</b>: Returns the block to the free list.
+   void deallocate(void *p)
+   {
+      node *const n = static_cast<node*>(p);
+      n->m_next = m_free;
+      m_free = n;
+   }
+
+   /// @cond
+   private:
+
+   static size_type priv_round_block_size(size_type s)
+   {
+      const size_type a = monotonic_arena::max_alignment;
+      if(s < sizeof(node)){
+         s = sizeof(node);
+      }
+      return (s + a - 1) & ~(a - 1);
+   }
+
+   void priv_refill()
+   {
+      char *blocks;
+      if(m_upstream){
+         blocks = static_cast<char*>(m_upstream->allocate(m_block_size*m_blocks_per_chunk));
+      }
+      else{
+         //The first block of heap chunks links the chunk list
+         char *const raw = static_cast<char*>(::operator new(m_block_size*(m_blocks_per_chunk + 1)));
+         node *const c = reinterpret_cast<node*>(raw);
+         c->m_next = m_chunks;
+         m_chunks = c;
+         blocks = raw + m_block_size;
+      }
+      for(size_type i = m_blocks_per_chunk; i--; ){
+         this->deallocate(blocks + i*m_block_size);
+      }
+   }
+
+   const size_type      m_block_size;
+   const size_type      m_blocks_per_chunk;
+   monotonic_arena     *m_upstream;
+   node                *m_free;
+   node                *m_chunks;
+   /// @endcond
+};
+
+//! A standard allocator that serves allocations that fit in a block of a
+//! fixed_pool from the pool and bigger ones from ::operator new. As a block
+//! might be bigger than the requested size, try_expand_in_place lets a
+//! buffer grow up to the block size without moving. Copies and rebound
+//! copies share the pool and compare equal.
+template<class T>
+class pool_allocator
+{
+   /// @cond
+   BOOST_STATIC_ASSERT(::boost::alignment_of<T>::value <= monotonic_arena::max_alignment);
+   /// @endcond
+
+   public:
+   typedef T                  value_type;
+   typedef T *                pointer;
+   typedef const T *          const_pointer;
+   typedef T &                reference;
+   typedef const T &          const_reference;
+   typedef std::size_t        size_type;
+   typedef std::ptrdiff_t     difference_type;
+
+   //Containers using different pools can't exchange memory,
+   //so move assignment moves elements (see move_assign_container)
+   typedef ::boost::false_type   propagate_on_container_move_assignment;
+   typedef ::boost::false_type   is_always_equal;
+
+   template<class U>
+   struct rebind
+   {  typedef pool_allocator<U> other;  };
+
+   //! <b>Effects</b>: Constructs an allocator that uses pool.
+   explicit pool_allocator(fixed_pool &pool)
+      : m_pool(&pool)
+   {}
+
+   template<class U>
+   pool_allocator(const pool_allocator<U> &other)
+      : m_pool(&other.pool())
+   {}
+
+   //! <b>Returns</b>: Memory for n objects of type T.
+   //!
+   //! <b>Throws</b>: std::bad_alloc.
+   pointer allocate(size_type n, const void * = 0)
+   {
+      if(this->priv_in_pool(n)){
+         return static_cast<pointer>(m_pool->allocate());
+      }
+      if(n > this->max_size()){
+         throw std::bad_alloc();
+      }
+      return static_cast<pointer>(::operator new(n*sizeof(T)));
+   }
+
+   void deallocate(pointer p, size_type n)
+   {
+      if(this->priv_in_pool(n)){
+         m_pool->deallocate(p);
+      }
+      else{
+         ::operator delete(p);
+      }
+   }
+
+   //! <b>Returns</b>: true if both the allocation p of old_n objects and
+   //!   new_n objects fit in a block of the pool.
+   bool try_expand_in_place(pointer, size_type old_n, size_type new_n)
+   {  return this->priv_in_pool(old_n) && this->priv_in_pool(new_n);  }
+
+   size_type max_size() const
+   {  return size_type(-1)/sizeof(T);  }
+
+   void construct(pointer p, const T &v)
+   {  ::new(static_cast<void*>(p)) T(v);  }
+
+   void destroy(pointer p)
+   {  p->~T();  }
+
+   pointer address(reference r) const
+   {  return &r;  }
+
+   const_pointer address(const_reference r) const
+   {  return &r;  }
+
+   fixed_pool &pool() const
+   {  return *m_pool;  }
+
+   /// @cond
+   private:
+   bool priv_in_pool(size_type n) const
+   {  return n <= m_pool->block_size()/sizeof(T);  }
+
+   fixed_pool *m_pool;
+   /// @endcond
+};
+
+template<class T, class U>
+inline bool operator==(const pool_allocator<T> &a, const pool_allocator<U> &b)
+{  return &a.pool() == &b.pool();  }
+
+template<class T, class U>
+inline bool operator!=(const pool_allocator<T> &a, const pool_allocator<U> &b)
+{  return &a.pool() != &b.pool();  }
+
+template<class T>
+struct supports_expand_in_place< pool_allocator<T> >
+   : ::boost::integral_constant<bool, true>
+{};
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_POOL_ALLOCATOR_HPP
@@ -0,0 +1,251 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_RECYCLING_POOL_HPP
+#define BOOST_MOVE_RECYCLING_POOL_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/static_vector.hpp>
+#include <boost/move/small_vector.hpp>
+#include <boost/move/detail/atomic.hpp>
+#include <boost/move/detail/sync.hpp>
+#include <boost/static_assert.hpp>
+#include <cstddef>   //std::size_t
+
+namespace boost {
+namespace movelib {
+
+//! Default reset policy of recycling_pool: calls x.clear(), which keeps
+//! the capacity of standard-like containers.
+struct clear_reset
+{
+   template<class T>
+   void operator()(T &x) const
+   {  x.clear();  }
+};
+
+}  //namespace movelib {
+
+/// @cond
+
+namespace move_detail {
+
+//Number of pools a thread can alternate without taking the registry lock
+static const std::size_t recycling_tls_ways = 4u;
+
+struct recycling_tls
+{
+   std::size_t pool_id[recycling_tls_ways];
+   void       *cache[recycling_tls_ways];
+};
+
+//Its address also identifies the calling thread
+inline recycling_tls &recycling_thread_entry()
+{
+   static BOOST_MOVE_THREAD_LOCAL recycling_tls entry = { { 0u }, { 0 } };
+   return entry;
+}
+
+template<class Dummy>
+struct recycling_pool_ids
+{
+   static ::boost::move_detail::atomic<std::size_t> next;
+};
+
+template<class Dummy>
+::boost::move_detail::atomic<std::size_t> recycling_pool_ids<Dummy>::next(1u);
+
+}  //namespace move_detail {
+
+/// @endcond
+
+namespace movelib {
+
+//! A pool of released objects that are handed out again instead of
+//! constructing new ones. It's meant for objects that own a buffer (strings,
+//! vectors...) whose capacity is worth keeping: release() resets the object
+//! with ResetPolicy (by default calling clear()) and acquire() returns it
+//! with its capacity intact, avoiding an allocation per request when the
+//! buffers have the same size every time.
+//!
+//! Each thread has a private cache of up to CacheSize objects per pool,
+//! so acquire() and release() don't synchronize in the common case. When a
+//! cache is full, half of it is moved to a global overflow list protected by
+//! a mutex (holding at most max_global objects, the rest are destroyed);
+//! when a cache is empty it's refilled from that list.
+//!
+//! T must be move constructible and default constructible: acquire()
+//! returns a value constructed T when no object is cached.
+//!
+//! Thread caches are owned by the pool and destroyed with it: the pool must
+//! outlive every thread's last call. Objects in the cache of a thread that
+//! exits stay there until the pool is destroyed, or until a new thread
+//! happens to get the same thread-local storage.
+template<class T, class ResetPolicy = clear_reset, std::size_t CacheSize = 16>
+class recycling_pool
+{
+   /// @cond
+   BOOST_STATIC_ASSERT(CacheSize > 0);
+
+   recycling_pool(const recycling_pool &);
+   recycling_pool &operator=(const recycling_pool &);
+
+   struct cache
+   {
+      explicit cache(const void *owner, cache *next)
+         : m_owner(owner), m_next(next), m_objects()
+      {}
+
+      const void                       *m_owner;
+      cache                            *m_next;
+      static_vector<T, CacheSize>       m_objects;
+   };
+
+   static const std::size_t batch_size = CacheSize/2 ? CacheSize/2 : 1u;
+   /// @endcond
+
+   public:
+   typedef T            value_type;
+   typedef std::size_t  size_type;
+
+   //! <b>Effects</b>: Constructs an empty pool whose global overflow list
+   //!   holds at most max_global objects.
+   explicit recycling_pool(size_type max_global = size_type(-1), const ResetPolicy &reset = ResetPolicy())
+      : m_id(::boost::move_detail::recycling_pool_ids<void>::next.fetch_add(1u))
+      , m_reset(reset), m_max_global(max_global), m_mtx(), m_caches(0), m_global()
+   {}
+
+   //! <b>Requires</b>: No thread is accessing the pool.
+   //!
+   //! <b>Effects</b>: Destroys all cached objects.
+   ~recycling_pool()
+   {
+      while(m_caches){
+         cache *const next = m_caches->m_next;
+         delete m_caches;
+         m_caches = next;
+      }
+   }
+
+   //! <b>Effects</b>: Takes an object from the calling thread's cache or, if
+   //!   it's empty, from the global overflow list.
+   //!
+   //! <b>Returns</b>: A previously released object, move constructed, or T()
+   //!   if no object was available.
+   T acquire()
+   {
+      cache &c = this->priv_thread_cache();
+      if(c.m_objects.empty()){
+         this->priv_refill(c);
+         if(c.m_objects.empty()){
+            return T();
+         }
+      }
+      T r(::boost::move(c.m_objects.back()));
+      c.m_objects.pop_back();
+      return ::boost::move(r);
+   }
+
+   //! <b>Effects</b>: Resets x with the reset policy and moves it to the
+   //!   calling thread's cache, spilling part of the cache to the global
+   //!   overflow list if it's full.
+   //!
+   //! <b>Throws</b>: Any exception thrown by the reset policy or T's move
+   //!   constructor.
+   void release(BOOST_RV_REF(T) x)
+   {
+      T &obj = x;
+      m_reset(obj);
+      cache &c = this->priv_thread_cache();
+      if(c.m_objects.full()){
+         this->priv_spill(c);
+      }
+      c.m_objects.push_back(::boost::move(obj));
+   }
+
+   //! <b>Returns</b>: The number of objects in the global overflow list.
+   size_type global_size() const
+   {
+      ::boost::move_detail::scoped_lock lock(m_mtx);
+      return m_global.size();
+   }
+
+   //! <b>Effects</b>: Destroys the objects in the global overflow list.
+   void trim()
+   {
+      small_vector<T, CacheSize> tmp;
+      {
+         ::boost::move_detail::scoped_lock lock(m_mtx);
+         tmp.swap(m_global);
+      }
+   }
+
+   /// @cond
+   private:
+
+   cache &priv_thread_cache()
+   {
+      ::boost::move_detail::recycling_tls &tls = ::boost::move_detail::recycling_thread_entry();
+      const std::size_t way = m_id % ::boost::move_detail::recycling_tls_ways;
+      if(tls.pool_id[way] != m_id){
+         tls.cache[way]   = this->priv_find_cache(&tls);
+         tls.pool_id[way] = m_id;
+      }
+      return *static_cast<cache*>(tls.cache[way]);
+   }
+
+   cache *priv_find_cache(const void *owner)
+   {
+      ::boost::move_detail::scoped_lock lock(m_mtx);
+      for(cache *c = m_caches; c; c = c->m_next){
+         if(c->m_owner == owner){
+            return c;
+         }
+      }
+      m_caches = new cache(owner, m_caches);
+      return m_caches;
+   }
+
+   void priv_spill(cache &c)
+   {
+      ::boost::move_detail::scoped_lock lock(m_mtx);
+      for(size_type i = 0; i != batch_size; ++i){
+         if(m_global.size() < m_max_global){
+            m_global.push_back(::boost::move(c.m_objects.back()));
+         }
+         c.m_objects.pop_back();
+      }
+   }
+
+   void priv_refill(cache &c)
+   {
+      ::boost::move_detail::scoped_lock lock(m_mtx);
+      for(size_type i = 0; i != batch_size && !m_global.empty(); ++i){
+         c.m_objects.push_back(::boost::move(m_global.back()));
+         m_global.pop_back();
+      }
+   }
+
+   const std::size_t                   m_id;
+   ResetPolicy                         m_reset;
+   const size_type                     m_max_global;
+   mutable ::boost::move_detail::mutex m_mtx;
+   cache                              *m_caches;
+   small_vector<T, CacheSize>          m_global;
+   /// @endcond
+};
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_RECYCLING_POOL_HPP
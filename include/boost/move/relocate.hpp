@@ -0,0 +1,150 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_RELOCATE_HPP
+#define BOOST_MOVE_RELOCATE_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <cstring>   //std::memcpy
+#include <iterator>  //std::iterator_traits
+#include <new>       //placement new
+
+namespace boost {
+namespace movelib {
+
+//! If this trait yields to true
+//! (<i>is_trivially_relocatable &lt;T&gt;::value == true</i>)
+//! an object of type T can be moved to a new address with std::memcpy
+//! and the original storage can be released without calling T's destructor.
+//!
+//! By default this trait is true if the type has a trivial copy constructor
+//! and a trivial destructor. Classes that only hold pointers or handles to
+//! their resources (and don't store pointers to themselves) should specialize
+//! this trait to let containers grow with a single memcpy.
+template <class T>
+struct is_trivially_relocatable
+   : BOOST_MOVE_BOOST_NS::integral_constant
+      < bool
+      , ::boost::has_trivial_copy<T>::value && ::boost::has_trivial_destructor<T>::value>
+{};
+
+//! <b>Effects</b>: Calls the destructor of every object in the range [first,last)
+//!   unless T has a trivial destructor.
+template <class T>
+void destroy(T *f, T *l)
+{
+   if(!::boost::has_trivial_destructor<T>::value){
+      for(; f != l; ++f){
+         f->~T();
+      }
+   }
+}
+
+}  //namespace movelib {
+
+/// @cond
+
+namespace move_detail {
+
+template <class I, class F>
+F uninitialized_relocate(I f, I l, F r, BOOST_MOVE_BOOST_NS::integral_constant<bool, true>)
+{
+   typedef typename std::iterator_traits<I>::value_type value_type;
+   //Fused move and destroy: each element is touched once
+   for(; f != l; ++f, ++r){
+      ::new(static_cast<void*>(&*r)) value_type(::boost::move(*f));
+      if(!::boost::has_trivial_destructor_after_move<value_type>::value){
+         (*f).~value_type();
+      }
+   }
+   return r;
+}
+
+template <class I, class F>
+F uninitialized_relocate(I f, I l, F r, BOOST_MOVE_BOOST_NS::integral_constant<bool, false>)
+{
+   typedef typename std::iterator_traits<I>::value_type value_type;
+   //Move constructors might throw: construct everything first so
+   //that the source range is left intact if an exception is thrown.
+   F r_end = r;
+   try{
+      for(I i = f; i != l; ++i, ++r_end){
+         ::new(static_cast<void*>(&*r_end)) value_type(::boost::move(*i));
+      }
+   }
+   catch(...){
+      for(; r != r_end; ++r){
+         (*r).~value_type();
+      }
+      throw;
+   }
+   if(!::boost::has_trivial_destructor_after_move<value_type>::value){
+      for(; f != l; ++f){
+         (*f).~value_type();
+      }
+   }
+   return r_end;
+}
+
+}  //namespace move_detail {
+
+/// @endcond
+
+namespace movelib {
+
+//! <b>Effects</b>: Relocates the elements in the range [first,last) to the
+//!   uninitialized range starting at result: every element is move constructed
+//!   in the destination and the source element is destroyed (the destructor is
+//!   not called if <i>has_trivial_destructor_after_move&lt;T&gt;</i> is true).
+//!
+//! <b>Returns</b>: result + (last - first)
+//!
+//! <b>Throws</b>: If has_nothrow_move&lt;T&gt; is false and a move constructor
+//!   throws, the constructed elements are destroyed and the source range is
+//!   left unchanged.
+//!
+//! <b>Requires</b>: The destination range shall not overlap the source range.
+template <typename I, // I models ForwardIterator
+          typename F> // F models ForwardIterator
+F uninitialized_relocate(I f, I l, F r)
+{
+   typedef typename std::iterator_traits<I>::value_type value_type;
+   return ::boost::move_detail::uninitialized_relocate
+      (f, l, r, BOOST_MOVE_BOOST_NS::integral_constant<bool, ::boost::has_nothrow_move<value_type>::value>());
+}
+
+//! <b>Effects</b>: Same as the generic version, but if
+//!   <i>is_trivially_relocatable&lt;T&gt;</i> is true the whole range is
+//!   relocated with a single std::memcpy.
+template <typename T>
+T *uninitialized_relocate(T *f, T *l, T *r)
+{
+   if(::boost::movelib::is_trivially_relocatable<T>::value){
+      const std::size_t n = static_cast<std::size_t>(l - f);
+      if(n){
+         std::memcpy(static_cast<void*>(r), static_cast<const void*>(f), n*sizeof(T));
+      }
+      return r + n;
+   }
+   else{
+      return ::boost::move_detail::uninitialized_relocate
+         (f, l, r, BOOST_MOVE_BOOST_NS::integral_constant<bool, ::boost::has_nothrow_move<T>::value>());
+   }
+}
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_RELOCATE_HPP
@@ -0,0 +1,389 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_RING_BUFFER_HPP
+#define BOOST_MOVE_RING_BUFFER_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/relocate.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/has_trivial_assign.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+#include <algorithm> //std::copy
+#include <cstddef>   //std::size_t
+#include <new>       //placement new
+
+/// @cond
+
+namespace boost {
+namespace move_detail {
+
+//Trivially copyable elements are transferred with std::copy,
+//that is lowered to memmove for pointer ranges
+template<class T, class O>
+O ring_move_segment(T *f, T *l, O out, ::boost::move_detail::integral_constant<bool, true>)
+{  return std::copy(f, l, out);  }
+
+template<class T, class O>
+O ring_move_segment(T *f, T *l, O out, ::boost::move_detail::integral_constant<bool, false>)
+{  return ::boost::move(f, l, out);  }
+
+}  //namespace move_detail {
+}  //namespace boost {
+
+/// @endcond
+
+namespace boost {
+namespace movelib {
+
+//! A circular buffer with move semantics. The capacity is rounded up to
+//! a power of two so that positions are computed with a mask.
+//!
+//! When the buffer is full, push_back and emplace_back overwrite the oldest
+//! element using move assignment instead of copying it. pop_front returns
+//! the oldest element by move and move_out transfers a group of elements
+//! in at most two contiguous segments, so trivially copyable elements are
+//! transferred with memmove.
+template<class T>
+class ring_buffer
+{
+   /// @cond
+   BOOST_COPYABLE_AND_MOVABLE(ring_buffer)
+   typedef typename ::boost::aligned_storage
+      <sizeof(T), ::boost::alignment_of<T>::value>::type storage_one_t;
+   BOOST_STATIC_ASSERT(::boost::alignment_of<T>::value <= ::boost::alignment_of< ::boost::detail::max_align>::value);
+   /// @endcond
+
+   public:
+   typedef T                  value_type;
+   typedef T &                reference;
+   typedef const T &          const_reference;
+   typedef std::size_t        size_type;
+   typedef std::ptrdiff_t     difference_type;
+
+   //! <b>Effects</b>: Constructs a ring_buffer without capacity.
+   //!
+   //! <b>Throws</b>: Nothing.
+   ring_buffer()
+      : m_buf(0), m_capacity(0), m_head(0), m_size(0)
+   {}
+
+   //! <b>Effects</b>: Constructs an empty ring_buffer that can hold at least
+   //!   n elements. The capacity is n rounded up to a power of two.
+   explicit ring_buffer(size_type n)
+      : m_buf(0), m_capacity(priv_round_capacity(n)), m_head(0), m_size(0)
+   {
+      if(m_capacity){
+         m_buf = static_cast<T*>(::operator new(m_capacity*sizeof(T)));
+      }
+   }
+
+   //! <b>Effects</b>: Copy constructs the elements of x, with the same capacity.
+   ring_buffer(const ring_buffer &x)
+      : m_buf(0), m_capacity(x.m_capacity), m_head(0), m_size(0)
+   {
+      if(m_capacity){
+         m_buf = static_cast<T*>(::operator new(m_capacity*sizeof(T)));
+      }
+      try{
+         for(; m_size != x.m_size; ++m_size){
+            ::new(static_cast<void*>(m_buf + m_size)) T(x[m_size]);
+         }
+      }
+      catch(...){
+         this->clear();
+         ::operator delete(m_buf);
+         throw;
+      }
+   }
+
+   //! <b>Effects</b>: Steals the buffer of x, leaving x empty and without capacity.
+   //!
+   //! <b>Throws</b>: Nothing.
+   ring_buffer(BOOST_RV_REF(ring_buffer) x)
+      : m_buf(x.m_buf), m_capacity(x.m_capacity), m_head(x.m_head), m_size(x.m_size)
+   {
+      x.m_buf = 0;
+      x.m_capacity = x.m_head = x.m_size = 0;
+   }
+
+   //! <b>Effects</b>: Destroys the elements and releases the buffer.
+   ~ring_buffer()
+   {
+      this->clear();
+      ::operator delete(m_buf);
+   }
+
+   //! <b>Effects</b>: Copy assigns x to *this.
+   ring_buffer& operator=(BOOST_COPY_ASSIGN_REF(ring_buffer) x)
+   {
+      if(this != &x){
+         ring_buffer tmp(x);
+         *this = ::boost::move(tmp);
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Destroys the elements of *this and steals the buffer of x.
+   //!
+   //! <b>Throws</b>: Nothing.
+   ring_buffer& operator=(BOOST_RV_REF(ring_buffer) x)
+   {
+      if(this != &x){
+         this->clear();
+         ::operator delete(m_buf);
+         m_buf       = x.m_buf;
+         m_capacity  = x.m_capacity;
+         m_head      = x.m_head;
+         m_size      = x.m_size;
+         x.m_buf = 0;
+         x.m_capacity = x.m_head = x.m_size = 0;
+      }
+      return *this;
+   }
+
+   size_type size() const        {  return m_size;  }
+   size_type capacity() const    {  return m_capacity;  }
+   bool empty() const            {  return !m_size;  }
+   bool full() const             {  return m_size == m_capacity;  }
+
+   //! <b>Returns</b>: A reference to the i-th oldest element.
+   T &operator[](size_type i)
+   {  BOOST_ASSERT(i < m_size);  return m_buf[this->priv_pos(i)];  }
+
+   const T &operator[](size_type i) const
+   {  BOOST_ASSERT(i < m_size);  return m_buf[this->priv_pos(i)];  }
+
+   T &front()              {  return (*this)[0];  }
+   const T &front() const  {  return (*this)[0];  }
+   T &back()               {  return (*this)[m_size-1];  }
+   const T &back() const   {  return (*this)[m_size-1];  }
+
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   //! <b>Requires</b>: capacity() > 0.
+   //!
+   //! <b>Effects</b>: Constructs a new newest element forwarding args to T's
+   //!   constructor. If the buffer is full, the new element is move assigned
+   //!   to the oldest element, which becomes the newest one.
+   template<class ...Args>
+   void emplace_back(Args&&... args);
+   #else
+   #define BOOST_PP_LOCAL_MACRO(n)                                                     \
+   BOOST_MOVE_PP_TEMPLATE_DECL(n)                                                      \
+   void emplace_back(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM, _))                         \
+   {                                                                                   \
+      BOOST_ASSERT(m_capacity);                                                        \
+      if(m_size != m_capacity){                                                        \
+         BOOST_MOVE_PP_CONSTRUCT(n, T, m_buf + this->priv_pos(m_size));                \
+         ++m_size;                                                                     \
+      }                                                                                \
+      else{                                                                            \
+         /*Arguments might refer to the element that will be overwritten*/            \
+         storage_one_t tmp_storage;                                                    \
+         T *tmp = BOOST_MOVE_PP_CONSTRUCT(n, T, &tmp_storage);                         \
+         try{                                                                          \
+            this->priv_overwrite_front(::boost::move(*tmp));                           \
+         }                                                                             \
+         catch(...){                                                                   \
+            tmp->~T();                                                                 \
+            throw;                                                                     \
+         }                                                                             \
+         tmp->~T();                                                                    \
+      }                                                                                \
+   }                                                                                   \
+   //
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+   #endif
+
+   //! <b>Requires</b>: capacity() > 0.
+   //!
+   //! <b>Effects</b>: Inserts a copy of x as the newest element. If the
+   //!   buffer is full, x is copy assigned to the oldest element, which
+   //!   becomes the newest one.
+   void push_back(const T &x)
+   {
+      BOOST_ASSERT(m_capacity);
+      if(m_size != m_capacity){
+         ::new(static_cast<void*>(m_buf + this->priv_pos(m_size))) T(x);
+         ++m_size;
+      }
+      else{
+         this->priv_overwrite_front(x);
+      }
+   }
+
+   //! <b>Requires</b>: capacity() > 0.
+   //!
+   //! <b>Effects</b>: Moves x to the newest position. If the buffer is full,
+   //!   x is move assigned to the oldest element, which becomes the newest one.
+   void push_back(BOOST_RV_REF(T) x)
+   {
+      BOOST_ASSERT(m_capacity);
+      if(m_size != m_capacity){
+         ::new(static_cast<void*>(m_buf + this->priv_pos(m_size))) T(::boost::move(x));
+         ++m_size;
+      }
+      else{
+         this->priv_overwrite_front(::boost::move(x));
+      }
+   }
+
+   //! <b>Requires</b>: !empty().
+   //!
+   //! <b>Effects</b>: Removes the oldest element.
+   //!
+   //! <b>Returns</b>: The removed element, move constructed.
+   T pop_front()
+   {
+      BOOST_ASSERT(m_size);
+      T &f = m_buf[m_head];
+      T ret(::boost::move(f));
+      this->priv_destroy_moved(f);
+      m_head = (m_head + 1) & (m_capacity - 1);
+      --m_size;
+      return ::boost::move(ret);
+   }
+
+   //! <b>Requires</b>: n <= size().
+   //!
+   //! <b>Effects</b>: Moves the n oldest elements to out, oldest first,
+   //!   and removes them. Elements are transferred in at most two contiguous
+   //!   segments; if T is trivially copyable each segment is copied with
+   //!   std::copy (memmove when out is a pointer).
+   //!
+   //! <b>Returns</b>: out advanced past the last transferred element.
+   //!
+   //! <b>Throws</b>: If an assignment to out throws, the elements of the
+   //!   segments already transferred are removed and the rest stay in the
+   //!   buffer, some of them possibly moved from.
+   template<class OutIt>
+   OutIt move_out(size_type n, OutIt out)
+   {
+      BOOST_ASSERT(n <= m_size);
+      const size_type first_len = (m_capacity - m_head) < n ? (m_capacity - m_head) : n;
+      out = this->priv_move_out_segment(m_buf + m_head, m_buf + m_head + first_len, out);
+      //The first segment is destroyed: remove it before the second one can throw
+      this->priv_remove_front(first_len);
+      out = this->priv_move_out_segment(m_buf, m_buf + (n - first_len), out);
+      this->priv_remove_front(n - first_len);
+      return out;
+   }
+
+   //! <b>Effects</b>: Destroys all the elements. The capacity is not modified.
+   //!
+   //! <b>Throws</b>: Nothing.
+   void clear()
+   {
+      if(m_size){
+         const size_type first_len = (m_capacity - m_head) < m_size ? (m_capacity - m_head) : m_size;
+         ::boost::movelib::destroy(m_buf + m_head, m_buf + m_head + first_len);
+         ::boost::movelib::destroy(m_buf, m_buf + (m_size - first_len));
+      }
+      m_head = m_size = 0;
+   }
+
+   //! <b>Effects</b>: Exchanges the contents of *this and x.
+   //!
+   //! <b>Throws</b>: Nothing.
+   void swap(ring_buffer &x)
+   {
+      ring_buffer tmp(::boost::move(x));
+      x = ::boost::move(*this);
+      *this = ::boost::move(tmp);
+   }
+
+   /// @cond
+   private:
+
+   static size_type priv_round_capacity(size_type n)
+   {
+      size_type c = n ? 1u : 0u;
+      while(c < n){
+         c <<= 1;
+      }
+      return c;
+   }
+
+   size_type priv_pos(size_type i) const
+   {  return (m_head + i) & (m_capacity - 1);  }
+
+   void priv_destroy_moved(T &x)
+   {
+      if(!::boost::has_trivial_destructor_after_move<T>::value){
+         x.~T();
+      }
+   }
+
+   //Assigns x to the oldest element and makes it the newest one
+   template<class U>
+   void priv_overwrite_front(BOOST_FWD_REF(U) x)
+   {
+      m_buf[m_head] = ::boost::forward<U>(x);
+      m_head = (m_head + 1) & (m_capacity - 1);
+   }
+
+   void priv_remove_front(size_type n)
+   {
+      m_head = (m_head + n) & (m_capacity - 1);
+      m_size -= n;
+   }
+
+   template<class OutIt>
+   OutIt priv_move_out_segment(T *f, T *l, OutIt out)
+   {
+      out = ::boost::move_detail::ring_move_segment
+         (f, l, out, ::boost::move_detail::integral_constant<bool,
+            ::boost::has_trivial_copy<T>::value && ::boost::has_trivial_assign<T>::value>());
+      if(!::boost::has_trivial_destructor_after_move<T>::value){
+         ::boost::movelib::destroy(f, l);
+      }
+      return out;
+   }
+
+   T        *m_buf;
+   size_type m_capacity;
+   size_type m_head;
+   size_type m_size;
+   /// @endcond
+};
+
+//! A ring_buffer does not hold pointers to itself.
+template<class T>
+struct is_trivially_relocatable< ::boost::movelib::ring_buffer<T> >
+{
+   static const bool value = true;
+};
+
+}  //namespace movelib {
+
+template<class T>
+struct has_nothrow_move< ::boost::movelib::ring_buffer<T> >
+{
+   static const bool value = true;
+};
+
+//! A moved-from ring_buffer has no buffer, so its destructor is a no-op.
+template<class T>
+struct has_trivial_destructor_after_move< ::boost::movelib::ring_buffer<T> >
+{
+   static const bool value = true;
+};
+
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_RING_BUFFER_HPP
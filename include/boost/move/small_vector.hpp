@@ -0,0 +1,480 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_SMALL_VECTOR_HPP
+#define BOOST_MOVE_SMALL_VECTOR_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/relocate.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+#include <algorithm> //std::copy
+#include <cstddef>   //std::size_t
+#include <memory>    //std::uninitialized_copy
+#include <new>       //placement new
+
+namespace boost {
+namespace movelib {
+
+//! A vector that stores up to N elements inside the object itself and
+//! only allocates dynamic memory when the size exceeds N.
+//!
+//! Elements are relocated with uninitialized_relocate when the vector grows,
+//! so trivially relocatable types are moved with a single std::memcpy and
+//! destructors are skipped for types with
+//! <i>has_trivial_destructor_after_move</i>. Moving a heap-backed
+//! small_vector steals the buffer; moving an inline one relocates its
+//! elements. Works with movable-only (BOOST_MOVABLE_BUT_NOT_COPYABLE) types
+//! in C++03 compilers.
+//!
+//! Dynamic memory is obtained from ::operator new, so the alignment of T
+//! can't exceed the alignment guaranteed by ::operator new.
+template<class T, std::size_t N>
+class small_vector
+{
+   /// @cond
+   BOOST_COPYABLE_AND_MOVABLE(small_vector)
+   typedef typename ::boost::aligned_storage
+      <sizeof(T)*N, ::boost::alignment_of<T>::value>::type storage_t;
+   BOOST_STATIC_ASSERT(N > 0);
+   BOOST_STATIC_ASSERT(::boost::alignment_of<T>::value <= ::boost::alignment_of< ::boost::detail::max_align>::value);
+   /// @endcond
+
+   public:
+   typedef T                  value_type;
+   typedef T &                reference;
+   typedef const T &          const_reference;
+   typedef T *                pointer;
+   typedef const T *          const_pointer;
+   typedef T *                iterator;
+   typedef const T *          const_iterator;
+   typedef std::size_t        size_type;
+   typedef std::ptrdiff_t     difference_type;
+
+   //! Number of elements that can be stored without allocating memory.
+   static const size_type static_capacity = N;
+
+   //! <b>Effects</b>: Constructs an empty small_vector using the inline storage.
+   //!
+   //! <b>Throws</b>: Nothing.
+   small_vector()
+      : m_ptr(this->inline_ptr()), m_size(0), m_capacity(N)
+   {}
+
+   //! <b>Effects</b>: Constructs a small_vector with n value initialized elements.
+   explicit small_vector(size_type n)
+      : m_ptr(this->inline_ptr()), m_size(0), m_capacity(N)
+   {
+      try{
+         this->resize(n);
+      }
+      catch(...){
+         //The destructor won't run for a partially constructed object
+         this->clear();
+         this->priv_deallocate();
+         throw;
+      }
+   }
+
+   //! <b>Effects</b>: Copy constructs the elements of x.
+   small_vector(const small_vector &x)
+      : m_ptr(this->inline_ptr()), m_size(0), m_capacity(N)
+   {
+      try{
+         this->reserve(x.m_size);
+         std::uninitialized_copy(x.begin(), x.end(), m_ptr);
+      }
+      catch(...){
+         this->priv_deallocate();
+         throw;
+      }
+      m_size = x.m_size;
+   }
+
+   //! <b>Effects</b>: If x uses dynamic memory, steals its buffer.
+   //!   Otherwise relocates the elements of x to the inline storage of *this.
+   //!   x is left empty.
+   //!
+   //! <b>Throws</b>: Nothing unless has_nothrow_move&lt;T&gt; is false and
+   //!   a move constructor throws.
+   small_vector(BOOST_RV_REF(small_vector) x)
+      : m_ptr(this->inline_ptr()), m_size(0), m_capacity(N)
+   {  this->priv_steal(x);  }
+
+   //! <b>Effects</b>: Destroys the elements and releases the dynamic buffer, if any.
+   ~small_vector()
+   {
+      this->clear();
+      this->priv_deallocate();
+   }
+
+   //! <b>Effects</b>: Copy assigns the elements of x.
+   small_vector& operator=(BOOST_COPY_ASSIGN_REF(small_vector) x)
+   {
+      if(this != &x){
+         if(x.m_size > m_capacity){
+            this->clear();
+            this->reserve(x.m_size);
+         }
+         const size_type common = x.m_size < m_size ? x.m_size : m_size;
+         std::copy(x.begin(), x.begin() + common, m_ptr);
+         if(common < x.m_size){
+            std::uninitialized_copy(x.begin() + common, x.end(), m_ptr + common);
+         }
+         else{
+            ::boost::movelib::destroy(m_ptr + common, m_ptr + m_size);
+         }
+         m_size = x.m_size;
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Destroys the elements of *this and steals the buffer
+   //!   or relocates the elements of x. x is left empty.
+   small_vector& operator=(BOOST_RV_REF(small_vector) x)
+   {
+      if(this != &x){
+         this->clear();
+         this->priv_deallocate();
+         m_ptr = this->inline_ptr();
+         m_capacity = N;
+         this->priv_steal(x);
+      }
+      return *this;
+   }
+
+   iterator begin()              {  return m_ptr;  }
+   const_iterator begin() const  {  return m_ptr;  }
+   iterator end()                {  return m_ptr + m_size;  }
+   const_iterator end() const    {  return m_ptr + m_size;  }
+
+   T *data()                     {  return m_ptr;  }
+   const T *data() const         {  return m_ptr;  }
+
+   size_type size() const        {  return m_size;  }
+   size_type capacity() const    {  return m_capacity;  }
+   bool empty() const            {  return !m_size;  }
+
+   //! <b>Returns</b>: true if the elements are stored inside the object.
+   bool is_inline() const        {  return m_ptr == this->inline_ptr();  }
+
+   T &operator[](size_type i)
+   {  BOOST_ASSERT(i < m_size);  return m_ptr[i];  }
+
+   const T &operator[](size_type i) const
+   {  BOOST_ASSERT(i < m_size);  return m_ptr[i];  }
+
+   T &front()              {  BOOST_ASSERT(m_size);  return m_ptr[0];  }
+   const T &front() const  {  BOOST_ASSERT(m_size);  return m_ptr[0];  }
+   T &back()               {  BOOST_ASSERT(m_size);  return m_ptr[m_size-1];  }
+   const T &back() const   {  BOOST_ASSERT(m_size);  return m_ptr[m_size-1];  }
+
+   //! <b>Effects</b>: If n is greater than capacity(), allocates a buffer
+   //!   of n elements and relocates the elements to it.
+   //!
+   //! <b>Throws</b>: std::bad_alloc or if has_nothrow_move&lt;T&gt; is false and
+   //!   a move constructor throws. In that case *this is not modified.
+   void reserve(size_type n)
+   {
+      if(n > m_capacity){
+         T *new_buf = this->priv_allocate(n);
+         this->priv_relocate_to(new_buf, m_size, n, false);
+      }
+   }
+
+   //! <b>Effects</b>: Destroys all the elements. The capacity is not modified.
+   //!
+   //! <b>Throws</b>: Nothing.
+   void clear()
+   {
+      ::boost::movelib::destroy(m_ptr, m_ptr + m_size);
+      m_size = 0;
+   }
+
+   //! <b>Effects</b>: Value initializes or destroys elements at the end
+   //!   so that size() == n.
+   void resize(size_type n)
+   {
+      if(n < m_size){
+         ::boost::movelib::destroy(m_ptr + n, m_ptr + m_size);
+         m_size = n;
+      }
+      else{
+         this->reserve(n);
+         for(; m_size != n; ++m_size){
+            ::new(static_cast<void*>(m_ptr + m_size)) T();
+         }
+      }
+   }
+
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   //! <b>Effects</b>: Constructs a new element before pos forwarding args
+   //!   to T's constructor. args may refer to elements of *this.
+   //!
+   //! <b>Returns</b>: An iterator to the new element.
+   template<class ...Args>
+   iterator emplace(const_iterator pos, Args&&... args);
+
+   //! <b>Effects</b>: Constructs a new element at the end forwarding args
+   //!   to T's constructor. args may refer to elements of *this.
+   //!
+   //! <b>Returns</b>: A reference to the new element.
+   template<class ...Args>
+   T &emplace_back(Args&&... args);
+   #else
+   #define BOOST_PP_LOCAL_MACRO(n)                                                     \
+   BOOST_MOVE_PP_TEMPLATE_DECL(n)                                                      \
+   iterator emplace(const_iterator pos BOOST_PP_ENUM_TRAILING(n, BOOST_MOVE_PP_PARAM, _)) \
+   {                                                                                   \
+      BOOST_ASSERT(m_ptr <= pos && pos <= m_ptr + m_size);                             \
+      const size_type idx = static_cast<size_type>(pos - m_ptr);                       \
+      if(m_size == m_capacity){                                                        \
+         const size_type new_cap = this->priv_next_capacity();                         \
+         T *new_buf = this->priv_allocate(new_cap);                                    \
+         try{                                                                          \
+            BOOST_MOVE_PP_CONSTRUCT(n, T, new_buf + idx);                              \
+         }                                                                             \
+         catch(...){                                                                   \
+            ::operator delete(new_buf);                                                \
+            throw;                                                                     \
+         }                                                                             \
+         this->priv_relocate_to(new_buf, idx, new_cap, true);                          \
+      }                                                                                \
+      else if(idx == m_size){                                                          \
+         BOOST_MOVE_PP_CONSTRUCT(n, T, m_ptr + m_size);                                \
+         ++m_size;                                                                     \
+      }                                                                                \
+      else{                                                                            \
+         /*Arguments might refer to elements that will be shifted*/                    \
+         storage_one_t tmp_storage;                                                    \
+         T *tmp = BOOST_MOVE_PP_CONSTRUCT(n, T, &tmp_storage);                         \
+         try{                                                                          \
+            this->priv_insert_moved(idx, *tmp);                                        \
+         }                                                                             \
+         catch(...){                                                                   \
+            tmp->~T();                                                                 \
+            throw;                                                                     \
+         }                                                                             \
+         tmp->~T();                                                                    \
+      }                                                                                \
+      return m_ptr + idx;                                                              \
+   }                                                                                   \
+                                                                                       \
+   BOOST_MOVE_PP_TEMPLATE_DECL(n)                                                      \
+   T &emplace_back(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM, _))                           \
+   {                                                                                   \
+      if(m_size != m_capacity){                                                        \
+         T *const p = BOOST_MOVE_PP_CONSTRUCT(n, T, m_ptr + m_size);                   \
+         ++m_size;                                                                     \
+         return *p;                                                                    \
+      }                                                                                \
+      return *this->emplace(this->end()                                                \
+         BOOST_PP_ENUM_TRAILING(n, BOOST_MOVE_PP_PARAM_FORWARD, _));                   \
+   }                                                                                   \
+   //
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+   #endif
+
+   //! <b>Effects</b>: Inserts a copy of x at the end.
+   void push_back(const T &x)
+   {  this->emplace_back(x);  }
+
+   //! <b>Effects</b>: Moves x to the end.
+   void push_back(BOOST_RV_REF(T) x)
+   {  this->emplace_back(::boost::move(x));  }
+
+   //! <b>Effects</b>: Inserts a copy of x before pos.
+   iterator insert(const_iterator pos, const T &x)
+   {  return this->emplace(pos, x);  }
+
+   //! <b>Effects</b>: Moves x before pos.
+   iterator insert(const_iterator pos, BOOST_RV_REF(T) x)
+   {  return this->emplace(pos, ::boost::move(x));  }
+
+   //! <b>Effects</b>: Destroys the last element.
+   //!
+   //! <b>Throws</b>: Nothing.
+   void pop_back()
+   {
+      BOOST_ASSERT(m_size);
+      --m_size;
+      m_ptr[m_size].~T();
+   }
+
+   //! <b>Effects</b>: Erases the element at pos moving the following elements.
+   //!
+   //! <b>Returns</b>: An iterator to the element that followed the erased one.
+   iterator erase(const_iterator pos)
+   {
+      BOOST_ASSERT(m_ptr <= pos && pos < m_ptr + m_size);
+      return this->erase(pos, pos + 1);
+   }
+
+   //! <b>Effects</b>: Erases the elements in [first, last) moving the following elements.
+   //!
+   //! <b>Returns</b>: An iterator to the element that followed the erased ones.
+   iterator erase(const_iterator first, const_iterator last)
+   {
+      BOOST_ASSERT(m_ptr <= first && first <= last && last <= m_ptr + m_size);
+      T *const f = m_ptr + (first - m_ptr);
+      T *const l = m_ptr + (last - m_ptr);
+      if(f != l){
+         T *const new_end = ::boost::move(l, m_ptr + m_size, f);
+         ::boost::movelib::destroy(new_end, m_ptr + m_size);
+         m_size = static_cast<size_type>(new_end - m_ptr);
+      }
+      return f;
+   }
+
+   //! <b>Effects</b>: Exchanges the contents of *this and x. If both vectors
+   //!   use dynamic memory the buffers are swapped, otherwise the elements
+   //!   are relocated.
+   void swap(small_vector &x)
+   {
+      if(!this->is_inline() && !x.is_inline()){
+         T *const p = m_ptr;
+         m_ptr = x.m_ptr;
+         x.m_ptr = p;
+         const size_type s = m_size, c = m_capacity;
+         m_size = x.m_size;
+         m_capacity = x.m_capacity;
+         x.m_size = s;
+         x.m_capacity = c;
+      }
+      else{
+         small_vector tmp(::boost::move(x));
+         x = ::boost::move(*this);
+         *this = ::boost::move(tmp);
+      }
+   }
+
+   /// @cond
+   private:
+   typedef typename ::boost::aligned_storage
+      <sizeof(T), ::boost::alignment_of<T>::value>::type storage_one_t;
+
+   T *inline_ptr()
+   {  return static_cast<T*>(static_cast<void*>(&m_storage));  }
+
+   const T *inline_ptr() const
+   {  return static_cast<const T*>(static_cast<const void*>(&m_storage));  }
+
+   static T *priv_allocate(size_type n)
+   {  return static_cast<T*>(::operator new(n*sizeof(T)));  }
+
+   void priv_deallocate()
+   {
+      if(!this->is_inline()){
+         ::operator delete(m_ptr);
+      }
+   }
+
+   size_type priv_next_capacity() const
+   {  return m_capacity*2;  }
+
+   //Moves or relocates the contents of x to *this, that must be empty and inline
+   void priv_steal(small_vector &x)
+   {
+      BOOST_ASSERT(this->is_inline() && !m_size);
+      if(x.is_inline()){
+         ::boost::movelib::uninitialized_relocate(x.m_ptr, x.m_ptr + x.m_size, m_ptr);
+         m_size = x.m_size;
+      }
+      else{
+         m_ptr = x.m_ptr;
+         m_size = x.m_size;
+         m_capacity = x.m_capacity;
+         x.m_ptr = x.inline_ptr();
+         x.m_capacity = N;
+      }
+      x.m_size = 0;
+   }
+
+   //Relocates the elements to new_buf. If hole is true, position idx of
+   //new_buf has been constructed by the caller and is skipped. If an
+   //exception is thrown the hole is destroyed, new_buf is deallocated
+   //and *this is not modified.
+   void priv_relocate_to(T *new_buf, size_type idx, size_type new_cap, bool hole)
+   {
+      if(::boost::has_nothrow_move<T>::value || ::boost::movelib::is_trivially_relocatable<T>::value){
+         ::boost::movelib::uninitialized_relocate(m_ptr, m_ptr + idx, new_buf);
+         ::boost::movelib::uninitialized_relocate(m_ptr + idx, m_ptr + m_size, new_buf + idx + 1);
+      }
+      else{
+         size_type done = 0;
+         try{
+            for(; done != m_size; ++done){
+               ::new(static_cast<void*>(new_buf + done + (done >= idx))) T(::boost::move(m_ptr[done]));
+            }
+         }
+         catch(...){
+            for(size_type i = 0; i != done; ++i){
+               new_buf[i + (i >= idx)].~T();
+            }
+            if(hole){
+               new_buf[idx].~T();
+            }
+            ::operator delete(new_buf);
+            throw;
+         }
+         ::boost::movelib::destroy(m_ptr, m_ptr + m_size);
+      }
+      this->priv_deallocate();
+      m_ptr = new_buf;
+      m_size += hole;
+      m_capacity = new_cap;
+   }
+
+   //Inserts tmp at idx shifting the following elements. Requires size() < capacity()
+   void priv_insert_moved(size_type idx, T &tmp)
+   {
+      BOOST_ASSERT(m_size < m_capacity && idx < m_size);
+      T *const old_end = m_ptr + m_size;
+      ::new(static_cast<void*>(old_end)) T(::boost::move(old_end[-1]));
+      ++m_size;
+      ::boost::move_backward(m_ptr + idx, old_end - 1, old_end);
+      m_ptr[idx] = ::boost::move(tmp);
+   }
+
+   T        *m_ptr;
+   size_type m_size;
+   size_type m_capacity;
+   storage_t m_storage;
+   /// @endcond
+};
+
+}  //namespace movelib {
+
+//! A moved-from small_vector is empty and uses its inline storage,
+//! so its destructor is a no-op.
+template<class T, std::size_t N>
+struct has_trivial_destructor_after_move< ::boost::movelib::small_vector<T, N> >
+{
+   static const bool value = true;
+};
+
+template<class T, std::size_t N>
+struct has_nothrow_move< ::boost::movelib::small_vector<T, N> >
+{
+   static const bool value = ::boost::has_nothrow_move<T>::value ||
+                             ::boost::movelib::is_trivially_relocatable<T>::value;
+};
+
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_SMALL_VECTOR_HPP
@@ -0,0 +1,266 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_SPSC_QUEUE_HPP
+#define BOOST_MOVE_SPSC_QUEUE_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/relocate.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
+#include <boost/move/detail/atomic.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>   //std::size_t
+#include <new>       //placement new
+
+namespace boost {
+namespace movelib {
+
+//! A bounded wait-free queue for exactly one producer thread and one
+//! consumer thread. Elements are moved in and out of a ring of slots
+//! whose capacity is rounded up to a power of two, so movable-only
+//! (BOOST_MOVABLE_BUT_NOT_COPYABLE) types can be passed between threads.
+//!
+//! The producer and consumer indexes live in different cache lines
+//! (of BOOST_MOVE_CACHE_LINE_SIZE bytes) and each side caches the last
+//! seen value of the other side's index, so the shared cache lines are
+//! only touched when the queue looks full or empty.
+//!
+//! Only the producer thread may call try_push, try_emplace and push_n;
+//! only the consumer thread may call try_pop and pop_n.
+template<class T>
+class spsc_queue
+{
+   /// @cond
+   spsc_queue(const spsc_queue &);
+   spsc_queue &operator=(const spsc_queue &);
+
+   typedef ::boost::move_detail::atomic<std::size_t> atomic_index;
+   BOOST_STATIC_ASSERT(::boost::alignment_of<T>::value <= ::boost::alignment_of< ::boost::detail::max_align>::value);
+   /// @endcond
+
+   public:
+   typedef T            value_type;
+   typedef std::size_t  size_type;
+
+   //! <b>Effects</b>: Constructs an empty queue that can hold at least n elements.
+   //!   The capacity is n rounded up to a power of two.
+   explicit spsc_queue(size_type n)
+      : m_buf(0), m_mask(priv_round_capacity(n) - 1)
+      , m_tail(0), m_head_cache(0), m_head(0), m_tail_cache(0)
+   {
+      m_buf = static_cast<T*>(::operator new((m_mask + 1)*sizeof(T)));
+   }
+
+   //! <b>Requires</b>: No thread is accessing the queue.
+   //!
+   //! <b>Effects</b>: Destroys the elements still in the queue.
+   ~spsc_queue()
+   {
+      const size_type tail = m_tail.load(::boost::move_detail::memory_order_acquire);
+      for(size_type head = m_head.load(::boost::move_detail::memory_order_relaxed); head != tail; ++head){
+         m_buf[head & m_mask].~T();
+      }
+      ::operator delete(m_buf);
+   }
+
+   //! <b>Returns</b>: The maximum number of elements in the queue.
+   size_type capacity() const
+   {  return m_mask + 1;  }
+
+   //! <b>Returns</b>: true if the queue was empty when checked. The result
+   //!   is exact only if called from the consumer thread, where the queue
+   //!   can't become empty concurrently.
+   bool empty() const
+   {
+      return m_head.load(::boost::move_detail::memory_order_relaxed) ==
+             m_tail.load(::boost::move_detail::memory_order_acquire);
+   }
+
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   //! <b>Effects</b>: If the queue is not full, constructs a new element at the
+   //!   back forwarding args to T's constructor. Producer thread only.
+   //!
+   //! <b>Returns</b>: false if the queue was full.
+   template<class ...Args>
+   bool try_emplace(Args&&... args);
+   #else
+   #define BOOST_PP_LOCAL_MACRO(n)                                                     \
+   BOOST_MOVE_PP_TEMPLATE_DECL(n)                                                      \
+   bool try_emplace(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM, _))                          \
+   {                                                                                   \
+      const size_type tail = m_tail.load(::boost::move_detail::memory_order_relaxed);  \
+      if(!this->priv_free(tail, 1)){                                                   \
+         return false;                                                                 \
+      }                                                                                \
+      BOOST_MOVE_PP_CONSTRUCT(n, T, m_buf + (tail & m_mask));                          \
+      m_tail.store(tail + 1, ::boost::move_detail::memory_order_release);              \
+      return true;                                                                     \
+   }                                                                                   \
+   //
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+   #endif
+
+   //! <b>Effects</b>: If the queue is not full, moves x to the back.
+   //!   Producer thread only.
+   //!
+   //! <b>Returns</b>: false if the queue was full. In that case x is not modified.
+   bool try_push(BOOST_RV_REF(T) x)
+   {  return this->try_emplace(::boost::move(x));  }
+
+   //! <b>Effects</b>: If the queue is not full, pushes a copy of x.
+   //!   Producer thread only.
+   //!
+   //! <b>Returns</b>: false if the queue was full.
+   bool try_push(const T &x)
+   {  return this->try_emplace(x);  }
+
+   //! <b>Effects</b>: If the queue is not empty, move assigns the front
+   //!   element to x and removes it. Consumer thread only.
+   //!
+   //! <b>Returns</b>: false if the queue was empty.
+   bool try_pop(T &x)
+   {
+      const size_type head = m_head.load(::boost::move_detail::memory_order_relaxed);
+      if(!this->priv_available(head, 1)){
+         return false;
+      }
+      T &elem = m_buf[head & m_mask];
+      x = ::boost::move(elem);
+      this->priv_destroy_moved(elem);
+      m_head.store(head + 1, ::boost::move_detail::memory_order_release);
+      return true;
+   }
+
+   //! <b>Effects</b>: Move constructs up to n elements from the range starting
+   //!   at first at the back of the queue and publishes them at once.
+   //!   Producer thread only.
+   //!
+   //! <b>Returns</b>: The number of elements pushed.
+   //!
+   //! <b>Throws</b>: If a move constructor throws, the elements constructed by
+   //!   this call are destroyed and none is published.
+   template<class I>
+   size_type push_n(I first, size_type n)
+   {
+      const size_type tail = m_tail.load(::boost::move_detail::memory_order_relaxed);
+      n = this->priv_free(tail, n);
+      size_type i = 0;
+      try{
+         for(; i != n; ++i, ++first){
+            ::new(static_cast<void*>(m_buf + ((tail + i) & m_mask))) T(::boost::move(*first));
+         }
+      }
+      catch(...){
+         while(i--){
+            m_buf[(tail + i) & m_mask].~T();
+         }
+         throw;
+      }
+      m_tail.store(tail + n, ::boost::move_detail::memory_order_release);
+      return n;
+   }
+
+   //! <b>Effects</b>: Move assigns up to n front elements to the range
+   //!   starting at out and removes them. Consumer thread only.
+   //!
+   //! <b>Returns</b>: The number of elements popped.
+   //!
+   //! <b>Throws</b>: If a move assignment throws, the elements assigned
+   //!   before it are removed and the rest stay in the queue.
+   template<class O>
+   size_type pop_n(O out, size_type n)
+   {
+      const size_type head = m_head.load(::boost::move_detail::memory_order_relaxed);
+      n = this->priv_available(head, n);
+      size_type i = 0;
+      try{
+         for(; i != n; ++i, ++out){
+            T &elem = m_buf[(head + i) & m_mask];
+            *out = ::boost::move(elem);
+            this->priv_destroy_moved(elem);
+         }
+      }
+      catch(...){
+         //Remove the elements already handed out and destroyed
+         m_head.store(head + i, ::boost::move_detail::memory_order_release);
+         throw;
+      }
+      m_head.store(head + n, ::boost::move_detail::memory_order_release);
+      return n;
+   }
+
+   /// @cond
+   private:
+
+   static size_type priv_round_capacity(size_type n)
+   {
+      size_type c = 1u;
+      while(c < n){
+         c <<= 1;
+      }
+      return c;
+   }
+
+   //Returns min(n, free slots). Producer only
+   size_type priv_free(size_type tail, size_type n)
+   {
+      size_type free_slots = m_mask + 1 - (tail - m_head_cache);
+      if(free_slots < n){
+         m_head_cache = m_head.load(::boost::move_detail::memory_order_acquire);
+         free_slots = m_mask + 1 - (tail - m_head_cache);
+      }
+      return free_slots < n ? free_slots : n;
+   }
+
+   //Returns min(n, available elements). Consumer only
+   size_type priv_available(size_type head, size_type n)
+   {
+      size_type available = m_tail_cache - head;
+      if(available < n){
+         m_tail_cache = m_tail.load(::boost::move_detail::memory_order_acquire);
+         available = m_tail_cache - head;
+      }
+      return available < n ? available : n;
+   }
+
+   static void priv_destroy_moved(T &x)
+   {
+      if(!::boost::has_trivial_destructor_after_move<T>::value){
+         x.~T();
+      }
+   }
+
+   //Read-only after construction
+   char pad0_[BOOST_MOVE_CACHE_LINE_SIZE];
+   T          *m_buf;
+   size_type   m_mask;
+   char pad1_[BOOST_MOVE_CACHE_LINE_SIZE - sizeof(T*) - sizeof(size_type)];
+   //Written by the producer
+   atomic_index m_tail;
+   size_type    m_head_cache;
+   char pad2_[BOOST_MOVE_CACHE_LINE_SIZE - sizeof(atomic_index) - sizeof(size_type)];
+   //Written by the consumer
+   atomic_index m_head;
+   size_type    m_tail_cache;
+   char pad3_[BOOST_MOVE_CACHE_LINE_SIZE - sizeof(atomic_index) - sizeof(size_type)];
+   /// @endcond
+};
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_SPSC_QUEUE_HPP
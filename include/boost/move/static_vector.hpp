@@ -0,0 +1,412 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_STATIC_VECTOR_HPP
+#define BOOST_MOVE_STATIC_VECTOR_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/relocate.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+#include <algorithm> //std::copy
+#include <cstddef>   //std::size_t
+#include <memory>    //std::uninitialized_copy
+#include <stdexcept> //std::length_error
+#include <new>       //placement new
+
+namespace boost {
+namespace movelib {
+
+//! Overflow policy of static_vector: throws std::length_error
+//! when an insertion exceeds the capacity.
+struct throw_on_overflow
+{
+   static bool on_overflow()
+   {  throw std::length_error("static_vector capacity exceeded");  }
+};
+
+//! Overflow policy of static_vector: asserts when an insertion
+//! exceeds the capacity. If assertions are disabled the insertion
+//! is ignored and reported as failed.
+struct assert_on_overflow
+{
+   static bool on_overflow()
+   {
+      BOOST_ASSERT(!"static_vector capacity exceeded");
+      return false;
+   }
+};
+
+//! Overflow policy of static_vector: insertions that exceed the
+//! capacity are ignored and reported as failed.
+struct return_false_on_overflow
+{
+   static bool on_overflow()
+   {  return false;  }
+};
+
+//! A vector with a fixed capacity of N elements stored inside the object.
+//! static_vector never allocates dynamic memory.
+//!
+//! Insertions that would exceed the capacity call
+//! <i>OverflowPolicy::on_overflow()</i>: throw_on_overflow (the default)
+//! throws std::length_error, assert_on_overflow asserts and
+//! return_false_on_overflow makes push_back and emplace_back return false
+//! (and insert/emplace return a null iterator) without modifying the vector.
+//!
+//! Moving a static_vector relocates its elements, so a static_vector of
+//! trivially relocatable elements is itself trivially relocatable and is
+//! moved with std::memcpy. static_vector can be used as the target of
+//! back_move_inserter.
+template<class T, std::size_t N, class OverflowPolicy = throw_on_overflow>
+class static_vector
+{
+   /// @cond
+   BOOST_COPYABLE_AND_MOVABLE(static_vector)
+   typedef typename ::boost::aligned_storage
+      <sizeof(T)*N, ::boost::alignment_of<T>::value>::type storage_t;
+   typedef typename ::boost::aligned_storage
+      <sizeof(T), ::boost::alignment_of<T>::value>::type storage_one_t;
+   BOOST_STATIC_ASSERT(N > 0);
+   /// @endcond
+
+   public:
+   typedef T                  value_type;
+   typedef T &                reference;
+   typedef const T &          const_reference;
+   typedef T *                pointer;
+   typedef const T *          const_pointer;
+   typedef T *                iterator;
+   typedef const T *          const_iterator;
+   typedef std::size_t        size_type;
+   typedef std::ptrdiff_t     difference_type;
+   typedef OverflowPolicy     overflow_policy;
+
+   //! Maximum number of elements.
+   static const size_type static_capacity = N;
+
+   //! <b>Effects</b>: Constructs an empty static_vector.
+   //!
+   //! <b>Throws</b>: Nothing.
+   static_vector()
+      : m_size(0)
+   {}
+
+   //! <b>Effects</b>: Constructs a static_vector with n value initialized elements.
+   //!   If n > N, the overflow policy is applied.
+   explicit static_vector(size_type n)
+      : m_size(0)
+   {
+      try{
+         this->resize(n);
+      }
+      catch(...){
+         //The destructor won't run for a partially constructed object
+         this->clear();
+         throw;
+      }
+   }
+
+   //! <b>Effects</b>: Copy constructs the elements of x.
+   static_vector(const static_vector &x)
+      : m_size(0)
+   {
+      std::uninitialized_copy(x.begin(), x.end(), this->data());
+      m_size = x.m_size;
+   }
+
+   //! <b>Effects</b>: Relocates the elements of x to *this
+   //!   (using std::memcpy if T is trivially relocatable). x is left empty.
+   //!
+   //! <b>Throws</b>: Nothing unless has_nothrow_move&lt;T&gt; is false and
+   //!   a move constructor throws.
+   static_vector(BOOST_RV_REF(static_vector) x)
+      : m_size(0)
+   {
+      ::boost::movelib::uninitialized_relocate(x.data(), x.data() + x.m_size, this->data());
+      m_size = x.m_size;
+      x.m_size = 0;
+   }
+
+   //! <b>Effects</b>: Destroys the elements.
+   ~static_vector()
+   {  this->clear();  }
+
+   //! <b>Effects</b>: Copy assigns the elements of x.
+   static_vector& operator=(BOOST_COPY_ASSIGN_REF(static_vector) x)
+   {
+      if(this != &x){
+         T *const p = this->data();
+         const size_type common = x.m_size < m_size ? x.m_size : m_size;
+         std::copy(x.begin(), x.begin() + common, p);
+         if(common < x.m_size){
+            std::uninitialized_copy(x.begin() + common, x.end(), p + common);
+         }
+         else{
+            ::boost::movelib::destroy(p + common, p + m_size);
+         }
+         m_size = x.m_size;
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Destroys the elements of *this and relocates
+   //!   the elements of x. x is left empty.
+   static_vector& operator=(BOOST_RV_REF(static_vector) x)
+   {
+      if(this != &x){
+         this->clear();
+         ::boost::movelib::uninitialized_relocate(x.data(), x.data() + x.m_size, this->data());
+         m_size = x.m_size;
+         x.m_size = 0;
+      }
+      return *this;
+   }
+
+   iterator begin()              {  return this->data();  }
+   const_iterator begin() const  {  return this->data();  }
+   iterator end()                {  return this->data() + m_size;  }
+   const_iterator end() const    {  return this->data() + m_size;  }
+
+   T *data()
+   {  return static_cast<T*>(static_cast<void*>(&m_storage));  }
+
+   const T *data() const
+   {  return static_cast<const T*>(static_cast<const void*>(&m_storage));  }
+
+   size_type size() const              {  return m_size;  }
+   static size_type capacity()         {  return N;  }
+   static size_type max_size()         {  return N;  }
+   bool empty() const                  {  return !m_size;  }
+   bool full() const                   {  return m_size == N;  }
+
+   T &operator[](size_type i)
+   {  BOOST_ASSERT(i < m_size);  return this->data()[i];  }
+
+   const T &operator[](size_type i) const
+   {  BOOST_ASSERT(i < m_size);  return this->data()[i];  }
+
+   T &front()              {  BOOST_ASSERT(m_size);  return this->data()[0];  }
+   const T &front() const  {  BOOST_ASSERT(m_size);  return this->data()[0];  }
+   T &back()               {  BOOST_ASSERT(m_size);  return this->data()[m_size-1];  }
+   const T &back() const   {  BOOST_ASSERT(m_size);  return this->data()[m_size-1];  }
+
+   //! <b>Effects</b>: Destroys all the elements.
+   //!
+   //! <b>Throws</b>: Nothing.
+   void clear()
+   {
+      ::boost::movelib::destroy(this->data(), this->data() + m_size);
+      m_size = 0;
+   }
+
+   //! <b>Effects</b>: Value initializes or destroys elements at the end
+   //!   so that size() == n. If n > N, the overflow policy is applied and
+   //!   the vector is not modified.
+   //!
+   //! <b>Returns</b>: false if n > N and the overflow policy does not throw.
+   bool resize(size_type n)
+   {
+      T *const p = this->data();
+      if(n < m_size){
+         ::boost::movelib::destroy(p + n, p + m_size);
+         m_size = n;
+      }
+      else if(n > N){
+         return OverflowPolicy::on_overflow();
+      }
+      else{
+         for(; m_size != n; ++m_size){
+            ::new(static_cast<void*>(p + m_size)) T();
+         }
+      }
+      return true;
+   }
+
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   //! <b>Effects</b>: Constructs a new element before pos forwarding args
+   //!   to T's constructor. The following elements are shifted with
+   //!   move_backward. If the vector is full, the overflow policy is applied.
+   //!
+   //! <b>Returns</b>: An iterator to the new element or a null iterator if
+   //!   the vector was full and the overflow policy does not throw.
+   template<class ...Args>
+   iterator emplace(const_iterator pos, Args&&... args);
+
+   //! <b>Effects</b>: Constructs a new element at the end forwarding args
+   //!   to T's constructor. If the vector is full, the overflow policy is applied.
+   //!
+   //! <b>Returns</b>: false if the vector was full and the overflow policy
+   //!   does not throw.
+   template<class ...Args>
+   bool emplace_back(Args&&... args);
+   #else
+   #define BOOST_PP_LOCAL_MACRO(n)                                                     \
+   BOOST_MOVE_PP_TEMPLATE_DECL(n)                                                      \
+   iterator emplace(const_iterator pos BOOST_PP_ENUM_TRAILING(n, BOOST_MOVE_PP_PARAM, _)) \
+   {                                                                                   \
+      T *const p = this->data();                                                       \
+      BOOST_ASSERT(p <= pos && pos <= p + m_size);                                     \
+      const size_type idx = static_cast<size_type>(pos - p);                           \
+      if(m_size == N){                                                                 \
+         return OverflowPolicy::on_overflow() ? p + idx : iterator();                  \
+      }                                                                                \
+      else if(idx == m_size){                                                          \
+         BOOST_MOVE_PP_CONSTRUCT(n, T, p + m_size);                                    \
+         ++m_size;                                                                     \
+      }                                                                                \
+      else{                                                                            \
+         /*Arguments might refer to elements that will be shifted*/                    \
+         storage_one_t tmp_storage;                                                    \
+         T *tmp = BOOST_MOVE_PP_CONSTRUCT(n, T, &tmp_storage);                         \
+         try{                                                                          \
+            this->priv_insert_moved(idx, *tmp);                                        \
+         }                                                                             \
+         catch(...){                                                                   \
+            tmp->~T();                                                                 \
+            throw;                                                                     \
+         }                                                                             \
+         tmp->~T();                                                                    \
+      }                                                                                \
+      return p + idx;                                                                  \
+   }                                                                                   \
+                                                                                       \
+   BOOST_MOVE_PP_TEMPLATE_DECL(n)                                                      \
+   bool emplace_back(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM, _))                         \
+   {                                                                                   \
+      if(m_size == N){                                                                 \
+         return OverflowPolicy::on_overflow();                                         \
+      }                                                                                \
+      BOOST_MOVE_PP_CONSTRUCT(n, T, this->data() + m_size);                            \
+      ++m_size;                                                                        \
+      return true;                                                                     \
+   }                                                                                   \
+   //
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+   #endif
+
+   //! <b>Effects</b>: Inserts a copy of x at the end.
+   //!
+   //! <b>Returns</b>: false if the vector was full and the overflow policy
+   //!   does not throw.
+   bool push_back(const T &x)
+   {  return this->emplace_back(x);  }
+
+   //! <b>Effects</b>: Moves x to the end.
+   //!
+   //! <b>Returns</b>: false if the vector was full and the overflow policy
+   //!   does not throw.
+   bool push_back(BOOST_RV_REF(T) x)
+   {  return this->emplace_back(::boost::move(x));  }
+
+   //! <b>Effects</b>: Inserts a copy of x before pos.
+   iterator insert(const_iterator pos, const T &x)
+   {  return this->emplace(pos, x);  }
+
+   //! <b>Effects</b>: Moves x before pos.
+   iterator insert(const_iterator pos, BOOST_RV_REF(T) x)
+   {  return this->emplace(pos, ::boost::move(x));  }
+
+   //! <b>Effects</b>: Destroys the last element.
+   //!
+   //! <b>Throws</b>: Nothing.
+   void pop_back()
+   {
+      BOOST_ASSERT(m_size);
+      --m_size;
+      this->data()[m_size].~T();
+   }
+
+   //! <b>Effects</b>: Erases the element at pos moving the following elements.
+   //!
+   //! <b>Returns</b>: An iterator to the element that followed the erased one.
+   iterator erase(const_iterator pos)
+   {
+      BOOST_ASSERT(this->data() <= pos && pos < this->data() + m_size);
+      return this->erase(pos, pos + 1);
+   }
+
+   //! <b>Effects</b>: Erases the elements in [first, last) moving the following elements.
+   //!
+   //! <b>Returns</b>: An iterator to the element that followed the erased ones.
+   iterator erase(const_iterator first, const_iterator last)
+   {
+      T *const p = this->data();
+      BOOST_ASSERT(p <= first && first <= last && last <= p + m_size);
+      T *const f = p + (first - p);
+      T *const l = p + (last - p);
+      if(f != l){
+         T *const new_end = ::boost::move(l, p + m_size, f);
+         ::boost::movelib::destroy(new_end, p + m_size);
+         m_size = static_cast<size_type>(new_end - p);
+      }
+      return f;
+   }
+
+   //! <b>Effects</b>: Exchanges the contents of *this and x relocating the elements.
+   void swap(static_vector &x)
+   {
+      static_vector tmp(::boost::move(x));
+      x = ::boost::move(*this);
+      *this = ::boost::move(tmp);
+   }
+
+   /// @cond
+   private:
+
+   //Inserts tmp at idx shifting the following elements. Requires size() < N
+   void priv_insert_moved(size_type idx, T &tmp)
+   {
+      BOOST_ASSERT(m_size < N && idx < m_size);
+      T *const old_end = this->data() + m_size;
+      ::new(static_cast<void*>(old_end)) T(::boost::move(old_end[-1]));
+      ++m_size;
+      ::boost::move_backward(this->data() + idx, old_end - 1, old_end);
+      this->data()[idx] = ::boost::move(tmp);
+   }
+
+   storage_t m_storage;
+   size_type m_size;
+   /// @endcond
+};
+
+//! A static_vector of trivially relocatable elements can be relocated
+//! with std::memcpy as it does not hold pointers to itself.
+template<class T, std::size_t N, class OverflowPolicy>
+struct is_trivially_relocatable< ::boost::movelib::static_vector<T, N, OverflowPolicy> >
+   : ::boost::movelib::is_trivially_relocatable<T>
+{};
+
+}  //namespace movelib {
+
+//! A moved-from static_vector is empty, so its destructor is a no-op.
+template<class T, std::size_t N, class OverflowPolicy>
+struct has_trivial_destructor_after_move< ::boost::movelib::static_vector<T, N, OverflowPolicy> >
+{
+   static const bool value = true;
+};
+
+template<class T, std::size_t N, class OverflowPolicy>
+struct has_nothrow_move< ::boost::movelib::static_vector<T, N, OverflowPolicy> >
+{
+   static const bool value = ::boost::has_nothrow_move<T>::value ||
+                             ::boost::movelib::is_trivially_relocatable<T>::value;
+};
+
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_STATIC_VECTOR_HPP
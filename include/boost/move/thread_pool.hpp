@@ -0,0 +1,351 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_THREAD_POOL_HPP
+#define BOOST_MOVE_THREAD_POOL_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/future.hpp>
+#include <boost/move/wait_strategy.hpp>
+#include <boost/move/detail/atomic.hpp>
+#include <boost/move/detail/sync.hpp>
+#include <boost/move/detail/work_stealing_deque.hpp>
+#include <boost/type_traits/decay.hpp>
+#include <boost/type_traits/is_void.hpp>
+#include <boost/utility/result_of.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>   //std::size_t
+
+namespace boost {
+
+/// @cond
+
+namespace move_detail {
+
+class pool_task_base
+{
+   public:
+   //Runs the task and releases the reference held by the pool
+   virtual void run() = 0;
+
+   pool_task_base *m_next;
+
+   protected:
+   pool_task_base()
+      : m_next(0)
+   {}
+
+   ~pool_task_base()
+   {}
+};
+
+template<class R>
+struct pool_task_invoker
+{
+   template<class F>
+   static void invoke(F &f, future_state<R> &st)
+   {
+      R r(f());
+      st.set_value(::boost::move(r));
+   }
+};
+
+template<>
+struct pool_task_invoker<void>
+{
+   template<class F>
+   static void invoke(F &f, future_state<void> &st)
+   {
+      f();
+      st.set_value(future_void());
+   }
+};
+
+//The callable and the shared state of its future live in a single allocation.
+//The state starts with two references: the future's and the pool's.
+template<class F, class R>
+class pool_task
+   : public future_state<R>, public pool_task_base
+{
+   public:
+   template<class G>
+   explicit pool_task(BOOST_FWD_REF(G) g)
+      : future_state<R>(2), pool_task_base(), m_f(::boost::forward<G>(g))
+   {}
+
+   virtual void run()
+   {
+      ::boost::movelib::exception_ptr e;
+      try{
+         pool_task_invoker<R>::invoke(m_f, *this);
+      }
+      catch(...){
+         e = ::boost::movelib::current_exception();
+      }
+      if(e){
+         this->take_exception(e);
+      }
+      this->release();
+   }
+
+   private:
+   F m_f;
+};
+
+template<class F>
+struct pool_task_result
+{
+   typedef typename ::boost::decay<F>::type           callable_type;
+   typedef typename ::boost::result_of<callable_type()>::type  type;
+};
+
+}  //namespace move_detail {
+
+/// @endcond
+
+namespace movelib {
+
+//! A fixed-size pool of worker threads that executes movable-only tasks.
+//!
+//! Each worker owns a Chase-Lev work-stealing deque: tasks submitted from
+//! a worker thread are pushed to that worker's deque and executed in LIFO
+//! order by its owner, while idle workers steal the oldest tasks from the
+//! top of other workers' deques. Tasks submitted from other threads are
+//! placed in a shared injection list. Idle workers sleep in a blocking_wait.
+//!
+//! A task is any callable taking no arguments, including movable-only
+//! ones (BOOST_MOVABLE_BUT_NOT_COPYABLE). The callable is moved into the
+//! same allocation that holds the shared state of the returned future,
+//! so submit() performs a single memory allocation.
+//!
+//! The destructor waits until all submitted tasks have been executed.
+class thread_pool
+{
+   /// @cond
+   thread_pool(const thread_pool &);
+   thread_pool &operator=(const thread_pool &);
+
+   typedef ::boost::move_detail::pool_task_base task_base;
+
+   struct worker
+   {
+      worker()
+         : m_pool(0), m_index(0), m_thread(0), m_deque()
+      {}
+
+      thread_pool                                              *m_pool;
+      std::size_t                                               m_index;
+      ::boost::move_detail::thread                             *m_thread;
+      ::boost::move_detail::work_stealing_deque<task_base>      m_deque;
+   };
+   /// @endcond
+
+   public:
+   typedef std::size_t size_type;
+
+   //! <b>Requires</b>: n > 0.
+   //!
+   //! <b>Effects</b>: Starts n worker threads.
+   explicit thread_pool(size_type n)
+      : m_workers(new worker[n]), m_size(n), m_wait()
+      , m_inject_mtx(), m_inject_head(0), m_inject_tail(0), m_injected(0), m_stop(false)
+   {
+      BOOST_ASSERT(n > 0);
+      for(size_type i = 0; i != n; ++i){
+         m_workers[i].m_pool  = this;
+         m_workers[i].m_index = i;
+      }
+      try{
+         for(size_type i = 0; i != n; ++i){
+            m_workers[i].m_thread = new ::boost::move_detail::thread(&thread_pool::priv_worker_main, &m_workers[i]);
+         }
+      }
+      catch(...){
+         this->priv_shutdown();
+         throw;
+      }
+   }
+
+   //! <b>Effects</b>: Waits until every submitted task, including the ones
+   //!   submitted by running tasks, has been executed and joins the workers.
+   ~thread_pool()
+   {  this->priv_shutdown();  }
+
+   //! <b>Returns</b>: The number of worker threads.
+   size_type size() const
+   {  return m_size;  }
+
+   #if defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   template<class F>
+   future<typename ::boost::move_detail::pool_task_result<F>::type>
+      submit(const F &f)
+   {
+      return this->template priv_submit
+         <typename ::boost::move_detail::pool_task_result<F>::callable_type>(f);
+   }
+
+   template<class F>
+   future<typename ::boost::move_detail::pool_task_result<F>::type>
+      submit(BOOST_RV_REF(F) f)
+   {  return this->template priv_submit<F>(f);  }
+   #else
+   //! <b>Effects</b>: Moves (or copies, if f is an lvalue) f into a new task
+   //!   and schedules it. If called from a worker of this pool, the task is
+   //!   pushed to the worker's own deque.
+   //!
+   //! <b>Returns</b>: A future that will hold the result of f() or the
+   //!   exception it threw.
+   //!
+   //! <b>Throws</b>: std::bad_alloc or any exception thrown by the
+   //!   constructor of the callable.
+   template<class F>
+   future<typename ::boost::move_detail::pool_task_result<F>::type>
+      submit(F &&f)
+   {
+      return this->template priv_submit
+         <typename ::boost::move_detail::pool_task_result<F>::callable_type>(::boost::forward<F>(f));
+   }
+   #endif
+
+   /// @cond
+   private:
+
+   template<class Fn, class G>
+   future<typename ::boost::move_detail::pool_task_result<Fn>::type>
+      priv_submit(BOOST_FWD_REF(G) g)
+   {
+      typedef typename ::boost::move_detail::pool_task_result<Fn>::type   result_t;
+      typedef ::boost::move_detail::pool_task<Fn, result_t>               task_t;
+      task_t *const t = new task_t(::boost::forward<G>(g));
+      future<result_t> ret(t);
+      try{
+         this->priv_schedule(t);
+      }
+      catch(...){
+         //Drop the reference that the pool would have released
+         t->release();
+         throw;
+      }
+      return ::boost::move(ret);
+   }
+
+   static worker *&priv_current_worker()
+   {
+      static BOOST_MOVE_THREAD_LOCAL worker *current = 0;
+      return current;
+   }
+
+   void priv_schedule(task_base *t)
+   {
+      worker *const w = priv_current_worker();
+      if(w && w->m_pool == this){
+         w->m_deque.push(t);
+      }
+      else{
+         ::boost::move_detail::scoped_lock lock(m_inject_mtx);
+         if(m_inject_tail){
+            m_inject_tail->m_next = t;
+         }
+         else{
+            m_inject_head = t;
+         }
+         m_inject_tail = t;
+         m_injected.fetch_add(1u, ::boost::move_detail::memory_order_release);
+      }
+      m_wait.notify();
+   }
+
+   task_base *priv_pop_injected()
+   {
+      if(!m_injected.load(::boost::move_detail::memory_order_acquire)){
+         return 0;
+      }
+      ::boost::move_detail::scoped_lock lock(m_inject_mtx);
+      task_base *const t = m_inject_head;
+      if(t){
+         m_inject_head = t->m_next;
+         if(!m_inject_head){
+            m_inject_tail = 0;
+         }
+         m_injected.fetch_sub(1u, ::boost::move_detail::memory_order_relaxed);
+      }
+      return t;
+   }
+
+   task_base *priv_find_task(worker &w)
+   {
+      task_base *t = w.m_deque.take();
+      if(!t){
+         t = this->priv_pop_injected();
+      }
+      for(size_type i = 1; !t && i < m_size; ++i){
+         t = m_workers[(w.m_index + i) % m_size].m_deque.steal();
+      }
+      return t;
+   }
+
+   void priv_run(worker &w)
+   {
+      priv_current_worker() = &w;
+      for(;;){
+         task_base *t = this->priv_find_task(w);
+         if(!t){
+            const blocking_wait::ticket_type ticket = m_wait.prepare_wait();
+            t = this->priv_find_task(w);
+            if(!t){
+               if(m_stop.load(::boost::move_detail::memory_order_acquire)){
+                  break;
+               }
+               m_wait.wait(ticket);
+               continue;
+            }
+         }
+         t->run();
+      }
+      priv_current_worker() = 0;
+   }
+
+   static void priv_worker_main(void *p)
+   {
+      worker &w = *static_cast<worker*>(p);
+      w.m_pool->priv_run(w);
+   }
+
+   void priv_shutdown()
+   {
+      m_stop.store(true, ::boost::move_detail::memory_order_release);
+      m_wait.notify();
+      for(size_type i = 0; i != m_size; ++i){
+         if(m_workers[i].m_thread){
+            m_workers[i].m_thread->join();
+            delete m_workers[i].m_thread;
+         }
+      }
+      delete [] m_workers;
+   }
+
+   worker                                     *m_workers;
+   size_type                                   m_size;
+   blocking_wait                               m_wait;
+   ::boost::move_detail::mutex                 m_inject_mtx;
+   task_base                                  *m_inject_head;
+   task_base                                  *m_inject_tail;
+   ::boost::move_detail::atomic<std::size_t>   m_injected;
+   ::boost::move_detail::atomic<bool>          m_stop;
+   /// @endcond
+};
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_THREAD_POOL_HPP
@@ -0,0 +1,385 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#if !defined(BOOST_PP_IS_ITERATING)
+
+#ifndef BOOST_MOVE_TUPLE_HPP
+#define BOOST_MOVE_TUPLE_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/relocate.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
+#include <boost/type_traits/add_lvalue_reference.hpp>
+#include <boost/type_traits/add_const.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/type_traits/remove_reference.hpp>
+#include <boost/preprocessor/iteration/iterate.hpp>
+#include <boost/preprocessor/repetition/enum_params_with_a_default.hpp>
+#include <boost/preprocessor/repetition/repeat.hpp>
+#include <boost/preprocessor/facilities/intercept.hpp>
+#include <boost/preprocessor/punctuation/comma_if.hpp>
+#include <boost/preprocessor/arithmetic/sub.hpp>
+#include <boost/preprocessor/comparison/equal.hpp>
+#include <boost/preprocessor/cat.hpp>
+#include <cstddef>   //std::size_t
+
+//! Maximum number of elements of a tuple.
+#define BOOST_MOVE_TUPLE_LIMIT BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS
+
+/// @cond
+
+#define BOOST_MOVE_TUPLE_TEMPLATE_PARAMS \
+   BOOST_PP_ENUM_PARAMS(BOOST_MOVE_TUPLE_LIMIT, class T)
+//
+
+#define BOOST_MOVE_TUPLE_TEMPLATE_ARGS \
+   BOOST_PP_ENUM_PARAMS(BOOST_MOVE_TUPLE_LIMIT, T)
+//
+
+//Moves a tuple element: references are forwarded as they are
+#if defined(BOOST_NO_RVALUE_REFERENCES)
+#define BOOST_MOVE_TUPLE_MOVE_ELEM(TYPE, ELEM) ::boost::move(ELEM)
+#else
+#define BOOST_MOVE_TUPLE_MOVE_ELEM(TYPE, ELEM) ::boost::forward<TYPE>(ELEM)
+#endif
+
+/// @endcond
+
+namespace boost {
+namespace movelib {
+
+//! Type of the unused elements of a tuple.
+struct null_type {};
+
+//! Tag type to select the piecewise constructor of pair.
+struct piecewise_construct_t {};
+
+//! Instance of piecewise_construct_t.
+static const piecewise_construct_t piecewise_construct = piecewise_construct_t();
+
+//! A fixed-size collection of heterogeneous values with move semantics
+//! in C++03 and C++0x compilers. Elements are moved through their
+//! BOOST_RV_REF constructors and assignments when the tuple is moved.
+template<BOOST_PP_ENUM_PARAMS_WITH_A_DEFAULT(BOOST_MOVE_TUPLE_LIMIT, class T, ::boost::movelib::null_type)>
+class tuple;
+
+//! Number of elements of a tuple.
+template<class Tuple>
+struct tuple_size;
+
+//! Type of the I-th element of a tuple.
+template<std::size_t I, class Tuple>
+struct tuple_element;
+
+}  //namespace movelib {
+
+/// @cond
+
+namespace move_detail {
+
+//Type stored by forward_as_tuple for an argument caught as BOOST_FWD_REF(P)
+#if defined(BOOST_NO_RVALUE_REFERENCES)
+template<class P>
+struct forward_type
+{  typedef const P &type;  };
+
+template<class T>
+struct forward_type< ::boost::rv<T> >
+{  typedef ::boost::rv<T> &type;  };
+#else
+template<class P>
+struct forward_type
+{  typedef P &&type;  };
+#endif
+
+template<class T>
+void move_swap(T &a, T &b)
+{
+   T tmp(::boost::move(a));
+   a = ::boost::move(b);
+   b = ::boost::move(tmp);
+}
+
+template<std::size_t I>
+struct tuple_getter;
+
+#define BOOST_MOVE_TUPLE_GETTER(z, n, data)                                               \
+template<>                                                                                \
+struct tuple_getter<n>                                                                    \
+{                                                                                         \
+   template<class Tuple>                                                                  \
+   static typename ::boost::add_lvalue_reference                                                 \
+      <typename ::boost::movelib::tuple_element<n, Tuple>::type>::type                    \
+      get(Tuple &t)                                                                       \
+   {  return t.m##n;  }                                                                   \
+                                                                                          \
+   template<class Tuple>                                                                  \
+   static typename ::boost::add_lvalue_reference<typename ::boost::add_const                     \
+      <typename ::boost::movelib::tuple_element<n, Tuple>::type>::type>::type             \
+      get(const Tuple &t)                                                                 \
+   {  return t.m##n;  }                                                                   \
+};                                                                                        \
+//
+BOOST_PP_REPEAT(BOOST_MOVE_TUPLE_LIMIT, BOOST_MOVE_TUPLE_GETTER, _)
+#undef BOOST_MOVE_TUPLE_GETTER
+
+}  //namespace move_detail {
+
+/// @endcond
+
+namespace movelib {
+
+/// @cond
+
+#define BOOST_MOVE_TUPLE_NOT_NULL(z, n, data) \
+   + (::boost::is_same<T##n, ::boost::movelib::null_type>::value ? 0 : 1)
+//
+
+/// @endcond
+
+template<BOOST_MOVE_TUPLE_TEMPLATE_PARAMS>
+struct tuple_size< tuple<BOOST_MOVE_TUPLE_TEMPLATE_ARGS> >
+{
+   static const std::size_t value = 0 BOOST_PP_REPEAT(BOOST_MOVE_TUPLE_LIMIT, BOOST_MOVE_TUPLE_NOT_NULL, _);
+};
+
+#undef BOOST_MOVE_TUPLE_NOT_NULL
+
+/// @cond
+
+#define BOOST_MOVE_TUPLE_ELEMENT(z, n, data)                                              \
+template<BOOST_MOVE_TUPLE_TEMPLATE_PARAMS>                                                \
+struct tuple_element<n, tuple<BOOST_MOVE_TUPLE_TEMPLATE_ARGS> >                           \
+{  typedef T##n type;  };                                                                 \
+//
+BOOST_PP_REPEAT(BOOST_MOVE_TUPLE_LIMIT, BOOST_MOVE_TUPLE_ELEMENT, _)
+#undef BOOST_MOVE_TUPLE_ELEMENT
+
+/// @endcond
+
+//! <b>Returns</b>: A reference to the I-th element of t.
+template<std::size_t I, BOOST_MOVE_TUPLE_TEMPLATE_PARAMS>
+typename ::boost::add_lvalue_reference
+   <typename tuple_element<I, tuple<BOOST_MOVE_TUPLE_TEMPLATE_ARGS> >::type>::type
+   get(tuple<BOOST_MOVE_TUPLE_TEMPLATE_ARGS> &t)
+{  return ::boost::move_detail::tuple_getter<I>::get(t);  }
+
+//! <b>Returns</b>: A const reference to the I-th element of t.
+template<std::size_t I, BOOST_MOVE_TUPLE_TEMPLATE_PARAMS>
+typename ::boost::add_lvalue_reference<typename ::boost::add_const
+   <typename tuple_element<I, tuple<BOOST_MOVE_TUPLE_TEMPLATE_ARGS> >::type>::type>::type
+   get(const tuple<BOOST_MOVE_TUPLE_TEMPLATE_ARGS> &t)
+{  return ::boost::move_detail::tuple_getter<I>::get(t);  }
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#define BOOST_PP_ITERATION_PARAMS_1 (3, (0, BOOST_MOVE_TUPLE_LIMIT, <boost/move/tuple.hpp>))
+#include BOOST_PP_ITERATE()
+
+namespace boost {
+namespace movelib {
+
+#if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+//! <b>Returns</b>: A tuple of references to the arguments, suitable
+//!   to be forwarded to a constructor. Arguments marked with ::boost::move
+//!   are stored as rvalue references and will be moved.
+template<class ...Args>
+tuple<Args&&...> forward_as_tuple(Args&&... args);
+#else
+#define BOOST_MOVE_TUPLE_FWD_TYPE(z, n, data) \
+   typename ::boost::move_detail::forward_type<P##n>::type
+//
+#define BOOST_PP_LOCAL_MACRO(n)                                                           \
+BOOST_MOVE_PP_TEMPLATE_DECL(n)                                                            \
+inline tuple<BOOST_PP_ENUM(n, BOOST_MOVE_TUPLE_FWD_TYPE, _)>                              \
+   forward_as_tuple(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM, _))                             \
+{                                                                                         \
+   return tuple<BOOST_PP_ENUM(n, BOOST_MOVE_TUPLE_FWD_TYPE, _)>                           \
+      (BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM_FORWARD, _));                                 \
+}                                                                                         \
+//
+#define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_TUPLE_LIMIT)
+#include BOOST_PP_LOCAL_ITERATE()
+#undef BOOST_MOVE_TUPLE_FWD_TYPE
+#endif
+
+/// @cond
+
+#define BOOST_MOVE_TUPLE_NOTHROW_MOVE(z, n, data)                                         \
+   && (::boost::has_nothrow_move<T##n>::value ||                                          \
+       ::boost::movelib::is_trivially_relocatable<T##n>::value)                           \
+//
+
+#define BOOST_MOVE_TUPLE_TRIVIALLY_RELOCATABLE(z, n, data)                                \
+   && ::boost::movelib::is_trivially_relocatable<T##n>::value                             \
+//
+
+#define BOOST_MOVE_TUPLE_TRIVIAL_DESTRUCTOR_AFTER_MOVE(z, n, data)                        \
+   && ::boost::has_trivial_destructor_after_move<T##n>::value                             \
+//
+
+/// @endcond
+
+//! A tuple is trivially relocatable if all its elements are.
+template<BOOST_MOVE_TUPLE_TEMPLATE_PARAMS>
+struct is_trivially_relocatable< tuple<BOOST_MOVE_TUPLE_TEMPLATE_ARGS> >
+{
+   static const bool value = true
+      BOOST_PP_REPEAT(BOOST_MOVE_TUPLE_LIMIT, BOOST_MOVE_TUPLE_TRIVIALLY_RELOCATABLE, _);
+};
+
+}  //namespace movelib {
+
+template<BOOST_MOVE_TUPLE_TEMPLATE_PARAMS>
+struct has_nothrow_move< ::boost::movelib::tuple<BOOST_MOVE_TUPLE_TEMPLATE_ARGS> >
+{
+   static const bool value = true
+      BOOST_PP_REPEAT(BOOST_MOVE_TUPLE_LIMIT, BOOST_MOVE_TUPLE_NOTHROW_MOVE, _);
+};
+
+template<BOOST_MOVE_TUPLE_TEMPLATE_PARAMS>
+struct has_trivial_destructor_after_move< ::boost::movelib::tuple<BOOST_MOVE_TUPLE_TEMPLATE_ARGS> >
+{
+   static const bool value = true
+      BOOST_PP_REPEAT(BOOST_MOVE_TUPLE_LIMIT, BOOST_MOVE_TUPLE_TRIVIAL_DESTRUCTOR_AFTER_MOVE, _);
+};
+
+template<>
+struct has_nothrow_move< ::boost::movelib::null_type >
+{
+   static const bool value = true;
+};
+
+template<>
+struct has_trivial_destructor_after_move< ::boost::movelib::null_type >
+{
+   static const bool value = true;
+};
+
+#undef BOOST_MOVE_TUPLE_NOTHROW_MOVE
+#undef BOOST_MOVE_TUPLE_TRIVIALLY_RELOCATABLE
+#undef BOOST_MOVE_TUPLE_TRIVIAL_DESTRUCTOR_AFTER_MOVE
+
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_TUPLE_HPP
+
+#else //#if !defined(BOOST_PP_IS_ITERATING)
+
+#define BOOST_MOVE_TUPLE_N BOOST_PP_ITERATION()
+
+#define BOOST_MOVE_TUPLE_MEMBER(z, n, data)        T##n m##n;
+#define BOOST_MOVE_TUPLE_INIT_DEFAULT(z, n, data)  m##n()
+#define BOOST_MOVE_TUPLE_INIT_FWD(z, n, data)      m##n(::boost::forward<U##n>(u##n))
+#define BOOST_MOVE_TUPLE_INIT_COPY(z, n, data)     m##n(x.m##n)
+#define BOOST_MOVE_TUPLE_INIT_MOVE(z, n, data)     m##n(BOOST_MOVE_TUPLE_MOVE_ELEM(T##n, x.m##n))
+#define BOOST_MOVE_TUPLE_ASSIGN_COPY(z, n, data)   m##n = x.m##n;
+#define BOOST_MOVE_TUPLE_ASSIGN_MOVE(z, n, data)   m##n = BOOST_MOVE_TUPLE_MOVE_ELEM(T##n, x.m##n);
+#define BOOST_MOVE_TUPLE_SWAP(z, n, data)          ::boost::move_detail::move_swap(m##n, x.m##n);
+#define BOOST_MOVE_TUPLE_FWD_PARAM(z, n, data)     BOOST_FWD_REF(U##n) u##n
+
+namespace boost {
+namespace movelib {
+
+#if BOOST_MOVE_TUPLE_N == BOOST_MOVE_TUPLE_LIMIT
+template<BOOST_PP_ENUM_PARAMS(BOOST_MOVE_TUPLE_N, class T)>
+class tuple
+#else
+template<BOOST_PP_ENUM_PARAMS(BOOST_MOVE_TUPLE_N, class T)>
+class tuple
+   < BOOST_PP_ENUM_PARAMS(BOOST_MOVE_TUPLE_N, T) BOOST_PP_COMMA_IF(BOOST_MOVE_TUPLE_N)
+     BOOST_PP_ENUM_PARAMS(BOOST_PP_SUB(BOOST_MOVE_TUPLE_LIMIT, BOOST_MOVE_TUPLE_N), ::boost::movelib::null_type BOOST_PP_INTERCEPT)>
+#endif
+{
+   /// @cond
+   BOOST_COPYABLE_AND_MOVABLE(tuple)
+   /// @endcond
+
+   public:
+   //! <b>Effects</b>: Value initializes all the elements.
+   tuple()
+      BOOST_PP_EXPR_IF(BOOST_MOVE_TUPLE_N, :)
+      BOOST_PP_ENUM(BOOST_MOVE_TUPLE_N, BOOST_MOVE_TUPLE_INIT_DEFAULT, _)
+   {}
+
+   #if BOOST_MOVE_TUPLE_N
+   //! <b>Effects</b>: Constructs every element forwarding the corresponding argument.
+   template<BOOST_PP_ENUM_PARAMS(BOOST_MOVE_TUPLE_N, class U)>
+   BOOST_PP_EXPR_IF(BOOST_PP_EQUAL(BOOST_MOVE_TUPLE_N, 1), explicit)
+   tuple(BOOST_PP_ENUM(BOOST_MOVE_TUPLE_N, BOOST_MOVE_TUPLE_FWD_PARAM, _)
+      #if BOOST_MOVE_TUPLE_N == 1
+      , typename ::boost::move_detail::disable_if< ::boost::is_same<typename ::boost::remove_cv
+         <typename ::boost::remove_reference<U0>::type>::type, tuple> >::type* = 0
+      #endif
+      )
+      : BOOST_PP_ENUM(BOOST_MOVE_TUPLE_N, BOOST_MOVE_TUPLE_INIT_FWD, _)
+   {}
+   #endif
+
+   //! <b>Effects</b>: Copy constructs every element.
+   tuple(const tuple &x)
+      BOOST_PP_EXPR_IF(BOOST_MOVE_TUPLE_N, :)
+      BOOST_PP_ENUM(BOOST_MOVE_TUPLE_N, BOOST_MOVE_TUPLE_INIT_COPY, _)
+   {  (void)x;  }
+
+   //! <b>Effects</b>: Move constructs every element.
+   tuple(BOOST_RV_REF(tuple) x)
+      BOOST_PP_EXPR_IF(BOOST_MOVE_TUPLE_N, :)
+      BOOST_PP_ENUM(BOOST_MOVE_TUPLE_N, BOOST_MOVE_TUPLE_INIT_MOVE, _)
+   {  (void)x;  }
+
+   //! <b>Effects</b>: Copy assigns every element.
+   tuple &operator=(BOOST_COPY_ASSIGN_REF(tuple) x)
+   {
+      (void)x;
+      BOOST_PP_REPEAT(BOOST_MOVE_TUPLE_N, BOOST_MOVE_TUPLE_ASSIGN_COPY, _)
+      return *this;
+   }
+
+   //! <b>Effects</b>: Move assigns every element.
+   tuple &operator=(BOOST_RV_REF(tuple) x)
+   {
+      (void)x;
+      BOOST_PP_REPEAT(BOOST_MOVE_TUPLE_N, BOOST_MOVE_TUPLE_ASSIGN_MOVE, _)
+      return *this;
+   }
+
+   //! <b>Effects</b>: Swaps every element using move construction and assignment.
+   void swap(tuple &x)
+   {
+      (void)x;
+      BOOST_PP_REPEAT(BOOST_MOVE_TUPLE_N, BOOST_MOVE_TUPLE_SWAP, _)
+   }
+
+   /// @cond
+   BOOST_PP_REPEAT(BOOST_MOVE_TUPLE_N, BOOST_MOVE_TUPLE_MEMBER, _)
+   /// @endcond
+};
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#undef BOOST_MOVE_TUPLE_MEMBER
+#undef BOOST_MOVE_TUPLE_INIT_DEFAULT
+#undef BOOST_MOVE_TUPLE_INIT_FWD
+#undef BOOST_MOVE_TUPLE_INIT_COPY
+#undef BOOST_MOVE_TUPLE_INIT_MOVE
+#undef BOOST_MOVE_TUPLE_ASSIGN_COPY
+#undef BOOST_MOVE_TUPLE_ASSIGN_MOVE
+#undef BOOST_MOVE_TUPLE_SWAP
+#undef BOOST_MOVE_TUPLE_FWD_PARAM
+#undef BOOST_MOVE_TUPLE_N
+
+#endif //#if !defined(BOOST_PP_IS_ITERATING)
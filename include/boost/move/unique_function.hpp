@@ -0,0 +1,386 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#if !defined(BOOST_PP_IS_ITERATING)
+
+#ifndef BOOST_MOVE_UNIQUE_FUNCTION_HPP
+#define BOOST_MOVE_UNIQUE_FUNCTION_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/relocate.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/type_traits/decay.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_void.hpp>
+#include <boost/preprocessor/iteration/iterate.hpp>
+#include <boost/preprocessor/repetition/enum_binary_params.hpp>
+#include <boost/preprocessor/repetition/enum_trailing_binary_params.hpp>
+#include <boost/preprocessor/punctuation/comma_if.hpp>
+#include <boost/preprocessor/cat.hpp>
+#include <cstddef>   //std::size_t
+#include <cstring>   //std::memcpy
+#include <stdexcept> //std::runtime_error
+#include <new>       //placement new
+
+//! Default size in bytes of the inline buffer of unique_function.
+//! Callables that fit in the buffer and are trivially relocatable or
+//! have a non-throwing move constructor are stored without allocating.
+#ifndef BOOST_MOVE_UNIQUE_FUNCTION_BUFFER_SIZE
+#define BOOST_MOVE_UNIQUE_FUNCTION_BUFFER_SIZE (4*sizeof(void*))
+#endif
+
+namespace boost {
+namespace movelib {
+
+//! Exception thrown when an empty unique_function is called.
+class bad_function_call
+   : public std::runtime_error
+{
+   public:
+   bad_function_call()
+      : std::runtime_error("call to empty boost::movelib::unique_function")
+   {}
+};
+
+//! A move-only polymorphic function wrapper. Unlike boost::function, the
+//! stored callable needs not to be copyable, so function objects holding
+//! BOOST_MOVABLE_BUT_NOT_COPYABLE resources can be stored by value.
+//!
+//! Callables smaller than BufferSize bytes are stored in an inline buffer if
+//! their move can't throw (see <i>has_nothrow_move</i> and
+//! <i>is_trivially_relocatable</i>), otherwise they are allocated on the heap.
+//! Moving a unique_function never throws and never allocates: trivially
+//! relocatable and heap-allocated callables are moved with std::memcpy.
+template<class Signature, std::size_t BufferSize = BOOST_MOVE_UNIQUE_FUNCTION_BUFFER_SIZE>
+class unique_function;
+
+}  //namespace movelib {
+
+/// @cond
+
+namespace move_detail {
+
+template<std::size_t Size>
+union function_storage
+{
+   void *heap;
+   typename ::boost::aligned_storage
+      < Size < sizeof(void*) ? sizeof(void*) : Size
+      , ::boost::alignment_of< ::boost::detail::max_align>::value>::type buf;
+};
+
+//Type-erased lifetime operations of the stored callable
+struct function_manager
+{
+   bool  trivially_relocatable;
+   void (*relocate)(void *dst, void *src);
+   void (*destroy)(void *storage);
+};
+
+template<class F, std::size_t Size>
+struct function_fits_inline
+{
+   static const bool value =
+      sizeof(F) <= sizeof(function_storage<Size>) &&
+      ::boost::alignment_of<F>::value <= ::boost::alignment_of< ::boost::detail::max_align>::value &&
+      (::boost::movelib::is_trivially_relocatable<F>::value || ::boost::has_nothrow_move<F>::value);
+};
+
+template<class F, bool Inline>
+struct function_manager_holder
+{
+   static F *get(void *storage)
+   {  return static_cast<F*>(storage);  }
+
+   static void relocate(void *dst, void *src)
+   {
+      F *f = get(src);
+      ::new(dst) F(::boost::move(*f));
+      f->~F();
+   }
+
+   static void destroy(void *storage)
+   {  get(storage)->~F();  }
+
+   static const function_manager manager;
+};
+
+template<class F, bool Inline>
+const function_manager function_manager_holder<F, Inline>::manager =
+{  ::boost::movelib::is_trivially_relocatable<F>::value
+,  &function_manager_holder<F, Inline>::relocate
+,  &function_manager_holder<F, Inline>::destroy
+};
+
+template<class F>
+struct function_manager_holder<F, false>
+{
+   static F *get(void *storage)
+   {  return static_cast<F*>(*static_cast<void**>(storage));  }
+
+   static void destroy(void *storage)
+   {  delete get(storage);  }
+
+   static const function_manager manager;
+};
+
+//Heap allocated callables are relocated copying the pointer
+template<class F>
+const function_manager function_manager_holder<F, false>::manager =
+{  true
+,  0
+,  &function_manager_holder<F, false>::destroy
+};
+
+}  //namespace move_detail {
+
+/// @endcond
+
+}  //namespace boost {
+
+#if defined(BOOST_NO_RVALUE_REFERENCES)
+#define BOOST_MOVE_UNIQUE_FUNCTION_ARG(z, n, data) a##n
+#else
+#define BOOST_MOVE_UNIQUE_FUNCTION_ARG(z, n, data) ::boost::forward<A##n>(a##n)
+#endif
+
+#define BOOST_PP_ITERATION_PARAMS_1 (3, (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS, <boost/move/unique_function.hpp>))
+#include BOOST_PP_ITERATE()
+
+#undef BOOST_MOVE_UNIQUE_FUNCTION_ARG
+
+#endif //#ifndef BOOST_MOVE_UNIQUE_FUNCTION_HPP
+
+#else //#if !defined(BOOST_PP_IS_ITERATING)
+
+#define BOOST_MOVE_UF_N BOOST_PP_ITERATION()
+
+namespace boost {
+
+/// @cond
+
+namespace move_detail {
+
+template<bool IsVoid, class F, bool Inline, class R BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_MOVE_UF_N, class A)>
+struct BOOST_PP_CAT(function_invoker, BOOST_MOVE_UF_N)
+{
+   static R invoke(void *storage BOOST_PP_ENUM_TRAILING_BINARY_PARAMS(BOOST_MOVE_UF_N, A, a))
+   {
+      return (*function_manager_holder<F, Inline>::get(storage))
+         (BOOST_PP_ENUM(BOOST_MOVE_UF_N, BOOST_MOVE_UNIQUE_FUNCTION_ARG, _));
+   }
+};
+
+template<class F, bool Inline, class R BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_MOVE_UF_N, class A)>
+struct BOOST_PP_CAT(function_invoker, BOOST_MOVE_UF_N)<true, F, Inline, R BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_MOVE_UF_N, A)>
+{
+   //The result of the callable is discarded
+   static R invoke(void *storage BOOST_PP_ENUM_TRAILING_BINARY_PARAMS(BOOST_MOVE_UF_N, A, a))
+   {
+      (*function_manager_holder<F, Inline>::get(storage))
+         (BOOST_PP_ENUM(BOOST_MOVE_UF_N, BOOST_MOVE_UNIQUE_FUNCTION_ARG, _));
+   }
+};
+
+}  //namespace move_detail {
+
+/// @endcond
+
+namespace movelib {
+
+template<class R BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_MOVE_UF_N, class A), std::size_t BufferSize>
+class unique_function<R (BOOST_PP_ENUM_PARAMS(BOOST_MOVE_UF_N, A)), BufferSize>
+{
+   /// @cond
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(unique_function)
+   typedef ::boost::move_detail::function_storage<BufferSize>  storage_t;
+   typedef ::boost::move_detail::function_manager              manager_t;
+   typedef R (*invoker_t)(void* BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_MOVE_UF_N, A));
+   typedef invoker_t unique_function::*unspecified_bool_type;
+   /// @endcond
+
+   public:
+   typedef R result_type;
+
+   //! <b>Effects</b>: Constructs an empty unique_function.
+   //!
+   //! <b>Throws</b>: Nothing.
+   unique_function()
+      : m_invoke(0), m_manager(0)
+   {}
+
+   //! <b>Effects</b>: Constructs a unique_function that calls the function
+   //!   pointed by f, or an empty unique_function if f is null.
+   //!
+   //! <b>Throws</b>: Nothing.
+   unique_function(R (*f)(BOOST_PP_ENUM_PARAMS(BOOST_MOVE_UF_N, A)))
+      : m_invoke(0), m_manager(0)
+   {
+      if(f){
+         this->template priv_init<R (*)(BOOST_PP_ENUM_PARAMS(BOOST_MOVE_UF_N, A))>(f);
+      }
+   }
+
+   #if defined(BOOST_NO_RVALUE_REFERENCES)
+   template<class F>
+   unique_function(const F &f
+      , typename ::boost::move_detail::disable_if< ::boost::is_same<F, unique_function> >::type* = 0)
+      : m_invoke(0), m_manager(0)
+   {  this->template priv_init<typename ::boost::decay<F>::type>(f);  }
+
+   template<class F>
+   unique_function(BOOST_RV_REF(F) f)
+      : m_invoke(0), m_manager(0)
+   {  this->template priv_init<F>(f);  }
+   #else
+   //! <b>Effects</b>: Constructs a unique_function that stores f, moving from
+   //!   f if it's an rvalue. f is stored in the inline buffer if it fits and can
+   //!   be moved without throwing, otherwise it's allocated in the heap.
+   template<class F>
+   unique_function(F &&f
+      , typename ::boost::move_detail::disable_if
+         < ::boost::is_same<typename ::boost::decay<F>::type, unique_function> >::type* = 0)
+      : m_invoke(0), m_manager(0)
+   {  this->template priv_init<typename ::boost::decay<F>::type>(::boost::forward<F>(f));  }
+   #endif
+
+   //! <b>Effects</b>: Move constructor. x is left empty.
+   //!
+   //! <b>Throws</b>: Nothing.
+   unique_function(BOOST_RV_REF(unique_function) x)
+      : m_invoke(0), m_manager(0)
+   {  this->priv_steal(x);  }
+
+   //! <b>Effects</b>: Destroys the stored callable and steals the callable of x.
+   //!   x is left empty.
+   //!
+   //! <b>Throws</b>: Nothing.
+   unique_function& operator=(BOOST_RV_REF(unique_function) x)
+   {
+      if(this != &x){
+         this->reset();
+         this->priv_steal(x);
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Destroys the stored callable.
+   ~unique_function()
+   {  this->reset();  }
+
+   //! <b>Effects</b>: Destroys the stored callable, leaving *this empty.
+   //!
+   //! <b>Throws</b>: Nothing.
+   void reset()
+   {
+      if(m_manager){
+         m_manager->destroy(&m_storage);
+         m_invoke  = 0;
+         m_manager = 0;
+      }
+   }
+
+   //! <b>Effects</b>: Exchanges the stored callables of *this and x.
+   //!
+   //! <b>Throws</b>: Nothing.
+   void swap(unique_function &x)
+   {
+      unique_function tmp(::boost::move(x));
+      x = ::boost::move(*this);
+      *this = ::boost::move(tmp);
+   }
+
+   //! <b>Returns</b>: true if no callable is stored.
+   bool empty() const
+   {  return !m_invoke;  }
+
+   //! <b>Returns</b>: An object convertible to true if a callable is stored.
+   operator unspecified_bool_type() const
+   {  return m_invoke ? &unique_function::m_invoke : 0;  }
+
+   //! <b>Effects</b>: Calls the stored callable forwarding the arguments.
+   //!
+   //! <b>Throws</b>: bad_function_call if *this is empty or any exception
+   //!   thrown by the stored callable.
+   R operator()(BOOST_PP_ENUM_BINARY_PARAMS(BOOST_MOVE_UF_N, A, a)) const
+   {
+      if(!m_invoke){
+         throw bad_function_call();
+      }
+      return m_invoke(&m_storage BOOST_PP_COMMA_IF(BOOST_MOVE_UF_N)
+         BOOST_PP_ENUM(BOOST_MOVE_UF_N, BOOST_MOVE_UNIQUE_FUNCTION_ARG, _));
+   }
+
+   /// @cond
+   private:
+
+   template<class F, class S>
+   void priv_init(BOOST_FWD_REF(S) s)
+   {
+      const bool is_inline = ::boost::move_detail::function_fits_inline<F, BufferSize>::value;
+      if(is_inline){
+         ::new(static_cast<void*>(&m_storage)) F(::boost::forward<S>(s));
+      }
+      else{
+         m_storage.heap = new F(::boost::forward<S>(s));
+      }
+      m_invoke = &::boost::move_detail::BOOST_PP_CAT(function_invoker, BOOST_MOVE_UF_N)
+         < ::boost::is_void<R>::value, F, is_inline, R BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_MOVE_UF_N, A)>::invoke;
+      m_manager = &::boost::move_detail::function_manager_holder<F, is_inline>::manager;
+   }
+
+   void priv_steal(unique_function &x)
+   {
+      if(x.m_manager){
+         if(x.m_manager->trivially_relocatable){
+            std::memcpy(static_cast<void*>(&m_storage), &x.m_storage, sizeof(storage_t));
+         }
+         else{
+            x.m_manager->relocate(&m_storage, &x.m_storage);
+         }
+         m_invoke  = x.m_invoke;
+         m_manager = x.m_manager;
+         x.m_invoke  = 0;
+         x.m_manager = 0;
+      }
+   }
+
+   invoker_t         m_invoke;
+   const manager_t  *m_manager;
+   mutable storage_t m_storage;
+   /// @endcond
+};
+
+}  //namespace movelib {
+
+template<class R BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_MOVE_UF_N, class A), std::size_t BufferSize>
+struct has_nothrow_move< ::boost::movelib::unique_function<R (BOOST_PP_ENUM_PARAMS(BOOST_MOVE_UF_N, A)), BufferSize> >
+{
+   static const bool value = true;
+};
+
+//A moved-from unique_function is empty
+template<class R BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_MOVE_UF_N, class A), std::size_t BufferSize>
+struct has_trivial_destructor_after_move< ::boost::movelib::unique_function<R (BOOST_PP_ENUM_PARAMS(BOOST_MOVE_UF_N, A)), BufferSize> >
+{
+   static const bool value = true;
+};
+
+}  //namespace boost {
+
+#undef BOOST_MOVE_UF_N
+
+#endif //#if !defined(BOOST_PP_IS_ITERATING)
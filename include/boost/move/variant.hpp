@@ -0,0 +1,540 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+
+#ifndef BOOST_MOVE_VARIANT_HPP
+#define BOOST_MOVE_VARIANT_HPP
+
+#include <boost/move/move.hpp>
+#include <boost/move/relocate.hpp>
+#include <boost/move/detail/fwd_macros.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/assert.hpp>
+#include <boost/preprocessor/repetition/enum_shifted.hpp>
+#include <boost/preprocessor/repetition/enum_shifted_params.hpp>
+#include <boost/preprocessor/repetition/repeat.hpp>
+#include <boost/preprocessor/facilities/intercept.hpp>
+#include <boost/preprocessor/cat.hpp>
+#include <cstddef>   //std::size_t
+#include <cstring>   //std::memcpy
+#include <exception> //std::exception
+#include <new>       //placement new
+
+//! Maximum number of alternatives of a variant.
+#ifndef BOOST_MOVE_VARIANT_LIMIT_TYPES
+#define BOOST_MOVE_VARIANT_LIMIT_TYPES 8
+#endif
+
+/// @cond
+
+#define BOOST_MOVE_VARIANT_TEMPLATE_PARAMS \
+   BOOST_PP_ENUM_PARAMS(BOOST_MOVE_VARIANT_LIMIT_TYPES, class T)
+//
+
+#define BOOST_MOVE_VARIANT_TEMPLATE_ARGS \
+   BOOST_PP_ENUM_PARAMS(BOOST_MOVE_VARIANT_LIMIT_TYPES, T)
+//
+
+#define BOOST_MOVE_VARIANT_VOID_ARGS \
+   BOOST_PP_ENUM_PARAMS(BOOST_MOVE_VARIANT_LIMIT_TYPES, ::boost::move_detail::variant_void BOOST_PP_INTERCEPT)
+//
+
+#define BOOST_MOVE_VARIANT_DEFAULT_PARAM(z, n, data) \
+   class BOOST_PP_CAT(T, n) = ::boost::move_detail::variant_void
+//
+
+namespace boost {
+namespace move_detail {
+
+//Placeholder for unused alternatives
+struct variant_void {};
+
+//Size, alignment and relocation properties of all the alternatives
+template<BOOST_MOVE_VARIANT_TEMPLATE_PARAMS>
+struct variant_traits
+{
+   typedef variant_traits
+      < BOOST_PP_ENUM_SHIFTED_PARAMS(BOOST_MOVE_VARIANT_LIMIT_TYPES, T)
+      , variant_void>   next;
+
+   static const std::size_t count = 1 + next::count;
+   static const std::size_t size  =
+      sizeof(T0) > next::size ? sizeof(T0) : next::size;
+   static const std::size_t align =
+      ::boost::alignment_of<T0>::value > next::align ? ::boost::alignment_of<T0>::value : next::align;
+   static const bool trivially_relocatable =
+      ::boost::movelib::is_trivially_relocatable<T0>::value && next::trivially_relocatable;
+   static const bool trivially_copyable =
+      ::boost::has_trivial_copy<T0>::value && ::boost::has_trivial_destructor<T0>::value &&
+      next::trivially_copyable;
+   static const bool nothrow_move =
+      (::boost::has_nothrow_move<T0>::value || ::boost::movelib::is_trivially_relocatable<T0>::value) &&
+      next::nothrow_move;
+};
+
+template<>
+struct variant_traits<BOOST_MOVE_VARIANT_VOID_ARGS>
+{
+   static const std::size_t count = 0;
+   static const std::size_t size  = 1;
+   static const std::size_t align = 1;
+   static const bool trivially_relocatable = true;
+   static const bool trivially_copyable = true;
+   static const bool nothrow_move = true;
+};
+
+//Index of U in the alternatives or -1 if not found
+template<class U, BOOST_MOVE_VARIANT_TEMPLATE_PARAMS>
+struct variant_index_of
+{
+   static const int next = variant_index_of
+      < U, BOOST_PP_ENUM_SHIFTED_PARAMS(BOOST_MOVE_VARIANT_LIMIT_TYPES, T), variant_void>::value;
+   static const int value = ::boost::is_same<U, T0>::value ? 0 : (next < 0 ? -1 : next + 1);
+};
+
+template<class U>
+struct variant_index_of<U, BOOST_MOVE_VARIANT_VOID_ARGS>
+{
+   static const int value = -1;
+};
+
+template<class R, class T>
+struct variant_visit
+{
+   template<class Visitor>
+   static R apply(Visitor &v, void *storage)
+   {  return v(*static_cast<T*>(storage));  }
+};
+
+template<class R>
+struct variant_visit<R, variant_void>
+{
+   template<class Visitor>
+   static R apply(Visitor &, void *)
+   {
+      BOOST_ASSERT(false);
+      throw std::exception();
+   }
+};
+
+struct variant_destroyer
+{
+   typedef void result_type;
+   template<class U>
+   void operator()(U &u) const {  u.~U();  }
+};
+
+struct variant_copy_constructor
+{
+   typedef void result_type;
+   void *dst;
+   template<class U>
+   void operator()(U &u) const {  ::new(dst) U(const_cast<const U&>(u));  }
+};
+
+struct variant_move_constructor
+{
+   typedef void result_type;
+   void *dst;
+   template<class U>
+   void operator()(U &u) const {  ::new(dst) U(::boost::move(u));  }
+};
+
+struct variant_copy_assigner
+{
+   typedef void result_type;
+   const void *src;
+   template<class U>
+   void operator()(U &u) const {  u = *static_cast<const U*>(src);  }
+};
+
+struct variant_move_assigner
+{
+   typedef void result_type;
+   void *src;
+   template<class U>
+   void operator()(U &u) const {  u = ::boost::move(*static_cast<U*>(src));  }
+};
+
+}  //namespace move_detail {
+}  //namespace boost {
+
+/// @endcond
+
+namespace boost {
+namespace movelib {
+
+//! Exception thrown when a variant is accessed as an alternative that
+//! is not the active one.
+class bad_variant_access
+   : public std::exception
+{
+   public:
+   virtual const char *what() const throw()
+   {  return "boost::movelib::bad_variant_access";  }
+};
+
+//! A tagged union of up to BOOST_MOVE_VARIANT_LIMIT_TYPES alternatives
+//! stored in place.
+//!
+//! Copying and moving a variant copies or moves its active alternative
+//! (moves use the alternative's BOOST_RV_REF constructor). Assigning a
+//! variant holding the same alternative uses the alternative's assignment.
+//! When the alternatives are trivially copyable the storage is copied with
+//! std::memcpy, and when all of them are trivially relocatable the variant
+//! itself is trivially relocatable.
+//!
+//! Unlike boost::variant no heap backup is used: if the construction of a
+//! new alternative throws during an assignment or emplace, the variant
+//! is left <i>valueless_by_exception()</i>.
+template<class T0, BOOST_PP_ENUM_SHIFTED(BOOST_MOVE_VARIANT_LIMIT_TYPES, BOOST_MOVE_VARIANT_DEFAULT_PARAM, _)>
+class variant
+{
+   /// @cond
+   BOOST_COPYABLE_AND_MOVABLE(variant)
+   typedef ::boost::move_detail::variant_traits<BOOST_MOVE_VARIANT_TEMPLATE_ARGS> traits_t;
+   typedef typename ::boost::aligned_storage<traits_t::size, traits_t::align>::type storage_t;
+
+   template<class U>
+   struct index_of
+      : ::boost::move_detail::variant_index_of<U, BOOST_MOVE_VARIANT_TEMPLATE_ARGS>
+   {};
+
+   template<class U, class R = void>
+   struct enable_if_alternative
+      : ::boost::move_detail::enable_if_c<(index_of<U>::value >= 0), R>
+   {};
+   /// @endcond
+
+   public:
+
+   //! <b>Effects</b>: Value initializes the first alternative.
+   variant()
+      : m_which(0)
+   {  ::new(static_cast<void*>(&m_storage)) T0();  }
+
+   //! <b>Effects</b>: Copy constructs the active alternative of x.
+   variant(const variant &x)
+      : m_which(-1)
+   {  this->priv_copy_construct(x);  }
+
+   //! <b>Effects</b>: Move constructs the active alternative of x.
+   //!   x holds the same alternative, in a moved-from state.
+   variant(BOOST_RV_REF(variant) x)
+      : m_which(-1)
+   {  this->priv_move_construct(x);  }
+
+   //! <b>Effects</b>: Constructs the alternative U copying u.
+   //!   U shall be one of the alternatives.
+   template<class U>
+   variant(const U &u, typename enable_if_alternative<U>::type* = 0)
+      : m_which(-1)
+   {
+      ::new(static_cast<void*>(&m_storage)) U(u);
+      m_which = index_of<U>::value;
+   }
+
+   //! <b>Effects</b>: Constructs the alternative U moving u.
+   //!   U shall be one of the alternatives.
+   template<class U>
+   variant(BOOST_RV_REF(U) u, typename enable_if_alternative<U>::type* = 0)
+      : m_which(-1)
+   {
+      ::new(static_cast<void*>(&m_storage)) U(::boost::move(u));
+      m_which = index_of<U>::value;
+   }
+
+   //! <b>Effects</b>: Destroys the active alternative.
+   ~variant()
+   {  this->priv_destroy();  }
+
+   //! <b>Effects</b>: If x holds the same alternative, copy assigns it.
+   //!   Otherwise copies x and move assigns the copy.
+   variant &operator=(BOOST_COPY_ASSIGN_REF(variant) x)
+   {
+      if(this != &x){
+         if(m_which == x.m_which && m_which >= 0){
+            if(traits_t::trivially_copyable){
+               std::memcpy(static_cast<void*>(&m_storage), &x.m_storage, sizeof(storage_t));
+            }
+            else{
+               ::boost::move_detail::variant_copy_assigner a = { &x.m_storage };
+               this->priv_visit(a);
+            }
+         }
+         else{
+            variant tmp(static_cast<const variant&>(x));
+            *this = ::boost::move(tmp);
+         }
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: If x holds the same alternative, move assigns it.
+   //!   Otherwise destroys the active alternative and move constructs the
+   //!   alternative of x.
+   //!
+   //! <b>Throws</b>: If the move constructor throws *this is left
+   //!   valueless_by_exception().
+   variant &operator=(BOOST_RV_REF(variant) x)
+   {
+      if(this != &x){
+         if(m_which == x.m_which && m_which >= 0){
+            if(traits_t::trivially_copyable){
+               std::memcpy(static_cast<void*>(&m_storage), &x.m_storage, sizeof(storage_t));
+            }
+            else{
+               ::boost::move_detail::variant_move_assigner a = { &x.m_storage };
+               this->priv_visit(a);
+            }
+         }
+         else{
+            this->priv_destroy();
+            this->priv_move_construct(x);
+         }
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Copy assigns u if U is the active alternative,
+   //!   otherwise destroys the active alternative and copy constructs u.
+   template<class U>
+   typename enable_if_alternative<U, variant&>::type
+      operator=(const U &u)
+   {
+      if(m_which == index_of<U>::value){
+         this->template unsafe_get<U>() = u;
+      }
+      else{
+         this->template emplace<U>(u);
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Move assigns u if U is the active alternative,
+   //!   otherwise destroys the active alternative and move constructs u.
+   template<class U>
+   typename enable_if_alternative<U, variant&>::type
+      operator=(BOOST_RV_REF(U) u)
+   {
+      if(m_which == index_of<U>::value){
+         this->template unsafe_get<U>() = ::boost::move(u);
+      }
+      else{
+         this->template emplace<U>(::boost::move(u));
+      }
+      return *this;
+   }
+
+   #if defined(BOOST_MOVE_DOXYGEN_INVOKED)
+   //! <b>Effects</b>: Destroys the active alternative and constructs U
+   //!   in place forwarding args to U's constructor.
+   //!
+   //! <b>Throws</b>: If U's constructor throws *this is left valueless_by_exception().
+   template<class U, class ...Args>
+   U &emplace(Args&&... args);
+   #else
+   #define BOOST_PP_LOCAL_MACRO(n)                                                     \
+   template<class U BOOST_PP_ENUM_TRAILING_PARAMS(n, class P)>                         \
+   U &emplace(BOOST_PP_ENUM(n, BOOST_MOVE_PP_PARAM, _))                                \
+   {                                                                                   \
+      BOOST_STATIC_ASSERT((index_of<U>::value >= 0));                                  \
+      this->priv_destroy();                                                            \
+      U *p = BOOST_MOVE_PP_CONSTRUCT(n, U, &m_storage);                                \
+      m_which = index_of<U>::value;                                                    \
+      return *p;                                                                       \
+   }                                                                                   \
+   //
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_MOVE_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+   #endif
+
+   //! <b>Returns</b>: The zero-based index of the active alternative
+   //!   or -1 if valueless_by_exception().
+   int which() const
+   {  return m_which;  }
+
+   //! <b>Returns</b>: true if a previous assignment or emplace threw
+   //!   and no alternative is active.
+   bool valueless_by_exception() const
+   {  return m_which < 0;  }
+
+   //! <b>Returns</b>: true if U is the active alternative.
+   template<class U>
+   bool holds() const
+   {  return m_which == index_of<U>::value;  }
+
+   //! <b>Returns</b>: A pointer to the active alternative if it's U, null otherwise.
+   template<class U>
+   U *get_if()
+   {  return this->template holds<U>() ? &this->template unsafe_get<U>() : 0;  }
+
+   template<class U>
+   const U *get_if() const
+   {  return this->template holds<U>() ? &this->template unsafe_get<U>() : 0;  }
+
+   //! <b>Returns</b>: A reference to the active alternative.
+   //!
+   //! <b>Throws</b>: bad_variant_access if U is not the active alternative.
+   template<class U>
+   U &get()
+   {
+      if(!this->template holds<U>()){
+         throw bad_variant_access();
+      }
+      return this->template unsafe_get<U>();
+   }
+
+   template<class U>
+   const U &get() const
+   {
+      if(!this->template holds<U>()){
+         throw bad_variant_access();
+      }
+      return this->template unsafe_get<U>();
+   }
+
+   //! <b>Effects</b>: Calls v with the active alternative.
+   //!
+   //! <b>Returns</b>: The value returned by v.
+   //!
+   //! <b>Requires</b>: !valueless_by_exception(). Visitor shall define
+   //!   a nested result_type.
+   template<class Visitor>
+   typename Visitor::result_type apply_visitor(Visitor &v)
+   {  return this->priv_visit(v);  }
+
+   template<class Visitor>
+   typename Visitor::result_type apply_visitor(const Visitor &v)
+   {  return this->priv_visit(v);  }
+
+   /// @cond
+   private:
+
+   template<class U>
+   U &unsafe_get()
+   {  return *static_cast<U*>(static_cast<void*>(&m_storage));  }
+
+   template<class U>
+   const U &unsafe_get() const
+   {  return *static_cast<const U*>(static_cast<const void*>(&m_storage));  }
+
+   #define BOOST_MOVE_VARIANT_VISIT_CASE(z, n, data)                                   \
+      case n:                                                                          \
+         return ::boost::move_detail::variant_visit                                    \
+            <typename Visitor::result_type, T##n>::apply(v, &m_storage);               \
+   //
+
+   template<class Visitor>
+   typename Visitor::result_type priv_visit(Visitor &v)
+   {
+      BOOST_ASSERT(m_which >= 0);
+      switch(m_which){
+         BOOST_PP_REPEAT(BOOST_MOVE_VARIANT_LIMIT_TYPES, BOOST_MOVE_VARIANT_VISIT_CASE, _)
+         default:
+         return ::boost::move_detail::variant_visit
+            <typename Visitor::result_type, ::boost::move_detail::variant_void>::apply(v, &m_storage);
+      }
+   }
+
+   #undef BOOST_MOVE_VARIANT_VISIT_CASE
+
+   void priv_destroy()
+   {
+      if(m_which >= 0){
+         ::boost::move_detail::variant_destroyer d;
+         this->priv_visit(d);
+         m_which = -1;
+      }
+   }
+
+   void priv_copy_construct(const variant &x)
+   {
+      if(x.m_which >= 0){
+         if(traits_t::trivially_copyable){
+            std::memcpy(static_cast<void*>(&m_storage), &x.m_storage, sizeof(storage_t));
+         }
+         else{
+            ::boost::move_detail::variant_copy_constructor c = { &m_storage };
+            const_cast<variant&>(x).priv_visit(c);
+         }
+         m_which = x.m_which;
+      }
+   }
+
+   void priv_move_construct(variant &x)
+   {
+      if(x.m_which >= 0){
+         if(traits_t::trivially_copyable){
+            std::memcpy(static_cast<void*>(&m_storage), &x.m_storage, sizeof(storage_t));
+         }
+         else{
+            ::boost::move_detail::variant_move_constructor c = { &m_storage };
+            x.priv_visit(c);
+         }
+         m_which = x.m_which;
+      }
+   }
+
+   storage_t m_storage;
+   int       m_which;
+   /// @endcond
+};
+
+//! <b>Effects</b>: Calls v with the active alternative of x.
+template<class Visitor, BOOST_MOVE_VARIANT_TEMPLATE_PARAMS>
+typename Visitor::result_type apply_visitor(Visitor &v, variant<BOOST_MOVE_VARIANT_TEMPLATE_ARGS> &x)
+{  return x.apply_visitor(v);  }
+
+template<class Visitor, BOOST_MOVE_VARIANT_TEMPLATE_PARAMS>
+typename Visitor::result_type apply_visitor(const Visitor &v, variant<BOOST_MOVE_VARIANT_TEMPLATE_ARGS> &x)
+{  return x.apply_visitor(v);  }
+
+//! <b>Returns</b>: x.get&lt;U&gt;().
+template<class U, BOOST_MOVE_VARIANT_TEMPLATE_PARAMS>
+U &get(variant<BOOST_MOVE_VARIANT_TEMPLATE_ARGS> &x)
+{  return x.template get<U>();  }
+
+template<class U, BOOST_MOVE_VARIANT_TEMPLATE_PARAMS>
+const U &get(const variant<BOOST_MOVE_VARIANT_TEMPLATE_ARGS> &x)
+{  return x.template get<U>();  }
+
+//! A variant is trivially relocatable if all its alternatives are.
+template<BOOST_MOVE_VARIANT_TEMPLATE_PARAMS>
+struct is_trivially_relocatable< variant<BOOST_MOVE_VARIANT_TEMPLATE_ARGS> >
+{
+   static const bool value =
+      ::boost::move_detail::variant_traits<BOOST_MOVE_VARIANT_TEMPLATE_ARGS>::trivially_relocatable;
+};
+
+}  //namespace movelib {
+
+template<BOOST_MOVE_VARIANT_TEMPLATE_PARAMS>
+struct has_nothrow_move< ::boost::movelib::variant<BOOST_MOVE_VARIANT_TEMPLATE_ARGS> >
+{
+   static const bool value =
+      ::boost::move_detail::variant_traits<BOOST_MOVE_VARIANT_TEMPLATE_ARGS>::nothrow_move;
+};
+
+}  //namespace boost {
+
+#undef BOOST_MOVE_VARIANT_TEMPLATE_PARAMS
+#undef BOOST_MOVE_VARIANT_TEMPLATE_ARGS
+#undef BOOST_MOVE_VARIANT_VOID_ARGS
+#undef BOOST_MOVE_VARIANT_DEFAULT_PARAM
+
+#endif //#ifndef BOOST_MOVE_VARIANT_HPP
@@ -0,0 +1,112 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//! \file
+//! Wait strategies used by the blocking operations of concurrent queues.
+//!
+//! A wait strategy offers three operations:
+//!   - <i>ticket_type prepare_wait()</i>: called before trying an operation
+//!     that might fail because the queue is full or empty.
+//!   - <i>void wait(ticket_type t)</i>: called after the operation failed.
+//!     Returns when notify() might have been called after prepare_wait()
+//!     returned t (spurious returns are allowed).
+//!   - <i>void notify()</i>: called after every successful operation.
+
+#ifndef BOOST_MOVE_WAIT_STRATEGY_HPP
+#define BOOST_MOVE_WAIT_STRATEGY_HPP
+
+#include <boost/move/detail/atomic.hpp>
+#include <boost/move/detail/sync.hpp>
+#include <cstddef>   //std::size_t
+
+namespace boost {
+namespace movelib {
+
+//! Busy waits with a processor pause instruction and yields the
+//! processor after a number of spins. notify() is a no-op, so successful
+//! operations never touch shared state of the strategy. Best when
+//! producers and consumers have dedicated cores.
+class spin_wait
+{
+   public:
+   typedef unsigned ticket_type;
+
+   //! Number of pause instructions executed before yielding.
+   static const unsigned spin_count = 64;
+
+   ticket_type prepare_wait()
+   {  return 0u;  }
+
+   void wait(ticket_type)
+   {
+      for(unsigned i = 0; i != spin_count; ++i){
+         ::boost::move_detail::cpu_relax();
+      }
+      ::boost::move_detail::thread_yield();
+   }
+
+   void notify()
+   {}
+};
+
+//! Puts waiting threads to sleep on a condition variable. Each notify()
+//! increments an epoch counter and only locks the mutex if some thread is
+//! sleeping, so the cost of successful operations is an atomic increment
+//! when nobody waits.
+class blocking_wait
+{
+   blocking_wait(const blocking_wait &);
+   blocking_wait &operator=(const blocking_wait &);
+
+   public:
+   typedef std::size_t ticket_type;
+
+   blocking_wait()
+      : m_epoch(0), m_waiters(0), m_mtx(), m_cv()
+   {}
+
+   ticket_type prepare_wait()
+   {  return m_epoch.load(::boost::move_detail::memory_order_seq_cst);  }
+
+   void wait(ticket_type t)
+   {
+      ::boost::move_detail::scoped_lock lock(m_mtx);
+      m_waiters.fetch_add(1u, ::boost::move_detail::memory_order_seq_cst);
+      while(m_epoch.load(::boost::move_detail::memory_order_seq_cst) == t){
+         m_cv.wait(m_mtx);
+      }
+      m_waiters.fetch_sub(1u, ::boost::move_detail::memory_order_seq_cst);
+   }
+
+   void notify()
+   {
+      m_epoch.fetch_add(1u, ::boost::move_detail::memory_order_seq_cst);
+      //A waiter increments m_waiters before checking the epoch, so either
+      //it sees the new epoch or the notifier sees the waiter.
+      if(m_waiters.load(::boost::move_detail::memory_order_seq_cst)){
+         ::boost::move_detail::scoped_lock lock(m_mtx);
+         m_cv.notify_all();
+      }
+   }
+
+   /// @cond
+   private:
+   ::boost::move_detail::atomic<std::size_t>   m_epoch;
+   ::boost::move_detail::atomic<std::size_t>   m_waiters;
+   ::boost::move_detail::mutex                 m_mtx;
+   ::boost::move_detail::condition_variable    m_cv;
+   /// @endcond
+};
+
+}  //namespace movelib {
+}  //namespace boost {
+
+#endif //#ifndef BOOST_MOVE_WAIT_STRATEGY_HPP
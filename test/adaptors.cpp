@@ -0,0 +1,139 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/adaptors.hpp>
+#include <boost/move/deque.hpp>
+#include <boost/move/small_vector.hpp>
+#include <vector>
+#include "counted_movable.hpp"
+
+//Container that records its reserve() calls
+struct reserving_container
+{
+   typedef counted_movable value_type;
+   typedef std::size_t     size_type;
+
+   boost::movelib::small_vector<counted_movable, 4> v;
+   int reserves;
+   size_type reserved;
+
+   reserving_container() : v(), reserves(0), reserved(0) {}
+
+   size_type size() const {  return v.size();  }
+   void reserve(size_type n) {  ++reserves;  reserved = n;  v.reserve(n);  }
+   void push_back(BOOST_RV_REF(counted_movable) x) {  v.push_back(::boost::move(x));  }
+};
+
+struct is_even
+{
+   bool operator()(int i) const             {  return i % 2 == 0;  }
+   bool operator()(const counted_movable &m) const  {  return m.value() % 2 == 0;  }
+};
+
+//Consumes its argument
+struct plus_one
+{
+   typedef counted_movable result_type;
+
+   counted_movable operator()(BOOST_RV_REF(counted_movable) x) const
+   {
+      counted_movable r(::boost::move(x));
+      r.add(1);
+      return ::boost::move(r);
+   }
+};
+
+struct square
+{
+   typedef int result_type;
+
+   int operator()(int i) const {  return i*i;  }
+};
+
+int main()
+{
+   using namespace ::boost::movelib;
+   using namespace ::boost::movelib::adaptors;
+   //Views of copyable elements are lazy and leave the source alone
+   {
+      std::vector<int> v;
+      for(int i = 0; i != 20; ++i){
+         v.push_back(i);
+      }
+      std::vector<int> out;
+      move_to(v | filtered(is_even()) | transformed(square()), out);
+      if(out.size() != 10 || out[0] != 0 || out[9] != 18*18 || v[18] != 18)
+         return 1;
+      transformed_range<std::vector<int>::iterator, square> t = v | transformed(square());
+      if(t.end() - t.begin() != 20 || t.begin()[3] != 9 || *(t.end() - 1) != 19*19)
+         return 1;
+      const filtered_range<std::vector<int>::const_iterator, is_even> f
+         = static_cast<const std::vector<int>&>(v) | filtered(is_even());
+      int n = 0;
+      for(filtered_range<std::vector<int>::const_iterator, is_even>::iterator it = f.begin(); it != f.end(); ++it){
+         n += *it;
+      }
+      if(n != 90)
+         return 1;
+   }
+   //Moved views: only the selected elements are moved
+   {
+      small_vector<counted_movable, 4> src;
+      for(int i = 0; i != 100; ++i){
+         src.emplace_back(i);
+      }
+      deque<counted_movable> out;
+      move_to(src | boost::adaptors::moved | filtered(is_even()), out);
+      if(out.size() != 50 || out[49].value() != 98)
+         return 1;
+      for(std::size_t i = 0; i != src.size(); ++i){
+         if(src[i].moved() != (i % 2 == 0))
+            return 1;
+      }
+   }
+   if(counted_movable::live != 0)
+      return 1;
+   //Filter, then consume the selected elements in the transformation
+   {
+      small_vector<counted_movable, 4> src;
+      for(int i = 0; i != 100; ++i){
+         src.emplace_back(i);
+      }
+      reserving_container out;
+      move_to(src | boost::adaptors::moved | filtered(is_even()) | transformed(plus_one()), out);
+      //The size of a filtered view is unknown
+      if(out.reserves != 0 || out.size() != 50 || out.v[0].value() != 1 || out.v[49].value() != 99)
+         return 1;
+      for(std::size_t i = 0; i != src.size(); ++i){
+         if(src[i].moved() != (i % 2 == 0))
+            return 1;
+      }
+      //Random access views reserve once
+      src.clear();
+      for(int i = 0; i != 100; ++i){
+         src.emplace_back(i);
+      }
+      reserving_container all;
+      move_to(src | boost::adaptors::moved, all);
+      if(all.reserves != 1 || all.reserved != 100 || all.size() != 100 || all.v[1].value() != 1)
+         return 1;
+      reserving_container plus;
+      move_to(all.v | boost::adaptors::moved | transformed(plus_one()), plus);
+      if(plus.reserves != 1 || plus.reserved != 100 || plus.v[99].value() != 100)
+         return 1;
+      for(std::size_t i = 0; i != all.size(); ++i){
+         if(!all.v[i].moved())
+            return 1;
+      }
+   }
+   if(counted_movable::live != 0)
+      return 1;
+   return 0;
+}
@@ -0,0 +1,402 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/algorithm.hpp>
+#include <boost/move/deque.hpp>
+#include <boost/move/relocate.hpp>
+#include <boost/move/small_vector.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <list>
+#include <string>
+#include <vector>
+#include "counted_movable.hpp"
+
+//Copyable and movable accumulator that counts its copies
+class buffer
+{
+   BOOST_COPYABLE_AND_MOVABLE(buffer)
+   std::vector<int> v_;
+
+   public:
+   static int copies;
+
+   buffer() {}
+   buffer(const buffer &x) : v_(x.v_) {  ++copies;  }
+   buffer(BOOST_RV_REF(buffer) x) {  v_.swap(x.v_);  }
+
+   buffer &operator=(BOOST_COPY_ASSIGN_REF(buffer) x)
+   {
+      v_ = x.v_;
+      ++copies;
+      return *this;
+   }
+
+   buffer &operator=(BOOST_RV_REF(buffer) x)
+   {
+      v_.swap(x.v_);
+      x.v_.clear();
+      return *this;
+   }
+
+   void push_back(int i)         {  v_.push_back(i);  }
+   std::size_t size() const      {  return v_.size();  }
+   int operator[](std::size_t i) const {  return v_[i];  }
+};
+
+int buffer::copies = 0;
+
+struct append_int
+{
+   buffer operator()(BOOST_RV_REF(buffer) acc, int i) const
+   {
+      acc.push_back(i);
+      return ::boost::move(acc);
+   }
+};
+
+//Consumes the appended buffer
+struct concat
+{
+   buffer operator()(BOOST_RV_REF(buffer) acc, BOOST_RV_REF(buffer) x) const
+   {
+      const buffer tail(::boost::move(x));
+      for(std::size_t i = 0; i != tail.size(); ++i){
+         acc.push_back(tail[i]);
+      }
+      return ::boost::move(acc);
+   }
+};
+
+struct counted_odd
+{
+   int *calls;
+   bool operator()(int i) const           {  ++*calls;  return (i % 2) != 0;  }
+   bool operator()(const counted_movable &m) const {  ++*calls;  return (m.value() % 2) != 0;  }
+};
+
+struct same_tens
+{
+   int *calls;
+   bool operator()(int a, int b) const {  ++*calls;  return a/10 == b/10;  }
+   bool operator()(const counted_movable &a, const counted_movable &b) const
+   {  ++*calls;  return a.value()/10 == b.value()/10;  }
+};
+
+struct by_tens
+{
+   bool operator()(int a, int b) const {  return a/10 < b/10;  }
+};
+
+//Runs the move and uninitialized variants of a set operation and the
+//standard one on copies of the inputs and compares the results
+#define CHECK_SET_OP(NAME, A, B)                                                          \
+   {                                                                                      \
+      std::vector<int> a1(A), b1(B), out1(A.size() + B.size());                           \
+      std::vector<int> out2(out1.size());                                                 \
+      const std::ptrdiff_t n = NAME##_move(a1.begin(), a1.end(), b1.begin(), b1.end()     \
+                                          , out1.begin(), by_tens()) - out1.begin();      \
+      const std::ptrdiff_t n2 = std::NAME(A.begin(), A.end(), B.begin(), B.end()          \
+                                         , out2.begin(), by_tens()) - out2.begin();       \
+      if(n != n2 || !std::equal(out1.begin(), out1.begin() + n, out2.begin()))            \
+         return 1;                                                                        \
+      std::vector<int> a2(A), b2(B), out3(out1.size() + 1);                               \
+      if(uninitialized_##NAME##_move(a2.begin(), a2.end(), b2.begin(), b2.end()           \
+                                    , &out3[0], by_tens()) != &out3[0] + n                \
+         || !std::equal(out1.begin(), out1.begin() + n, out3.begin()))                    \
+         return 1;                                                                        \
+   }                                                                                      \
+   //
+
+int main()
+{
+   using namespace ::boost::movelib;
+   std::srand(5);
+   //Random inputs compared with the standard algorithms
+   for(int round = 0; round != 200; ++round){
+      std::vector<int> v(std::size_t(std::rand() % 300));
+      for(std::size_t i = 0; i != v.size(); ++i){
+         v[i] = std::rand() % 100;
+      }
+      {
+         std::vector<int> a(v), b(v);
+         int calls = 0;
+         counted_odd pred = { &calls };
+         const std::ptrdiff_t n = ::boost::movelib::remove_if(a.begin(), a.end(), pred) - a.begin();
+         if(n != std::remove_if(b.begin(), b.end(), pred) - b.begin() || !std::equal(a.begin(), a.begin() + n, b.begin()))
+            return 1;
+         //Each element tested once by each algorithm
+         if(calls != 2*int(v.size()))
+            return 1;
+      }
+      {
+         std::vector<int> a(v), b(v);
+         int calls = 0;
+         same_tens pred = { &calls };
+         const std::ptrdiff_t n = ::boost::movelib::unique(a.begin(), a.end(), pred) - a.begin();
+         if(n != std::unique(b.begin(), b.end(), pred) - b.begin() || !std::equal(a.begin(), a.begin() + n, b.begin()))
+            return 1;
+         if(calls != (v.empty() ? 0 : 2*(int(v.size()) - 1)))
+            return 1;
+      }
+      {
+         std::vector<int> a(v), b(v);
+         const std::ptrdiff_t n = ::boost::movelib::unique(a.begin(), a.end()) - a.begin();
+         if(n != std::unique(b.begin(), b.end()) - b.begin() || !std::equal(a.begin(), a.begin() + n, b.begin()))
+            return 1;
+      }
+      //Segmented iterators
+      {
+         deque<int> d;
+         std::vector<int> b(v);
+         for(std::size_t i = 0; i != v.size(); ++i){
+            if(i % 2){
+               d.push_back(v[i]);
+            }
+            else{
+               d.push_front(v[i]);
+            }
+         }
+         b.assign(d.begin(), d.end());
+         int calls = 0;
+         counted_odd pred = { &calls };
+         const std::size_t erased = erase_if(d, pred);
+         b.erase(std::remove_if(b.begin(), b.end(), pred), b.end());
+         if(erased != v.size() - b.size() || d.size() != b.size() || !std::equal(b.begin(), b.end(), d.begin()))
+            return 1;
+      }
+      //Forward iterators
+      {
+         std::list<int> l(v.begin(), v.end());
+         std::vector<int> b(v);
+         erase_unique(l);
+         b.erase(std::unique(b.begin(), b.end()), b.end());
+         if(l.size() != b.size() || !std::equal(b.begin(), b.end(), l.begin()))
+            return 1;
+      }
+   }
+   //Set operations with a coarse comparison: equivalent elements differ,
+   //so the results show which side's element was taken
+   for(int round = 0; round != 200; ++round){
+      std::vector<int> a(std::size_t(std::rand() % 40)), b(std::size_t(std::rand() % 40));
+      for(std::size_t i = 0; i != a.size(); ++i){
+         a[i] = std::rand() % 200;
+      }
+      for(std::size_t i = 0; i != b.size(); ++i){
+         b[i] = std::rand() % 200;
+      }
+      std::sort(a.begin(), a.end(), by_tens());
+      std::sort(b.begin(), b.end(), by_tens());
+      CHECK_SET_OP(set_union, a, b)
+      CHECK_SET_OP(set_intersection, a, b)
+      CHECK_SET_OP(set_difference, a, b)
+      CHECK_SET_OP(set_symmetric_difference, a, b)
+   }
+   //Movable-only set operations: only the output elements are moved
+   {
+      const int va[] = { 1, 2, 2, 4 };
+      const int vb[] = { 2, 3, 4, 4 };
+      small_vector<counted_movable, 4> a, b, out;
+      for(std::size_t i = 0; i != 4; ++i){
+         a.emplace_back(va[i]);
+         b.emplace_back(vb[i]);
+      }
+      set_union_move(a.begin(), a.end(), b.begin(), b.end(), ::boost::back_move_inserter(out));
+      const int expected[] = { 1, 2, 2, 3, 4, 4 };
+      if(out.size() != 6)
+         return 1;
+      for(std::size_t i = 0; i != out.size(); ++i){
+         if(out[i].value() != expected[i])
+            return 1;
+      }
+      for(std::size_t i = 0; i != a.size(); ++i){
+         if(!a[i].moved())
+            return 1;
+      }
+      if(b[0].moved() || !b[1].moved() || b[2].moved() || !b[3].moved())
+         return 1;
+      //Symmetric difference into raw storage
+      small_vector<counted_movable, 4> c, d;
+      for(std::size_t i = 0; i != 4; ++i){
+         c.emplace_back(vb[i]);
+         d.emplace_back(va[i]);
+      }
+      void *raw = ::operator new(8*sizeof(counted_movable));
+      counted_movable *const buf = static_cast<counted_movable*>(raw);
+      counted_movable *const buf_end = uninitialized_set_symmetric_difference_move
+         (c.begin(), c.end(), d.begin(), d.end(), buf);
+      const int sym[] = { 1, 2, 3, 4 };
+      if(buf_end - buf != 4)
+         return 1;
+      for(int i = 0; i != 4; ++i){
+         if(buf[i].value() != sym[i])
+            return 1;
+      }
+      if(c[0].moved() || !c[1].moved() || c[2].moved() || !c[3].moved())
+         return 1;
+      ::boost::movelib::destroy(buf, buf_end);
+      ::operator delete(raw);
+   }
+   if(counted_movable::live != 0)
+      return 1;
+   //Selection compared with sorting, with few and many distinct values
+   for(int round = 0; round != 300; ++round){
+      std::vector<int> v(std::size_t(std::rand() % 500));
+      const int distinct = round % 3 ? 1000 : 5;
+      for(std::size_t i = 0; i != v.size(); ++i){
+         v[i] = std::rand() % distinct;
+      }
+      if(round % 7 == 0){
+         std::sort(v.begin(), v.end());
+      }
+      else if(round % 7 == 1){
+         std::sort(v.begin(), v.end(), std::greater<int>());
+      }
+      std::vector<int> sorted(v);
+      std::sort(sorted.begin(), sorted.end());
+      const std::size_t m = v.empty() ? 0u : std::size_t(std::rand()) % (v.size() + 1);
+      {
+         std::vector<int> a(v);
+         ::boost::movelib::partial_sort(a.begin(), a.begin() + std::ptrdiff_t(m), a.end());
+         if(!std::equal(a.begin(), a.begin() + std::ptrdiff_t(m), sorted.begin()))
+            return 1;
+         std::sort(a.begin(), a.end());
+         if(a != sorted)
+            return 1;
+      }
+      if(m != v.size()){
+         std::vector<int> a(v);
+         const std::vector<int>::iterator nth = a.begin() + std::ptrdiff_t(m);
+         ::boost::movelib::nth_element(a.begin(), nth, a.end());
+         if(*nth != sorted[m])
+            return 1;
+         for(std::vector<int>::iterator it = a.begin(); it != a.end(); ++it){
+            if(it < nth ? *nth < *it : *it < *nth)
+               return 1;
+         }
+         std::sort(a.begin(), a.end());
+         if(a != sorted)
+            return 1;
+      }
+      {
+         std::list<int> l(v.begin(), v.end());
+         std::vector<int> out;
+         top_k(l.begin(), l.end(), m, std::back_inserter(out), std::greater<int>());
+         if(out.size() != m || !std::equal(out.begin(), out.end(), sorted.rbegin()))
+            return 1;
+      }
+   }
+   //Movable-only selection
+   {
+      small_vector<counted_movable, 4> v;
+      for(int i = 0; i != 200; ++i){
+         v.emplace_back((i*37) % 200);
+      }
+      ::boost::movelib::partial_sort(v.begin(), v.begin() + 10, v.end());
+      for(int i = 0; i != 10; ++i){
+         if(v[std::size_t(i)].value() != i)
+            return 1;
+      }
+      ::boost::movelib::nth_element(v.begin(), v.begin() + 150, v.end());
+      if(v[150].value() != 150)
+         return 1;
+      for(std::size_t i = 0; i != v.size(); ++i){
+         if(v[i].moved() || (i < 150 ? v[i].value() > 150 : v[i].value() < 150))
+            return 1;
+      }
+      //Only the winners are moved
+      deque<counted_movable> l;
+      for(int i = 0; i != 300; ++i){
+         l.emplace_back((i*7) % 300);
+      }
+      small_vector<counted_movable, 4> best;
+      top_k(l.begin(), l.end(), 5u, ::boost::back_move_inserter(best), std::greater<counted_movable>());
+      if(best.size() != 5)
+         return 1;
+      for(std::size_t i = 0; i != best.size(); ++i){
+         if(best[i].value() != 299 - int(i))
+            return 1;
+      }
+      int moved = 0;
+      for(deque<counted_movable>::const_iterator it = l.begin(); it != l.end(); ++it){
+         if(it->moved()){
+            if(it->value() != -1)
+               return 1;
+            ++moved;
+         }
+      }
+      if(moved != 5 || top_k(l.begin(), l.end(), 0u, best.begin()) != best.begin())
+         return 1;
+   }
+   if(counted_movable::live != 0)
+      return 1;
+   //Folds: the accumulator is never copied
+   {
+      std::vector<int> v;
+      for(int i = 0; i != 1000; ++i){
+         v.push_back(i);
+      }
+      if(::boost::movelib::accumulate(v.begin(), v.end(), 0) != 999*1000/2)
+         return 1;
+      buffer init;
+      init.push_back(-1);
+      //init is copied once into the by value parameter
+      const buffer r = ::boost::movelib::accumulate(v.begin(), v.end(), init, append_int());
+      if(buffer::copies != 1 || r.size() != 1001 || r[0] != -1 || r[1000] != 999)
+         return 1;
+      const buffer r2 = fold_left(v.begin(), v.end(), buffer(), append_int());
+      if(buffer::copies != 1 || r2.size() != 1000 || r2[999] != 999)
+         return 1;
+      std::vector<std::string> lines(100, std::string("line\n"));
+      const std::string text = ::boost::movelib::accumulate(lines.begin(), lines.end(), std::string());
+      if(text.size() != 500 || text.compare(495, 5, "line\n") != 0)
+         return 1;
+      if(move_reduce(lines.begin(), lines.end(), std::string("> ")).size() != 502)
+         return 1;
+      //move_reduce consumes the elements
+      std::vector<buffer> parts(10);
+      for(std::size_t i = 0; i != parts.size(); ++i){
+         parts[i].push_back(int(i));
+         parts[i].push_back(int(i));
+      }
+      buffer::copies = 0;
+      const buffer all = move_reduce(parts.begin(), parts.end(), buffer(), concat());
+      if(buffer::copies != 0 || all.size() != 20 || all[19] != 9)
+         return 1;
+      for(std::size_t i = 0; i != parts.size(); ++i){
+         if(parts[i].size() != 0)
+            return 1;
+      }
+   }
+   //Movable-only elements
+   {
+      small_vector<counted_movable, 4> v;
+      const int values[] = { 1, 2, 4, 3, 5, 6, 8, 10, 11, 12, 13, 14 };
+      for(std::size_t i = 0; i != sizeof(values)/sizeof(values[0]); ++i){
+         v.emplace_back(values[i]);
+      }
+      int calls = 0;
+      counted_odd pred = { &calls };
+      if(erase_if(v, pred) != 5 || v.size() != 7)
+         return 1;
+      const int expected[] = { 2, 4, 6, 8, 10, 12, 14 };
+      for(std::size_t i = 0; i != v.size(); ++i){
+         if(v[i].value() != expected[i])
+            return 1;
+      }
+      same_tens eq = { &calls };
+      if(erase_unique(v, eq) != 5 || v.size() != 2 || v[0].value() != 2 || v[1].value() != 10)
+         return 1;
+      v.clear();
+   }
+   if(counted_movable::live != 0)
+      return 1;
+   return 0;
+}
@@ -0,0 +1,151 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/allocator_traits.hpp>
+#include <boost/move/monotonic_arena.hpp>
+#include <vector>
+#include <list>
+#include <memory>
+
+//Stateful allocator that propagates on move assignment and swap
+template<class T>
+class propagating_allocator
+   : public std::allocator<T>
+{
+   public:
+   //Standard containers dispatch on std::true_type/false_type. The
+   //nested types of std::allocator are hidden as it's always equal
+   #if defined(BOOST_NO_RVALUE_REFERENCES)
+   typedef ::boost::true_type    propagate_on_container_move_assignment;
+   typedef ::boost::true_type    propagate_on_container_swap;
+   typedef ::boost::false_type   is_always_equal;
+   #else
+   typedef std::true_type        propagate_on_container_move_assignment;
+   typedef std::true_type        propagate_on_container_swap;
+   typedef std::false_type       is_always_equal;
+   #endif
+
+   template<class U>
+   struct rebind
+   {  typedef propagating_allocator<U> other;  };
+
+   explicit propagating_allocator(int id = 0) : id_(id) {}
+
+   template<class U>
+   propagating_allocator(const propagating_allocator<U> &o) : std::allocator<T>(), id_(o.id()) {}
+
+   int id() const {  return id_;  }
+
+   private:
+   int id_;
+};
+
+template<class T, class U>
+bool operator==(const propagating_allocator<T> &a, const propagating_allocator<U> &b)
+{  return a.id() == b.id();  }
+
+template<class T, class U>
+bool operator!=(const propagating_allocator<T> &a, const propagating_allocator<U> &b)
+{  return a.id() != b.id();  }
+
+template<class Container>
+void fill(Container &c, int first, int n)
+{
+   for(int i = 0; i != n; ++i){
+      c.push_back(first + i);
+   }
+}
+
+template<class Container>
+bool check(const Container &c, int first, int n)
+{
+   if(c.size() != static_cast<std::size_t>(n))
+      return false;
+   typename Container::const_iterator it = c.begin();
+   for(int i = 0; i != n; ++i, ++it){
+      if(*it != first + i)
+         return false;
+   }
+   return true;
+}
+
+int main()
+{
+   using namespace boost::movelib;
+   //Traits
+   if(!allocator_traits< std::allocator<int> >::is_always_equal::value)
+      return 1;
+   if(allocator_traits< arena_allocator<int> >::is_always_equal::value ||
+      allocator_traits< arena_allocator<int> >::propagate_on_container_move_assignment::value)
+      return 1;
+   if(!allocator_traits< propagating_allocator<int> >::propagate_on_container_move_assignment::value ||
+      !allocator_traits< propagating_allocator<int> >::propagate_on_container_swap::value ||
+      allocator_traits< propagating_allocator<int> >::propagate_on_container_copy_assignment::value ||
+      allocator_traits< propagating_allocator<int> >::is_always_equal::value)
+      return 1;
+   //Equal allocators: the memory is stolen
+   {
+      std::vector<int> src, dst;
+      fill(src, 0, 10);
+      fill(dst, 100, 3);
+      const int *const data = &src[0];
+      move_assign_container(dst, boost::move(src));
+      if(!check(dst, 0, 10) || &dst[0] != data || !src.empty())
+         return 1;
+   }
+   {
+      monotonic_arena arena;
+      typedef std::vector<int, arena_allocator<int> > vector_t;
+      vector_t src((arena_allocator<int>(arena))), dst((arena_allocator<int>(arena)));
+      fill(src, 0, 10);
+      const int *const data = &src[0];
+      move_assign_container(dst, boost::move(src));
+      if(!check(dst, 0, 10) || &dst[0] != data)
+         return 1;
+   }
+   //Propagating allocators: the memory and the allocator are stolen
+   {
+      typedef std::vector<int, propagating_allocator<int> > vector_t;
+      vector_t src((propagating_allocator<int>(1))), dst((propagating_allocator<int>(2)));
+      fill(src, 0, 10);
+      const int *const data = &src[0];
+      move_assign_container(dst, boost::move(src));
+      if(!check(dst, 0, 10) || &dst[0] != data || dst.get_allocator().id() != 1)
+         return 1;
+   }
+   //Unequal allocators: element-wise move, dst keeps its arena
+   {
+      monotonic_arena arena1, arena2;
+      typedef std::vector<int, arena_allocator<int> > vector_t;
+      vector_t src((arena_allocator<int>(arena1))), dst((arena_allocator<int>(arena2)));
+      fill(src, 0, 10);
+      fill(dst, 100, 3);
+      move_assign_container(dst, boost::move(src));
+      if(!check(dst, 0, 10) || &dst.get_allocator().arena() != &arena2)
+         return 1;
+      //Shrinking
+      vector_t src2((arena_allocator<int>(arena1)));
+      fill(src2, 50, 4);
+      move_assign_container(dst, boost::move(src2));
+      if(!check(dst, 50, 4) || &dst.get_allocator().arena() != &arena2)
+         return 1;
+   }
+   {
+      monotonic_arena arena1, arena2;
+      typedef std::list<int, arena_allocator<int> > list_t;
+      list_t src((arena_allocator<int>(arena1))), dst((arena_allocator<int>(arena2)));
+      fill(src, 0, 7);
+      fill(dst, 100, 2);
+      move_assign_container(dst, boost::move(src));
+      if(!check(dst, 0, 7) || &dst.get_allocator().arena() != &arena2)
+         return 1;
+   }
+   return 0;
+}
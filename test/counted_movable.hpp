@@ -0,0 +1,72 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#ifndef BOOST_MOVE_TEST_COUNTED_MOVABLE_HPP
+#define BOOST_MOVE_TEST_COUNTED_MOVABLE_HPP
+
+#include <boost/move/move.hpp>
+
+//Base that counts the live objects of T. The counter is a static member
+//of a class template, so this header can be included by several tests.
+template<class T>
+class live_counted
+{
+   public:
+   static int live;
+
+   protected:
+   live_counted()                     {  ++live;  }
+   live_counted(const live_counted &) {  ++live;  }
+   ~live_counted()                    {  --live;  }
+};
+
+template<class T>
+int live_counted<T>::live = 0;
+
+//Movable-only type that owns heap memory, so that leaks and double
+//destructions show up, and counts its live objects
+class counted_movable
+   : public live_counted<counted_movable>
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(counted_movable)
+   int *p_;
+   int tag_;
+
+   public:
+   explicit counted_movable(int v = 0, int tag = 0) : p_(new int(v)), tag_(tag) {}
+   ~counted_movable() {  delete p_;  }
+
+   counted_movable(BOOST_RV_REF(counted_movable) x)
+      : live_counted<counted_movable>(), p_(x.p_), tag_(x.tag_)
+   {  x.p_ = 0;  }
+
+   counted_movable &operator=(BOOST_RV_REF(counted_movable) x)
+   {
+      delete p_;
+      p_ = x.p_;
+      tag_ = x.tag_;
+      x.p_ = 0;
+      return *this;
+   }
+
+   bool moved() const {  return !p_;  }
+   int value() const  {  return p_ ? *p_ : -1;  }
+   //Travels with the value: shows the order of equivalent elements
+   int tag() const    {  return tag_;  }
+   void add(int i)    {  *p_ += i;  }
+
+   friend bool operator<(const counted_movable &a, const counted_movable &b)
+   {  return a.value() < b.value();  }
+
+   friend bool operator>(const counted_movable &a, const counted_movable &b)
+   {  return b < a;  }
+};
+
+#endif //BOOST_MOVE_TEST_COUNTED_MOVABLE_HPP
@@ -0,0 +1,212 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/deque.hpp>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+#include "counted_movable.hpp"
+
+template<class Deque>
+bool check_values(const Deque &d, const std::deque<int> &ref)
+{
+   if(d.size() != ref.size() || std::size_t(d.end() - d.begin()) != ref.size())
+      return false;
+   typename Deque::const_iterator it = d.begin();
+   for(std::size_t i = 0; i != ref.size(); ++i, ++it){
+      if(it->value() != ref[i] || d[i].value() != ref[i])
+         return false;
+   }
+   return it == d.end();
+}
+
+bool check_ints(const boost::movelib::deque<int> &d, const std::deque<int> &ref)
+{
+   if(d.size() != ref.size())
+      return false;
+   for(std::size_t i = 0; i != ref.size(); ++i){
+      if(d[i] != ref[i])
+         return false;
+   }
+   return true;
+}
+
+int main()
+{
+   using namespace ::boost::movelib;
+   typedef deque<int>::iterator int_it;
+   const int bs = int(deque<int>::block_size);
+   //Iterator arithmetic across blocks
+   {
+      deque<int> d;
+      if(!d.empty() || d.begin() != d.end() || d.end() - d.begin() != 0)
+         return 1;
+      for(int i = 0; i != 5*bs; ++i){
+         d.push_back(i);
+         d.push_front(-i - 1);
+      }
+      if(d.size() != std::size_t(10*bs) || d.front() != -5*bs || d.back() != 5*bs - 1)
+         return 1;
+      const int_it b = d.begin();
+      for(int i = 0; i < 10*bs; i += 7){
+         for(int j = 0; j < 10*bs; j += 13){
+            const int_it x = b + i;
+            const int_it y = b + j;
+            if(y - x != j - i || *(x + (j - i)) != *y || (x < y) != (i < j))
+               return 1;
+            int_it z = y;
+            z -= j - i;
+            if(z != x)
+               return 1;
+         }
+      }
+      int_it e = d.end();
+      --e;
+      if(*e != 5*bs - 1 || e + 1 != d.end())
+         return 1;
+   }
+   //Movable-only elements: insertion and erasure in both halves
+   {
+      deque<counted_movable> d;
+      std::deque<int> ref;
+      std::srand(1);
+      for(int i = 0; i != 4000; ++i){
+         const int r = std::rand() % 7;
+         const std::size_t pos = ref.empty() ? 0 : std::size_t(std::rand()) % (ref.size() + 1);
+         if(r == 0){
+            counted_movable m(i);
+            d.push_back(::boost::move(m));
+            if(!m.moved())
+               return 1;
+            ref.push_back(i);
+         }
+         else if(r == 1){
+            d.emplace_front(i);
+            ref.push_front(i);
+         }
+         else if(r == 2 || r == 3){
+            counted_movable m(i);
+            deque<counted_movable>::iterator it = d.insert(d.begin() + std::ptrdiff_t(pos), ::boost::move(m));
+            if(it->value() != i)
+               return 1;
+            ref.insert(ref.begin() + std::ptrdiff_t(pos), i);
+         }
+         else if(r == 4 && !ref.empty()){
+            const std::size_t p = pos % ref.size();
+            deque<counted_movable>::iterator it = d.erase(d.begin() + std::ptrdiff_t(p));
+            ref.erase(ref.begin() + std::ptrdiff_t(p));
+            if(it - d.begin() != std::ptrdiff_t(p))
+               return 1;
+         }
+         else if(r == 5 && !ref.empty()){
+            const std::size_t p = pos % ref.size();
+            const std::size_t n = std::size_t(std::rand()) % (ref.size() - p + 1);
+            d.erase(d.begin() + std::ptrdiff_t(p), d.begin() + std::ptrdiff_t(p + n));
+            ref.erase(ref.begin() + std::ptrdiff_t(p), ref.begin() + std::ptrdiff_t(p + n));
+         }
+         else if(!ref.empty()){
+            if(i % 2){
+               d.pop_back();
+               ref.pop_back();
+            }
+            else{
+               d.pop_front();
+               ref.pop_front();
+            }
+         }
+         if(!check_values(d, ref))
+            return 1;
+      }
+      deque<counted_movable> d2(::boost::move(d));
+      if(!d.empty() || !check_values(d2, ref))
+         return 1;
+      d = ::boost::move(d2);
+      if(!d2.empty() || !check_values(d, ref))
+         return 1;
+      d.swap(d2);
+      if(!d.empty() || !check_values(d2, ref))
+         return 1;
+      d2.clear();
+      if(!d2.empty() || counted_movable::live != 0)
+         return 1;
+      d2.emplace_back(3);
+      if(d2.size() != 1 || d2.front().value() != 3)
+         return 1;
+   }
+   if(counted_movable::live != 0)
+      return 1;
+   //Segmented move and move_backward
+   {
+      deque<int> d;
+      std::deque<int> ref;
+      for(int i = 0; i != 3*bs + 5; ++i){
+         d.push_back(i);
+         ref.push_back(i);
+      }
+      //deque -> contiguous
+      std::vector<int> v(d.size());
+      if(::boost::move(d.begin() + 3, d.end(), &v[0]) != &v[0] + (d.size() - 3))
+         return 1;
+      for(std::size_t i = 0; i != d.size() - 3; ++i){
+         if(v[i] != int(i) + 3)
+            return 1;
+      }
+      //contiguous -> deque
+      for(std::size_t i = 0; i != v.size(); ++i){
+         v[i] = -int(i);
+      }
+      int_it r = ::boost::move(&v[0], &v[0] + 2*bs, d.begin() + 1);
+      if(r != d.begin() + (2*bs + 1))
+         return 1;
+      for(int i = 0; i != 2*bs; ++i){
+         ref[std::size_t(i + 1)] = -i;
+      }
+      if(!check_ints(d, ref))
+         return 1;
+      //deque -> deque, both directions with overlap
+      r = ::boost::move(d.begin() + bs/2, d.end(), d.begin() + 1);
+      std::copy(ref.begin() + bs/2, ref.end(), ref.begin() + 1);
+      if(r != d.end() - (bs/2 - 1) || !check_ints(d, ref))
+         return 1;
+      r = ::boost::move_backward(d.begin(), d.end() - bs, d.end());
+      std::copy_backward(ref.begin(), ref.end() - bs, ref.end());
+      if(r != d.begin() + bs || !check_ints(d, ref))
+         return 1;
+      //contiguous -> deque backwards, ending at a block boundary
+      for(std::size_t i = 0; i != v.size(); ++i){
+         v[i] = int(i)*10;
+      }
+      r = ::boost::move_backward(&v[0], &v[0] + bs + 3, d.begin() + 2*bs);
+      std::copy_backward(v.begin(), v.begin() + bs + 3, ref.begin() + 2*bs);
+      if(r != d.begin() + (bs - 3) || !check_ints(d, ref))
+         return 1;
+      //deque -> contiguous backwards
+      std::vector<int> w(d.size());
+      ::boost::move_backward(d.begin(), d.end(), &w[0] + w.size());
+      for(std::size_t i = 0; i != w.size(); ++i){
+         if(w[i] != ref[i])
+            return 1;
+      }
+      //Copy assignment and copy construction
+      deque<int> c(d);
+      if(!check_ints(c, ref))
+         return 1;
+      deque<int> small(3);
+      small = d;
+      if(!check_ints(small, ref))
+         return 1;
+      d.resize(5);
+      c = d;
+      ref.resize(5);
+      if(!check_ints(c, ref) || c.at(4) != ref[4])
+         return 1;
+   }
+   return 0;
+}
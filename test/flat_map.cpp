@@ -0,0 +1,82 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/flat_map.hpp>
+#include <boost/move/small_vector.hpp>
+#include <map>
+#include <vector>
+#include "../example/movable.hpp"
+
+int main()
+{
+   using boost::movelib::flat_map;
+   using boost::movelib::pair;
+   {
+      flat_map<int, int> m;
+      m[3] = 30;
+      m[1] = 10;
+      ++m[2];
+      if(m.size() != 3 || m.at(1) != 10 || m[2] != 1 || m.begin()->first != 1)
+         return 1;
+      if(m.insert(pair<int, int>(3, 0)).second || m[3] != 30)
+         return 1;
+      bool thrown = false;
+      try{
+         m.at(4);
+      }
+      catch(std::out_of_range &){
+         thrown = true;
+      }
+      if(!thrown)
+         return 1;
+   }
+   //Batches against std::map, existing keys keep their value
+   {
+      flat_map<int, int> m;
+      std::map<int, int> ref;
+      unsigned seed = 777u;
+      for(int round = 0; round != 40; ++round){
+         std::vector< pair<int, int> > batch;
+         for(int i = 0, n = round % 5 * 17; i != n; ++i){
+            seed = seed*1103515245u + 12345u;
+            const int k = static_cast<int>((seed >> 8) % 500u);
+            batch.push_back(pair<int, int>(k, round));
+            ref.insert(std::pair<int, int>(k, round));
+         }
+         m.insert_batch(batch.begin(), batch.end());
+         if(m.size() != ref.size())
+            return 1;
+      }
+      std::map<int, int>::const_iterator r = ref.begin();
+      for(flat_map<int, int>::const_iterator i = m.begin(); i != m.end(); ++i, ++r){
+         if(i->first != r->first || i->second != r->second)
+            return 1;
+      }
+   }
+   //Movable-only mapped values
+   {
+      typedef pair<int, movable> value_t;
+      typedef flat_map<int, movable, std::less<int>, boost::movelib::small_vector<value_t, 4> > map_t;
+      map_t m;
+      m[5];
+      value_t batch[3];
+      for(int i = 0; i != 3; ++i){
+         batch[i].first = 4 - i*2;
+      }
+      m.insert_batch(boost::make_move_iterator(&batch[0]), boost::make_move_iterator(batch + 3));
+      if(m.size() != 4 || m.begin()->first != 0 || !batch[0].second.moved())
+         return 1;
+      map_t m2;
+      m2 = boost::move(m);
+      if(!m.empty() || m2.size() != 4 || m2.find(5) == m2.end())
+         return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,121 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/flat_set.hpp>
+#include <boost/move/small_vector.hpp>
+#include <set>
+#include <vector>
+#include "counted_movable.hpp"
+
+template<class Set>
+bool is_sorted_unique(const Set &s)
+{
+   typename Set::const_iterator i = s.begin();
+   if(i == s.end())
+      return true;
+   for(typename Set::const_iterator prev = i++; i != s.end(); prev = i++){
+      if(!(*prev < *i))
+         return false;
+   }
+   return true;
+}
+
+int main()
+{
+   using boost::movelib::flat_set;
+   using boost::movelib::small_vector;
+   //Single element operations
+   {
+      flat_set<int> s;
+      if(!s.insert(3).second || !s.insert(1).second || s.insert(3).second || !s.insert(2).second)
+         return 1;
+      if(s.size() != 3 || *s.begin() != 1 || !s.count(2) || s.count(4) || s.find(4) != s.end())
+         return 1;
+      if(*s.lower_bound(2) != 2 || *s.upper_bound(2) != 3 || s.equal_range(2).second != s.find(3))
+         return 1;
+      if(s.erase(2) != 1 || s.erase(2) != 0)
+         return 1;
+      const flat_set<int>::iterator next = s.erase(s.begin());
+      if(next != s.find(3) || s.size() != 1)
+         return 1;
+   }
+   //Batches against std::set
+   {
+      flat_set<int> s;
+      std::set<int> ref;
+      unsigned seed = 12345u;
+      for(int round = 0; round != 50; ++round){
+         std::vector<int> batch;
+         for(int i = 0, n = round % 7 * 13; i != n; ++i){
+            seed = seed*1103515245u + 12345u;
+            const int v = static_cast<int>((seed >> 8) % 1000u);
+            batch.push_back(v);
+            ref.insert(v);
+         }
+         s.insert_batch(batch.begin(), batch.end());
+         if(s.size() != ref.size() || !is_sorted_unique(s))
+            return 1;
+      }
+      if(!std::equal(s.begin(), s.end(), ref.begin()))
+         return 1;
+      //Appending greater elements only pushes them back
+      const int greater[] = { 2000, 1999, 2001 };
+      s.insert_batch(greater, greater + 3);
+      if(s.size() != ref.size() + 3 || !is_sorted_unique(s) || *(s.end() - 1) != 2001)
+         return 1;
+   }
+   //Movable-only keys are moved from the batch
+   {
+      typedef flat_set<counted_movable, std::less<counted_movable>, small_vector<counted_movable, 8> > set_t;
+      set_t s;
+      counted_movable k1(10), k2(5);
+      s.insert(boost::move(k1));
+      s.insert(boost::move(k2));
+      if(k1.value() != -1 || s.size() != 2)
+         return 1;
+      const int values[6] = { 7, 1, 10, 12, 7, 3 };
+      counted_movable batch[6];
+      for(int i = 0; i != 6; ++i){
+         counted_movable tmp(values[i]);
+         batch[i] = boost::move(tmp);
+      }
+      s.insert_batch(boost::make_move_iterator(&batch[0]), boost::make_move_iterator(batch + 6));
+      if(s.size() != 6 || !is_sorted_unique(s) || s.begin()->value() != 1 || (s.end() - 1)->value() != 12)
+         return 1;
+      //Every element is consumed, even if its key was already present
+      if(batch[0].value() != -1 || batch[2].value() != -1)
+         return 1;
+      set_t s2(boost::move(s));
+      if(!s.empty() || s2.size() != 6 || s2.find(counted_movable(3)) == s2.end())
+         return 1;
+   }
+   if(counted_movable::live != 0)
+      return 1;
+   //Adopting and extracting the sequence
+   {
+      std::vector<int> v;
+      for(int i = 0; i != 10; ++i){
+         v.push_back(i*2);
+      }
+      const int *const data = &v[0];
+      flat_set<int> s;
+      s.adopt_sequence(boost::move(v));
+      if(s.size() != 10 || &*s.begin() != data || !v.empty())
+         return 1;
+      const int odd[] = { 5, 3, 1, 19, 4 };
+      s.insert_batch(odd, odd + 5);
+      if(s.size() != 14 || !is_sorted_unique(s))
+         return 1;
+      std::vector<int> out(s.extract_sequence());
+      if(out.size() != 14 || !s.empty() || out[1] != 1 || out.back() != 19)
+         return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,187 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/future.hpp>
+#include <boost/move/thread_pool.hpp>
+#include <stdexcept>
+
+//Movable-only handle, like the file_descriptor example
+class file_descriptor
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(file_descriptor)
+   int os_descr_;
+
+   public:
+   static int open_count;
+
+   explicit file_descriptor(int descr = 0)
+      : os_descr_(descr)
+   {  if(os_descr_) ++open_count;  }
+
+   ~file_descriptor()
+   {  if(os_descr_) --open_count;  }
+
+   file_descriptor(BOOST_RV_REF(file_descriptor) x)
+      : os_descr_(x.os_descr_)
+   {  x.os_descr_ = 0;  }
+
+   file_descriptor& operator=(BOOST_RV_REF(file_descriptor) x)
+   {
+      if(os_descr_) --open_count;
+      os_descr_   = x.os_descr_;
+      x.os_descr_ = 0;
+      return *this;
+   }
+
+   bool empty() const   {  return os_descr_ == 0;  }
+   int  get() const     {  return os_descr_;  }
+};
+
+int file_descriptor::open_count = 0;
+
+//Continuation that takes ownership of the descriptor
+struct close_descriptor
+{
+   typedef int result_type;
+
+   int operator()(BOOST_RV_REF(file_descriptor) fd) const
+   {
+      const file_descriptor owned(boost::move(fd));
+      return owned.get();
+   }
+};
+
+//Continuation that returns a movable-only object
+struct reopen
+{
+   typedef file_descriptor result_type;
+
+   file_descriptor operator()(int descr) const
+   {  return file_descriptor(descr + 1);  }
+};
+
+struct set_flag
+{
+   typedef void result_type;
+
+   explicit set_flag(bool &f) : flag(&f) {}
+   void operator()() const {  *flag = true;  }
+
+   bool *flag;
+};
+
+struct throw_on_call
+{
+   typedef int result_type;
+   int operator()(int) const {  throw std::runtime_error("continuation failed");  }
+};
+
+struct open_file
+{
+   typedef file_descriptor result_type;
+   file_descriptor operator()() const {  return file_descriptor(42);  }
+};
+
+int main()
+{
+   using namespace boost::movelib;
+   //get() moves the value out of the shared state
+   {
+      promise<file_descriptor> p;
+      future<file_descriptor> f = p.get_future();
+      file_descriptor fd(3);
+      p.set_value(boost::move(fd));
+      if(!fd.empty() || file_descriptor::open_count != 1)
+         return 1;
+      file_descriptor r(f.get());
+      if(r.get() != 3 || f.valid())
+         return 1;
+   }
+   if(file_descriptor::open_count != 0)
+      return 1;
+   //Promises and futures are movable
+   {
+      promise<file_descriptor> p;
+      promise<file_descriptor> p2(boost::move(p));
+      future<file_descriptor> f(p2.get_future());
+      future<file_descriptor> f2;
+      f2 = boost::move(f);
+      if(f.valid() || !f2.valid())
+         return 1;
+      p = boost::move(p2);
+      file_descriptor fd(5);
+      p.set_value(boost::move(fd));
+      if(f2.get().get() != 5)
+         return 1;
+   }
+   //Continuations attached before and after the value is set
+   {
+      promise<file_descriptor> p;
+      future<int> f = p.get_future().then(close_descriptor());
+      if(f.is_ready())
+         return 1;
+      file_descriptor fd(7);
+      p.set_value(boost::move(fd));
+      if(!f.is_ready() || file_descriptor::open_count != 0)
+         return 1;
+      future<file_descriptor> f2 = f.then(reopen());
+      if(f.valid() || !f2.is_ready() || f2.get().get() != 8)
+         return 1;
+   }
+   {
+      bool flag = false;
+      promise<void> p;
+      future<void> f = p.get_future().then(set_flag(flag));
+      p.set_value();
+      f.get();
+      if(!flag)
+         return 1;
+   }
+   //Exceptions skip the continuation and propagate
+   {
+      bool flag = false;
+      future<void> f;
+      {
+         promise<void> p;
+         f = p.get_future().then(set_flag(flag));
+      }
+      bool caught = false;
+      try{
+         f.get();
+      }
+      catch(broken_promise &){
+         caught = true;
+      }
+      if(!caught || flag)
+         return 1;
+   }
+   {
+      promise<int> p;
+      future<file_descriptor> f = p.get_future().then(throw_on_call()).then(reopen());
+      p.set_value(1);
+      bool caught = false;
+      try{
+         f.get();
+      }
+      catch(std::runtime_error &){
+         caught = true;
+      }
+      if(!caught || file_descriptor::open_count != 0)
+         return 1;
+   }
+   //Continuations of pool tasks run in the worker that produced the value
+   {
+      thread_pool pool(2);
+      future<int> f = pool.submit(open_file()).then(close_descriptor());
+      if(f.get() != 42)
+         return 1;
+   }
+   return file_descriptor::open_count == 0 ? 0 : 1;
+}
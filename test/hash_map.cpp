@@ -0,0 +1,178 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/hash_map.hpp>
+#include <map>
+#include <set>
+#include <string>
+#include "counted_movable.hpp"
+
+//Lookup of the movable-only keys
+bool operator==(const counted_movable &a, const counted_movable &b)
+{  return a.value() == b.value();  }
+
+std::size_t hash_value(const counted_movable &h)
+{  return static_cast<std::size_t>(h.value());  }
+
+//All the keys collide: exercises long probe sequences
+struct bad_hash
+{
+   std::size_t operator()(int) const {  return 7u;  }
+};
+
+template<class Map, class Ref>
+bool same(const Map &m, const Ref &ref)
+{
+   if(m.size() != ref.size())
+      return false;
+   std::size_t n = 0;
+   for(typename Map::const_iterator i = m.begin(); i != m.end(); ++i, ++n){
+      typename Ref::const_iterator r = ref.find(i->first);
+      if(r == ref.end() || r->second != i->second)
+         return false;
+   }
+   return n == ref.size();
+}
+
+template<class Map>
+bool random_test(Map &m)
+{
+   std::map<int, int> ref;
+   unsigned seed = 4321u;
+   for(int i = 0; i != 20000; ++i){
+      seed = seed*1103515245u + 12345u;
+      const int k = static_cast<int>((seed >> 8) % 3000u);
+      switch((seed >> 20) % 4u){
+         case 0:
+         case 1:
+            m[k] = i;
+            ref[k] = i;
+         break;
+         case 2:
+            if(m.erase(k) != ref.erase(k))
+               return false;
+         break;
+         default:
+            if(m.count(k) != ref.count(k))
+               return false;
+         break;
+      }
+   }
+   return same(m, ref);
+}
+
+int main()
+{
+   using boost::movelib::hash_map;
+   {
+      hash_map<int, int> m;
+      if(!m.empty() || m.capacity() != 0 || m.begin() != m.end() || m.find(1) != m.end())
+         return 1;
+      if(!random_test(m) || m.load_factor() > 0.875f)
+         return 1;
+      //Copies keep the layout
+      hash_map<int, int> m2(m);
+      if(!same(m2, m) || m2.capacity() != m.capacity())
+         return 1;
+      hash_map<int, int> m3;
+      m3 = boost::move(m2);
+      if(!m2.empty() || !same(m3, m))
+         return 1;
+      m.clear();
+      if(!m.empty() || m.begin() != m.end())
+         return 1;
+   }
+   {
+      hash_map<int, int, bad_hash> m;
+      for(int i = 0; i != 100; ++i){
+         m[i] = i;
+      }
+      for(int i = 0; i < 100; i += 2){
+         m.erase(i);
+      }
+      for(int i = 0; i != 100; ++i){
+         if(m.count(i) != std::size_t(i % 2))
+            return 1;
+      }
+      m.clear();
+      if(!random_test(m))
+         return 1;
+   }
+   //reserve avoids rehashing
+   {
+      hash_map<std::string, int> m(1000);
+      const std::size_t cap = m.capacity();
+      for(int i = 0; i != 1000; ++i){
+         m[std::string(1, char('a' + i % 26)) + char('a' + i / 26)] = i;
+      }
+      if(m.capacity() != cap || m.size() != 1000 || m.at("ba") != 1)
+         return 1;
+      bool thrown = false;
+      try{
+         m.at("zzz");
+      }
+      catch(std::out_of_range &){
+         thrown = true;
+      }
+      if(!thrown)
+         return 1;
+   }
+   //Keys that differ only in their high bits get spread homes
+   {
+      const unsigned shift = unsigned(sizeof(std::size_t)*8 - 16);
+      std::set<std::size_t> homes;
+      for(std::size_t i = 0; i != 1000; ++i){
+         homes.insert(boost::move_detail::hash_mix(i << shift) & 1023u);
+      }
+      if(homes.size() < 500)
+         return 1;
+      hash_map<std::size_t, std::size_t> m;
+      for(std::size_t i = 0; i != 20000; ++i){
+         m[i << shift] = i;
+      }
+      for(std::size_t i = 0; i != 20000; ++i){
+         if(m.find(i << shift) == m.end() || m.find(i << shift)->second != i)
+            return 1;
+      }
+   }
+   //Movable-only keys and values
+   {
+      hash_map<counted_movable, counted_movable> m;
+      for(int i = 0; i != 50; ++i){
+         counted_movable k(i), v(i*10);
+         if(!m.try_emplace(boost::move(k), boost::move(v)).second || k.value() != -1 || v.value() != -1)
+            return 1;
+      }
+      //try_emplace doesn't touch the arguments if the key exists
+      counted_movable k(3), v(33);
+      if(m.try_emplace(boost::move(k), boost::move(v)).second || k.value() != 3 || v.value() != 33)
+         return 1;
+      //emplace constructs the element and destroys it if the key exists
+      if(m.emplace(boost::move(k), boost::move(v)).second || k.value() != -1 || m.size() != 50)
+         return 1;
+      counted_movable k2(100), v2(1000);
+      std::pair<hash_map<counted_movable, counted_movable>::iterator, bool> r = m.emplace(boost::move(k2), boost::move(v2));
+      if(!r.second || r.first->second.value() != 1000)
+         return 1;
+      for(int i = 0; i != 50; ++i){
+         if(m.find(counted_movable(i)) == m.end() || m.find(counted_movable(i))->second.value() != i*10)
+            return 1;
+      }
+      m.erase(m.find(counted_movable(7)));
+      if(m.count(counted_movable(7)) || m.size() != 50)
+         return 1;
+      hash_map<counted_movable, counted_movable> m2(boost::move(m));
+      if(!m.empty() || m2.size() != 50)
+         return 1;
+   }
+   if(counted_movable::live != 0)
+      return 1;
+   return 0;
+}
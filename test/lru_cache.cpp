@@ -0,0 +1,232 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/lru_cache.hpp>
+#include <vector>
+#include "counted_movable.hpp"
+
+#if !defined(BOOST_NO_CXX11_HDR_THREAD)
+#include <thread>
+#endif
+
+//Records the evicted keys and takes the evicted values
+struct spill
+{
+   std::vector<int> *keys;
+   std::vector<int> *values;
+
+   void operator()(const int &k, BOOST_RV_REF(counted_movable) v) const
+   {
+      counted_movable p(::boost::move(v));
+      keys->push_back(k);
+      values->push_back(p.value());
+   }
+};
+
+struct throwing_spill
+{
+   void operator()(const int &, BOOST_RV_REF(counted_movable)) const
+   {  throw 0;  }
+};
+
+struct get_value
+{
+   int *out;
+   void operator()(counted_movable &p) const {  *out = p.value();  }
+};
+
+//Copyable value whose copy constructor throws when requested
+struct throwing_copy
+{
+   static bool fail;
+   int v;
+
+   explicit throwing_copy(int i = 0) : v(i) {}
+   throwing_copy(const throwing_copy &x) : v(x.v) {  if(fail) throw 0;  }
+   throwing_copy &operator=(const throwing_copy &x) {  v = x.v;  return *this;  }
+};
+
+bool throwing_copy::fail = false;
+
+int main()
+{
+   using namespace ::boost::movelib;
+   {
+      std::vector<int> keys, values;
+      spill s = { &keys, &values };
+      lru_cache<int, counted_movable, spill> c(3, s);
+      if(!c.empty() || c.capacity() != 3)
+         return 1;
+      for(int i = 0; i != 3; ++i){
+         counted_movable p(i*10);
+         if(!c.put(i, ::boost::move(p)) || !p.moved())
+            return 1;
+      }
+      if(c.size() != 3 || !keys.empty())
+         return 1;
+      //Touching 0 makes 1 the least recently used
+      counted_movable *const p0 = c.get(0);
+      if(!p0 || p0->value() != 0)
+         return 1;
+      //peek does not touch
+      const lru_cache<int, counted_movable, spill> &cc = c;
+      if(!cc.peek(1) || cc.peek(1)->value() != 10 || cc.peek(7))
+         return 1;
+      //Existing key: the value is replaced and nothing is evicted
+      counted_movable p21(21);
+      if(c.put(2, ::boost::move(p21)) || c.size() != 3 || c.get(2)->value() != 21)
+         return 1;
+      {  counted_movable p(30);  c.put(3, ::boost::move(p));  }
+      if(keys.size() != 1 || keys[0] != 1 || values[0] != 10 || c.contains(1))
+         return 1;
+      {  counted_movable p(40);  c.put(4, ::boost::move(p));  }
+      if(keys.size() != 2 || keys[1] != 0 || values[1] != 0)
+         return 1;
+      if(c.get(1))
+         return 1;
+      const lru_cache_stats st = c.stats();
+      if(st.hits != 2 || st.misses != 1 || st.evictions != 2)
+         return 1;
+
+      //take moves the value out and frees the entry
+      optional<counted_movable> t;
+      t = c.take(3);
+      if(!t || t->value() != 30 || c.size() != 2 || c.contains(3))
+         return 1;
+      if(c.take(3))
+         return 1;
+      {  counted_movable p(50);  c.put(5, ::boost::move(p));  }
+      if(keys.size() != 2)
+         return 1;
+      if(!c.erase(2) || c.erase(2) || c.size() != 2)
+         return 1;
+      c.reset_stats();
+      if(c.stats().hits || c.stats().misses || c.stats().evictions)
+         return 1;
+      c.clear();
+      if(!c.empty() || keys.size() != 2 || c.get(4))
+         return 1;
+   }
+   if(counted_movable::live != 0)
+      return 1;
+   //A throwing handler leaves the cache unchanged
+   {
+      lru_cache<int, counted_movable, throwing_spill> c(2);
+      {  counted_movable p(0);  c.put(0, ::boost::move(p));  }
+      {  counted_movable p(1);  c.put(1, ::boost::move(p));  }
+      bool thrown = false;
+      try{
+         {  counted_movable p(2);  c.put(2, ::boost::move(p));  }
+      }
+      catch(int){
+         thrown = true;
+      }
+      if(!thrown || c.size() != 2 || c.peek(0)->value() != 0 || c.peek(1)->value() != 1 || c.contains(2))
+         return 1;
+   }
+   if(counted_movable::live != 0)
+      return 1;
+   //Many keys colliding in a small table
+   {
+      lru_cache<int, int> c(64);
+      for(int i = 0; i != 1000; ++i){
+         c.put(i, i);
+         if(i % 3 == 0 && !c.erase(i))
+            return 1;
+      }
+      if(c.size() != 63 || c.stats().evictions != 1000 - 334 - 63)
+         return 1;
+      for(int i = 1000 - 95; i != 1000; ++i){
+         if(c.contains(i) != (i % 3 != 0))
+            return 1;
+      }
+   }
+   //Sharded cache
+   {
+      std::vector<int> keys, values;
+      spill s = { &keys, &values };
+      sharded_lru_cache<int, counted_movable, spill> c(64, 4, s);
+      if(c.shard_count() != 4 || c.capacity() != 64)
+         return 1;
+      for(int i = 0; i != 8; ++i){
+         {  counted_movable p(i);  c.put(i, ::boost::move(p));  }
+      }
+      if(c.size() != 8 || !c.contains(3) || c.contains(9))
+         return 1;
+      int seen = -1;
+      get_value f = { &seen };
+      if(!c.visit(5, f) || seen != 5 || c.visit(9, f))
+         return 1;
+      optional<counted_movable> t;
+      t = c.take(5);
+      if(!t || t->value() != 5 || c.size() != 7 || !c.erase(6) || c.erase(6))
+         return 1;
+      if(c.stats().hits != 2 || c.stats().misses != 1)
+         return 1;
+      for(int i = 8; i != 100; ++i){
+         {  counted_movable p(i);  c.put(i, ::boost::move(p));  }
+      }
+      if(c.size() > 64 || c.stats().evictions + c.size() != 100 - 2 || keys.size() != c.stats().evictions)
+         return 1;
+      c.clear();
+      if(c.size())
+         return 1;
+   }
+   if(counted_movable::live != 0)
+      return 1;
+   //A throwing value constructor does not leak the entry's slot
+   {
+      lru_cache<int, throwing_copy> c(2);
+      const throwing_copy x(7);
+      throwing_copy::fail = true;
+      for(int i = 0; i != 4; ++i){
+         try{
+            c.put(i, x);
+            return 1;
+         }
+         catch(int){}
+      }
+      throwing_copy::fail = false;
+      if(!c.empty())
+         return 1;
+      for(int i = 0; i != 4; ++i){
+         c.put(i, x);
+      }
+      if(c.size() != 2 || !c.contains(2) || !c.contains(3) || c.peek(3)->v != 7)
+         return 1;
+   }
+   #if !defined(BOOST_NO_CXX11_HDR_THREAD)
+   {
+      sharded_lru_cache<int, std::vector<int> > c(256, 8);
+      std::vector<std::thread> threads;
+      for(int t = 0; t != 4; ++t){
+         threads.push_back(std::thread([&c, t]{
+            for(int i = 0; i != 5000; ++i){
+               const int k = (i*7 + t) % 512;
+               c.put(k, std::vector<int>(4, k));
+               c.visit(k/2, [k](std::vector<int> &v){
+                  if(v.size() != 4 || v[0] != k/2)
+                     throw 0;
+               });
+               if(i % 5 == 0){
+                  c.take(k);
+               }
+            }
+         }));
+      }
+      for(std::size_t t = 0; t != threads.size(); ++t){
+         threads[t].join();
+      }
+      if(c.size() > c.capacity())
+         return 1;
+   }
+   #endif
+   return 0;
+}
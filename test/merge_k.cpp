@@ -0,0 +1,173 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/merge_k.hpp>
+#include <boost/move/deque.hpp>
+#include <boost/move/small_vector.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+#include "counted_movable.hpp"
+
+//Compares keys only: tags of equivalent elements show the stability
+struct by_tens
+{
+   bool operator()(int a, int b) const {  return a/10 < b/10;  }
+};
+
+typedef std::vector<int>::iterator                         int_it;
+typedef std::pair<int_it, int_it>                          int_range;
+typedef boost::movelib::deque<counted_movable>::iterator   mov_it;
+typedef std::pair<mov_it, mov_it>                          mov_range;
+
+void make_runs(std::vector< std::vector<int> > &runs, std::size_t k, std::size_t max_len, int max_value)
+{
+   runs.assign(k, std::vector<int>());
+   for(std::size_t r = 0; r != k; ++r){
+      runs[r].resize(max_len ? std::size_t(std::rand()) % max_len : 0u);
+      for(std::size_t i = 0; i != runs[r].size(); ++i){
+         runs[r][i] = std::rand() % max_value;
+      }
+      std::sort(runs[r].begin(), runs[r].end());
+   }
+}
+
+//Expected result of a stable merge of runs compared with comp
+template<class Compare>
+std::vector<int> reference_merge(const std::vector< std::vector<int> > &runs, Compare comp)
+{
+   std::vector<int> ref;
+   for(std::size_t r = 0; r != runs.size(); ++r){
+      ref.insert(ref.end(), runs[r].begin(), runs[r].end());
+   }
+   std::stable_sort(ref.begin(), ref.end(), comp);
+   return ref;
+}
+
+int main()
+{
+   using namespace ::boost::movelib;
+   std::srand(7);
+   //Random runs of ints, stable with a coarse comparison
+   for(int round = 0; round != 300; ++round){
+      std::vector< std::vector<int> > runs;
+      make_runs(runs, std::size_t(std::rand() % 20), 50u, 200);
+      by_tens comp;
+      for(std::size_t r = 0; r != runs.size(); ++r){
+         std::stable_sort(runs[r].begin(), runs[r].end(), comp);
+      }
+      const std::vector<int> ref = reference_merge(runs, comp);
+      std::vector<int_range> ranges;
+      for(std::size_t r = 0; r != runs.size(); ++r){
+         ranges.push_back(int_range(runs[r].begin(), runs[r].end()));
+      }
+      std::vector<int> out(ref.size());
+      if(merge_k(ranges.begin(), ranges.end(), out.begin(), comp) != out.end() || out != ref)
+         return 1;
+      std::vector<int> out2;
+      merge_k(ranges.begin(), ranges.end(), ::boost::back_move_inserter(out2), comp);
+      if(out2 != ref)
+         return 1;
+   }
+   //Movable-only elements: equivalent keys keep the order of their runs
+   {
+      const std::size_t k = 5;
+      std::vector< std::vector<int> > keys;
+      make_runs(keys, k, 100u, 30);
+      deque<counted_movable> runs[k];
+      std::vector<mov_range> ranges;
+      std::size_t total = 0;
+      for(std::size_t r = 0; r != k; ++r){
+         for(std::size_t i = 0; i != keys[r].size(); ++i){
+            runs[r].emplace_back(keys[r][i], int(total++));
+         }
+         ranges.push_back(mov_range(runs[r].begin(), runs[r].end()));
+      }
+      small_vector<counted_movable, 8> out;
+      merge_k(ranges.begin(), ranges.end(), ::boost::back_move_inserter(out));
+      if(out.size() != total)
+         return 1;
+      for(std::size_t i = 1; i < out.size(); ++i){
+         if(out[i].value() < out[i-1].value() ||
+            (out[i].value() == out[i-1].value() && out[i].tag() < out[i-1].tag()))
+            return 1;
+      }
+      for(std::size_t r = 0; r != k; ++r){
+         for(std::size_t i = 0; i != runs[r].size(); ++i){
+            if(!runs[r][i].moved())
+               return 1;
+         }
+      }
+   }
+   if(counted_movable::live != 0)
+      return 1;
+   //Uninitialized storage
+   {
+      const std::size_t k = 3;
+      deque<counted_movable> runs[k];
+      std::vector<mov_range> ranges;
+      for(std::size_t r = 0; r != k; ++r){
+         for(int i = 0; i != 10; ++i){
+            runs[r].emplace_back(i*int(k) + int(r));
+         }
+         ranges.push_back(mov_range(runs[r].begin(), runs[r].end()));
+      }
+      void *raw = ::operator new(30*sizeof(counted_movable));
+      counted_movable *const buf = static_cast<counted_movable*>(raw);
+      if(uninitialized_merge_k(ranges.begin(), ranges.end(), buf) != buf + 30)
+         return 1;
+      for(int i = 0; i != 30; ++i){
+         if(buf[i].value() != i)
+            return 1;
+      }
+      ::boost::movelib::destroy(buf, buf + 30);
+      ::operator delete(raw);
+   }
+   if(counted_movable::live != 0)
+      return 1;
+   //Parallel merge: large enough to be split, and small inputs
+   {
+      thread_pool pool(3);
+      for(int round = 0; round != 20; ++round){
+         std::vector< std::vector<int> > runs;
+         const bool large = round % 2 == 0;
+         make_runs(runs, std::size_t(1 + std::rand() % 16), large ? 8000u : 100u, round % 4 ? 1000000 : 50);
+         const std::vector<int> ref = reference_merge(runs, std::less<int>());
+         std::vector<int_range> ranges;
+         for(std::size_t r = 0; r != runs.size(); ++r){
+            ranges.push_back(int_range(runs[r].begin(), runs[r].end()));
+         }
+         std::vector<int> out(ref.size());
+         if(parallel_merge_k(pool, ranges.begin(), ranges.end(), out.begin()) != out.end() || out != ref)
+            return 1;
+      }
+      //Movable-only elements
+      const std::size_t k = 8;
+      deque<counted_movable> runs[k];
+      std::vector<mov_range> ranges;
+      for(std::size_t r = 0; r != k; ++r){
+         for(int i = 0; i != 5000; ++i){
+            runs[r].emplace_back(i*int(k) + int(r));
+         }
+         ranges.push_back(mov_range(runs[r].begin(), runs[r].end()));
+      }
+      small_vector<counted_movable, 8> out;
+      out.resize(k*5000);
+      parallel_merge_k(pool, ranges.begin(), ranges.end(), out.begin());
+      for(std::size_t i = 0; i != out.size(); ++i){
+         if(out[i].value() != int(i))
+            return 1;
+      }
+   }
+   if(counted_movable::live != 0)
+      return 1;
+   return 0;
+}
@@ -0,0 +1,133 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/monotonic_arena.hpp>
+#include <vector>
+
+//Movable-only type whose moved-from state needs no destruction
+class handle
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(handle)
+   int *p_;
+
+   public:
+   static int destructions;
+
+   explicit handle(int v = 0) : p_(new int(v)) {}
+   ~handle() {  ++destructions;  delete p_;  }
+   handle(BOOST_RV_REF(handle) x) : p_(x.p_) {  x.p_ = 0;  }
+   handle &operator=(BOOST_RV_REF(handle) x) {  delete p_;  p_ = x.p_;  x.p_ = 0;  return *this;  }
+
+   int value() const {  return *p_;  }
+};
+
+int handle::destructions = 0;
+
+namespace boost{
+
+template<>
+struct has_nothrow_move<handle>
+{
+   static const bool value = true;
+};
+
+template<>
+struct has_trivial_destructor_after_move<handle>
+{
+   static const bool value = true;
+};
+
+}  //namespace boost{
+
+int main()
+{
+   using namespace boost::movelib;
+   //Alignment, LIFO deallocation and in-place expansion
+   {
+      monotonic_arena arena(256);
+      char *c = static_cast<char*>(arena.allocate(1, 1));
+      void *d = arena.allocate(sizeof(double));
+      if(reinterpret_cast<std::size_t>(d) % monotonic_arena::max_alignment)
+         return 1;
+      if(!arena.try_expand_in_place(d, sizeof(double), 4*sizeof(double)))
+         return 1;
+      if(arena.try_expand_in_place(c, 1, 2))
+         return 1;
+      arena.deallocate(d, 4*sizeof(double));
+      if(arena.allocate(8) != d)
+         return 1;
+      //Big requests get their own chunk
+      const std::size_t remaining = arena.remaining();
+      void *big = arena.allocate(10000);
+      if(!big || arena.remaining() >= remaining + 10000)
+         return 1;
+      //reset() keeps the last (biggest) chunk
+      arena.reset();
+      if(arena.remaining() < 10000 || arena.allocate(10000) != big)
+         return 1;
+      arena.release();
+      if(arena.remaining() != 0)
+         return 1;
+   }
+   //User supplied buffer
+   {
+      boost::detail::max_align buf[8];
+      monotonic_arena arena(buf, sizeof(buf));
+      if(arena.allocate(sizeof(buf)) != static_cast<void*>(buf))
+         return 1;
+      if(arena.allocate(1) == static_cast<void*>(buf))
+         return 1;
+      arena.release();
+      if(arena.allocate(1) != static_cast<void*>(buf))
+         return 1;
+   }
+   //Standard containers
+   {
+      monotonic_arena arena;
+      std::vector<int, arena_allocator<int> > v((arena_allocator<int>(arena)));
+      for(int i = 0; i != 1000; ++i){
+         v.push_back(i);
+      }
+      if(v[999] != 999 || v.get_allocator() != arena_allocator<char>(arena))
+         return 1;
+   }
+   //grow_buffer expands the last allocation in place...
+   {
+      monotonic_arena arena;
+      arena_allocator<handle> a(arena);
+      handle *p = grow_buffer(a, static_cast<handle*>(0), 0, 0, 4);
+      for(int i = 0; i != 4; ++i){
+         ::new(static_cast<void*>(p + i)) handle(i);
+      }
+      handle *const p2 = grow_buffer(a, p, 4, 4, 16);
+      if(p2 != p || p[3].value() != 3)
+         return 1;
+      //...and relocates it otherwise, without destroying moved-from elements
+      arena.allocate(1);
+      handle *const p3 = grow_buffer(a, p2, 4, 16, 32);
+      if(p3 == p2 || p3[3].value() != 3 || handle::destructions != 0)
+         return 1;
+      destroy(p3, p3 + 4);
+      if(handle::destructions != 4)
+         return 1;
+   }
+   //Allocators without expansion always relocate
+   {
+      std::allocator<handle> a;
+      handle *p = grow_buffer(a, static_cast<handle*>(0), 0, 0, 2);
+      ::new(static_cast<void*>(p)) handle(1);
+      handle *const p2 = grow_buffer(a, p, 1, 2, 8);
+      if(p2[0].value() != 1)
+         return 1;
+      destroy(p2, p2 + 1);
+      a.deallocate(p2, 8);
+   }
+   return 0;
+}
@@ -0,0 +1,197 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/mpmc_queue.hpp>
+#include <boost/move/static_vector.hpp>
+#include "counted_movable.hpp"
+
+#if !defined(BOOST_NO_CXX11_HDR_THREAD)
+#include <thread>
+#include <vector>
+#include <atomic>
+#endif
+
+//Movable-only type whose move assignment throws when requested
+class fragile
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(fragile)
+   int id_;
+
+   public:
+   static int live;
+   static int assignments_before_throw;
+
+   explicit fragile(int id = -1) : id_(id) {  ++live;  }
+   fragile(BOOST_RV_REF(fragile) x) : id_(x.id_) {  x.id_ = -1;  ++live;  }
+   ~fragile() {  --live;  }
+
+   fragile &operator=(BOOST_RV_REF(fragile) x)
+   {
+      if(assignments_before_throw >= 0 && !assignments_before_throw--){
+         throw int(0);
+      }
+      id_ = x.id_;
+      x.id_ = -1;
+      return *this;
+   }
+
+   int id() const {  return id_;  }
+};
+
+int fragile::live = 0;
+int fragile::assignments_before_throw = -1;
+
+//A throwing assignment in a pop must release the claimed cells
+bool throwing_pops()
+{
+   boost::movelib::mpmc_queue<fragile> q(4);
+   fragile out[4];
+   for(int i = 0; i != 3; ++i){
+      q.emplace(i);
+   }
+   fragile::assignments_before_throw = 1;
+   try{
+      q.pop_bulk(&out[0], 3u);
+      return false;
+   }
+   catch(int){}
+   if(out[0].id() != 0 || fragile::live != 4){
+      return false;
+   }
+   q.emplace(10);
+   fragile::assignments_before_throw = 0;
+   try{
+      q.try_pop(out[1]);
+      return false;
+   }
+   catch(int){}
+   fragile::assignments_before_throw = -1;
+   //Every cell is reused: none of them was left claimed
+   for(int i = 0; i != 20; ++i){
+      q.emplace(i);
+      q.emplace(i + 100);
+      if(!q.try_pop(out[2]) || out[2].id() != i || !q.try_pop(out[3]) || out[3].id() != i + 100){
+         return false;
+      }
+   }
+   return !q.try_pop(out[2]) && fragile::live == 4;
+}
+
+#if !defined(BOOST_NO_CXX11_HDR_THREAD)
+
+template<class WaitStrategy>
+bool many_threads()
+{
+   const int Producers = 3, Consumers = 3, PerProducer = 20000;
+   boost::movelib::mpmc_queue<int, WaitStrategy> q(16);
+   std::vector<std::atomic<int> > seen(Producers*PerProducer);
+   std::vector<std::thread> threads;
+   for(int p = 0; p != Producers; ++p){
+      threads.push_back(std::thread([&q, p]{
+         for(int i = 0; i != PerProducer; ++i){
+            q.push(p*PerProducer + i);
+         }
+      }));
+   }
+   std::atomic<int> consumed(0);
+   for(int c = 0; c != Consumers; ++c){
+      threads.push_back(std::thread([&, c]{
+         for(;;){
+            int v;
+            if(c % 2){
+               int vs[4];
+               const int n = static_cast<int>(q.pop_bulk(vs, 4));
+               for(int i = 0; i != n; ++i){
+                  seen[vs[i]].fetch_add(1);
+               }
+               if(consumed.fetch_add(n) + n >= Producers*PerProducer){
+                  break;
+               }
+            }
+            else if(q.try_pop(v)){
+               seen[v].fetch_add(1);
+               if(consumed.fetch_add(1) + 1 >= Producers*PerProducer){
+                  break;
+               }
+            }
+            else if(consumed.load() >= Producers*PerProducer){
+               break;
+            }
+         }
+      }));
+   }
+   for(std::size_t i = 0; i != threads.size(); ++i){
+      threads[i].join();
+   }
+   for(std::size_t i = 0; i != seen.size(); ++i){
+      if(seen[i].load() != 1){
+         return false;
+      }
+   }
+   return true;
+}
+
+#endif
+
+int main()
+{
+   using boost::movelib::mpmc_queue;
+   {
+      mpmc_queue<counted_movable> q(3);
+      if(q.capacity() != 4){
+         return 1;
+      }
+      counted_movable w(0);
+      if(!q.try_push(boost::move(w)) || w.value() != -1){
+         return 1;
+      }
+      counted_movable w1(1);
+      q.push(boost::move(w1));
+      if(!q.try_emplace(2) || !q.try_emplace(3)){
+         return 1;
+      }
+      counted_movable w4(4);
+      if(q.try_push(boost::move(w4)) || w4.value() != 4){
+         return 1;
+      }
+      counted_movable out;
+      if(!q.try_pop(out) || out.value() != 0){
+         return 1;
+      }
+      q.push(boost::move(w4));
+      //Bulk pop into a back_move_inserter target
+      boost::movelib::static_vector<counted_movable, 8> v;
+      if(q.pop_bulk(boost::back_move_inserter(v)) != 4 || v.size() != 4){
+         return 1;
+      }
+      for(int i = 0; i != 4; ++i){
+         if(v[i].value() != i + 1){
+            return 1;
+         }
+      }
+      if(q.try_pop(out) || q.pop_bulk(boost::back_move_inserter(v)) != 0){
+         return 1;
+      }
+      //Remaining elements are destroyed with the queue
+      q.emplace(5);
+   }
+   if(counted_movable::live != 0){
+      return 1;
+   }
+   if(!throwing_pops() || fragile::live != 0){
+      return 1;
+   }
+   #if !defined(BOOST_NO_CXX11_HDR_THREAD)
+   if(!many_threads<boost::movelib::spin_wait>() || !many_threads<boost::movelib::blocking_wait>()){
+      return 1;
+   }
+   #endif
+   return 0;
+}
@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/optional.hpp>
+#include <boost/static_assert.hpp>
+#include "../example/movable.hpp"
+#include "../example/copymovable.hpp"
+
+struct point
+{
+   int x, y;
+   point(int a, int b) : x(a), y(b){}
+};
+
+int main()
+{
+   using boost::movelib::optional;
+   BOOST_STATIC_ASSERT((boost::has_trivial_destructor_after_move< optional<movable> >::value));
+   BOOST_STATIC_ASSERT((boost::has_nothrow_move< optional<movable> >::value));
+   BOOST_STATIC_ASSERT((boost::movelib::is_trivially_relocatable< optional<point> >::value));
+   {
+      //Movable but not copyable values
+      optional<movable> o;
+      if(o || o.is_initialized()){
+         return 1;
+      }
+      movable m;
+      o = boost::move(m);
+      if(!o || !m.moved() || o->moved()){
+         return 1;
+      }
+      optional<movable> o2(boost::move(o));
+      if(o || !o2 || o2->moved()){
+         return 1;
+      }
+      //Assignment between engaged optionals moves the value
+      optional<movable> o3;
+      o3.emplace();
+      o3 = boost::move(o2);
+      if(o2 || !o3 || o3->moved()){
+         return 1;
+      }
+      o3.reset();
+      if(o3){
+         return 1;
+      }
+   }
+   {
+      //In place construction of trivially relocatable values
+      optional<point> p;
+      p.emplace(1, 2);
+      if(p->x != 1 || p->y != 2){
+         return 1;
+      }
+      optional<point> p2(boost::move(p));
+      if(p || p2->x != 1 || p2->y != 2){
+         return 1;
+      }
+      p.swap(p2);
+      if(!p || p2 || p->y != 2){
+         return 1;
+      }
+   }
+   {
+      //Copyable and movable values
+      copy_movable c;
+      optional<copy_movable> o(c);
+      optional<copy_movable> o2(o);
+      if(c.moved() || o->moved() || o2->moved()){
+         return 1;
+      }
+      optional<copy_movable> o3;
+      o3 = o2;
+      o3 = boost::move(c);
+      if(!c.moved() || o3->moved()){
+         return 1;
+      }
+   }
+   {
+      optional<int> i(3);
+      int j = 4;
+      i = boost::move(j);
+      if(*i != 4 || i.get_ptr() != &*i){
+         return 1;
+      }
+   }
+   return 0;
+}
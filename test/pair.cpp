@@ -0,0 +1,89 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/pair.hpp>
+#include <boost/static_assert.hpp>
+#include "../example/movable.hpp"
+#include "../example/copymovable.hpp"
+
+//Neither copyable nor movable: only constructible in place
+class non_movable
+{
+   non_movable(const non_movable &);
+   non_movable &operator=(const non_movable &);
+
+   public:
+   int a_, b_;
+   bool moved_arg_;
+   non_movable(int a, int b, BOOST_RV_REF(movable) m)
+      : a_(a), b_(b), moved_arg_(false)
+   {
+      movable tmp(boost::move(m));
+      moved_arg_ = !tmp.moved();
+   }
+};
+
+int main()
+{
+   using boost::movelib::pair;
+   using boost::movelib::piecewise_construct;
+   using boost::movelib::forward_as_tuple;
+   BOOST_STATIC_ASSERT((boost::has_nothrow_move< pair<int, movable> >::value));
+   BOOST_STATIC_ASSERT((boost::movelib::is_trivially_relocatable< pair<int, char> >::value));
+   BOOST_STATIC_ASSERT((!boost::movelib::is_trivially_relocatable< pair<int, movable> >::value));
+   {
+      //Movable-only member
+      movable m;
+      pair<int, movable> p(1, boost::move(m));
+      pair<int, movable> p2(boost::move(p));
+      if(p2.first != 1 || p2.second.moved() || !p.second.moved()){
+         return 1;
+      }
+      p = boost::move(p2);
+      if(p.second.moved() || !p2.second.moved()){
+         return 1;
+      }
+      p.swap(p2);
+      if(p2.second.moved() || !p.second.moved()){
+         return 1;
+      }
+   }
+   {
+      //Copyable members and comparisons
+      pair<int, copy_movable> p(std::pair<int, copy_movable>(2, copy_movable()));
+      pair<int, copy_movable> p2(p);
+      if(p2.second.moved() || p.second.moved()){
+         return 1;
+      }
+      pair<int, int> a(1, 2), b(1, 3);
+      if(!(a < b) || a == b || !(a != b) || a > b || !(a <= b) || a >= b){
+         return 1;
+      }
+      a = std::pair<int, int>(1, 3);
+      if(!(a == b)){
+         return 1;
+      }
+   }
+   {
+      //Piecewise construction of a non-movable type from a movable-only argument
+      movable m;
+      pair<non_movable, movable> p
+         (piecewise_construct, forward_as_tuple(1, 2, boost::move(m)), forward_as_tuple());
+      if(p.first.a_ != 1 || p.first.b_ != 2 || !p.first.moved_arg_ || !m.moved() || p.second.moved()){
+         return 1;
+      }
+      movable m2;
+      pair<movable, int> p2(piecewise_construct, forward_as_tuple(boost::move(m2)), forward_as_tuple(7));
+      if(!m2.moved() || p2.first.moved() || p2.second != 7){
+         return 1;
+      }
+   }
+   return 0;
+}
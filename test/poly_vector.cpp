@@ -0,0 +1,129 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/poly_vector.hpp>
+#include "counted_movable.hpp"
+
+class strategy
+{
+   public:
+   virtual ~strategy(){}
+   virtual int apply(int x) const = 0;
+};
+
+//Trivially relocatable strategy
+class add_strategy : public strategy
+{
+   int n_;
+   public:
+   explicit add_strategy(int n) : n_(n){}
+   virtual int apply(int x) const {  return x + n_;  }
+};
+
+//Strategy holding a movable-only resource: relocated through its move constructor
+class resource_strategy : public strategy
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(resource_strategy)
+   counted_movable m_;
+   int mul_;
+
+   public:
+   explicit resource_strategy(int mul) : m_(), mul_(mul) {}
+
+   resource_strategy(BOOST_RV_REF(resource_strategy) x)
+      : m_(boost::move(x.m_)), mul_(x.mul_)
+   {}
+
+   bool moved() const {  return m_.moved();  }
+
+   virtual int apply(int x) const {  return m_.moved() ? -1 : x*mul_;  }
+};
+
+namespace boost{
+namespace movelib{
+
+template<>
+struct is_trivially_relocatable<add_strategy>
+{
+   static const bool value = true;
+};
+
+}  //namespace movelib{
+}  //namespace boost{
+
+int main()
+{
+   using boost::movelib::poly_vector;
+   {
+      poly_vector<strategy> v;
+      //Only trivially relocatable objects: growth is a single memcpy
+      for(int i = 0; i != 100; ++i){
+         v.emplace_back<add_strategy>(i);
+      }
+      if(v.size() != 100){
+         return 1;
+      }
+      for(int i = 0; i != 100; ++i){
+         if(v[i].apply(1) != i + 1){
+            return 1;
+         }
+      }
+   }
+   {
+      poly_vector<strategy> v;
+      //Mix of both kinds of objects
+      for(int i = 0; i != 100; ++i){
+         if(i % 2){
+            v.emplace_back<resource_strategy>(i);
+         }
+         else{
+            add_strategy a(i);
+            v.push_back(a);
+         }
+      }
+      resource_strategy r(1000);
+      v.push_back(boost::move(r));
+      if(!r.moved() || v.back().apply(1) != 1000){
+         return 1;
+      }
+      //Resources of the 50 odd elements, the moved element and r
+      if(counted_movable::live != 52){
+         return 1;
+      }
+      int i = 0;
+      for(poly_vector<strategy>::const_iterator it = v.begin(), itend = v.end(); it != itend; ++it, ++i){
+         const int expected = i == 100 ? 1000 : (i % 2) ? i : i + 1;
+         if(it->apply(1) != expected){
+            return 1;
+         }
+      }
+      if(i != 101){
+         return 1;
+      }
+
+      //Move construction steals the buffer
+      poly_vector<strategy> v2(boost::move(v));
+      if(!v.empty() || v2.size() != 101 || counted_movable::live != 52){
+         return 1;
+      }
+      v2.pop_back();
+      if(counted_movable::live != 51){
+         return 1;
+      }
+      v = boost::move(v2);
+      if(v.size() != 100 || !v2.empty()){
+         return 1;
+      }
+   }
+   if(counted_movable::live != 0){
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,68 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/pool_allocator.hpp>
+#include <list>
+
+int main()
+{
+   using namespace boost::movelib;
+   //Blocks are recycled in LIFO order
+   {
+      fixed_pool pool(sizeof(int), 0, 4);
+      if(pool.block_size() % monotonic_arena::max_alignment)
+         return 1;
+      void *blocks[10];
+      for(int i = 0; i != 10; ++i){
+         blocks[i] = pool.allocate();
+      }
+      pool.deallocate(blocks[3]);
+      if(pool.allocate() != blocks[3])
+         return 1;
+      for(int i = 0; i != 10; ++i){
+         pool.deallocate(blocks[i]);
+      }
+   }
+   //Small allocations come from the pool and can grow up to the block size
+   {
+      fixed_pool pool(4*sizeof(int));
+      pool_allocator<int> a(pool);
+      int *p = a.allocate(1);
+      p[0] = 1;
+      int *const p2 = grow_buffer(a, p, 1, 1, 4);
+      if(p2 != p || p2[0] != 1)
+         return 1;
+      int *const p3 = grow_buffer(a, p2, 4, 4, 100);
+      if(p3 == p2 || p3[0] != 1)
+         return 1;
+      //The block was returned to the pool
+      int *const p4 = a.allocate(2);
+      if(p4 != p2)
+         return 1;
+      a.deallocate(p4, 2);
+      a.deallocate(p3, 100);
+   }
+   //Node containers with blocks carved from an arena
+   {
+      monotonic_arena arena;
+      fixed_pool pool(64, &arena);
+      std::list<int, pool_allocator<int> > l((pool_allocator<int>(pool)));
+      for(int i = 0; i != 100; ++i){
+         l.push_back(i);
+      }
+      l.clear();
+      for(int i = 0; i != 100; ++i){
+         l.push_front(i);
+      }
+      if(l.size() != 100 || l.front() != 99)
+         return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,184 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/recycling_pool.hpp>
+#include "counted_movable.hpp"
+
+#if !defined(BOOST_NO_CXX11_HDR_THREAD)
+#include <thread>
+#include <vector>
+#endif
+
+//Movable-only buffer that counts its allocations
+class buffer
+   : public live_counted<buffer>
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(buffer)
+   int        *data_;
+   std::size_t size_;
+   std::size_t capacity_;
+
+   public:
+   static int allocations;
+
+   buffer() : data_(0), size_(0), capacity_(0) {}
+   ~buffer() {  delete [] data_;  }
+
+   buffer(BOOST_RV_REF(buffer) x)
+      : live_counted<buffer>(), data_(x.data_), size_(x.size_), capacity_(x.capacity_)
+   {  x.data_ = 0;  x.size_ = x.capacity_ = 0;  }
+
+   buffer &operator=(BOOST_RV_REF(buffer) x)
+   {
+      delete [] data_;
+      data_ = x.data_;  size_ = x.size_;  capacity_ = x.capacity_;
+      x.data_ = 0;  x.size_ = x.capacity_ = 0;
+      return *this;
+   }
+
+   void resize(std::size_t n)
+   {
+      if(n > capacity_){
+         int *const d = new int[n];
+         ++allocations;
+         delete [] data_;
+         data_ = d;
+         capacity_ = n;
+      }
+      size_ = n;
+   }
+
+   void clear()                     {  size_ = 0;  }
+   std::size_t size() const         {  return size_;  }
+   std::size_t capacity() const     {  return capacity_;  }
+};
+
+int buffer::allocations = 0;
+
+//Reset policy that also shrinks oversized buffers
+struct shrink_reset
+{
+   void operator()(buffer &b) const
+   {
+      if(b.capacity() > 100){
+         buffer empty;
+         b = boost::move(empty);
+      }
+      b.clear();
+   }
+};
+
+int main()
+{
+   using namespace boost::movelib;
+   {
+      recycling_pool<buffer> pool;
+      buffer b(pool.acquire());
+      if(b.capacity() != 0)
+         return 1;
+      b.resize(64);
+      pool.release(boost::move(b));
+      if(b.capacity() != 0 || buffer::allocations != 1)
+         return 1;
+      //The capacity is preserved and the contents cleared
+      for(int i = 0; i != 100; ++i){
+         buffer r(pool.acquire());
+         if(r.capacity() != 64 || r.size() != 0)
+            return 1;
+         r.resize(64);
+         pool.release(boost::move(r));
+      }
+      if(buffer::allocations != 1)
+         return 1;
+   }
+   if(buffer::live != 0)
+      return 1;
+   //Overflowing the thread cache spills to the global list
+   {
+      recycling_pool<buffer, clear_reset, 4> pool(3);
+      for(int i = 0; i != 10; ++i){
+         buffer b;
+         b.resize(8);
+         pool.release(boost::move(b));
+      }
+      //Three spills of two objects, limited to three
+      if(pool.global_size() != 3 || buffer::live != 3 + 4)
+         return 1;
+      int recycled = 0;
+      for(int i = 0; i != 8; ++i){
+         buffer b(pool.acquire());
+         recycled += b.capacity() == 8;
+      }
+      if(recycled != 7 || pool.global_size() != 0 || buffer::live != 0)
+         return 1;
+      for(int i = 0; i != 10; ++i){
+         buffer b;
+         b.resize(8);
+         pool.release(boost::move(b));
+      }
+      pool.trim();
+      if(pool.global_size() != 0 || buffer::live != 4)
+         return 1;
+   }
+   //Custom reset policy
+   {
+      recycling_pool<buffer, shrink_reset> pool;
+      buffer big;
+      big.resize(1000);
+      pool.release(boost::move(big));
+      if(pool.acquire().capacity() != 0)
+         return 1;
+   }
+   //Several pools used from the same thread
+   {
+      recycling_pool<buffer> pools[6];
+      for(int i = 0; i != 6; ++i){
+         buffer b;
+         b.resize(i + 1);
+         pools[i].release(boost::move(b));
+      }
+      for(int i = 0; i != 6; ++i){
+         if(pools[i].acquire().capacity() != std::size_t(i + 1))
+            return 1;
+      }
+   }
+   if(buffer::live != 0)
+      return 1;
+   #if !defined(BOOST_NO_CXX11_HDR_THREAD)
+   //Objects spilled by a thread are acquired by other threads
+   {
+      recycling_pool<std::vector<int>, clear_reset, 8> pool;
+      std::vector<std::thread> threads;
+      for(int t = 0; t != 4; ++t){
+         threads.push_back(std::thread([&pool, t]{
+            std::vector<std::vector<int> > held(16);
+            for(int i = 0; i != 1000; ++i){
+               for(std::size_t j = 0; j != held.size(); ++j){
+                  held[j] = pool.acquire();
+                  if(!held[j].empty())
+                     throw 0;
+                  held[j].resize(128, t);
+               }
+               for(std::size_t j = 0; j != held.size(); ++j){
+                  pool.release(std::move(held[j]));
+               }
+            }
+         }));
+      }
+      for(std::size_t t = 0; t != threads.size(); ++t){
+         threads[t].join();
+      }
+      std::vector<int> v(pool.acquire());
+      if(!v.empty() || (v.capacity() != 0 && v.capacity() < 128))
+         return 1;
+   }
+   #endif
+   return 0;
+}
@@ -0,0 +1,159 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/ring_buffer.hpp>
+#include <boost/static_assert.hpp>
+#include "../example/movable.hpp"
+#include "../example/copymovable.hpp"
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+//Output iterator that stores strings and throws on the assignment number fail_at
+class throwing_output
+{
+   std::string *out_;
+   int *count_;
+   int fail_at_;
+
+   public:
+   typedef std::output_iterator_tag iterator_category;
+   typedef void                     value_type;
+   typedef void                     difference_type;
+   typedef void                     pointer;
+   typedef void                     reference;
+
+   throwing_output(std::string *out, int *count, int fail_at)
+      : out_(out), count_(count), fail_at_(fail_at)
+   {}
+
+   throwing_output &operator*()     {  return *this;  }
+   throwing_output &operator++()    {  return *this;  }
+   throwing_output &operator++(int) {  return *this;  }
+
+   throwing_output &operator=(const std::string &s)
+   {
+      if(++*count_ == fail_at_){
+         throw std::runtime_error("output");
+      }
+      *out_++ = s;
+      return *this;
+   }
+};
+
+int main()
+{
+   using boost::movelib::ring_buffer;
+   BOOST_STATIC_ASSERT((boost::has_nothrow_move< ring_buffer<movable> >::value));
+   BOOST_STATIC_ASSERT((boost::movelib::is_trivially_relocatable< ring_buffer<movable> >::value));
+   {
+      //Capacity is rounded to a power of two
+      ring_buffer<int> r(5);
+      if(r.capacity() != 8 || !r.empty()){
+         return 1;
+      }
+      //Wrap around overwriting the oldest elements
+      for(int i = 0; i != 11; ++i){
+         r.push_back(i);
+      }
+      if(!r.full() || r.front() != 3 || r.back() != 10){
+         return 1;
+      }
+      if(r.pop_front() != 3 || r.size() != 7){
+         return 1;
+      }
+      //Elements 4..7 are at the end of the buffer and 8..10 at the beginning
+      int out[6];
+      if(r.move_out(6, out) != out + 6 || r.size() != 1 || r.front() != 10){
+         return 1;
+      }
+      for(int i = 0; i != 6; ++i){
+         if(out[i] != i + 4){
+            return 1;
+         }
+      }
+      ring_buffer<int> r2(r);
+      ring_buffer<int> r3(boost::move(r));
+      if(r2.size() != 1 || r3.size() != 1 || r3.front() != 10 || r.capacity() != 0){
+         return 1;
+      }
+   }
+   {
+      //Movable-only elements
+      ring_buffer<movable> r(2);
+      movable m;
+      r.push_back(boost::move(m));
+      r.emplace_back();
+      if(!m.moved() || r.size() != 2){
+         return 1;
+      }
+      //Overwrite the oldest element by move
+      movable m2;
+      r.push_back(boost::move(m2));
+      if(!m2.moved() || r.size() != 2 || r.front().moved() || r.back().moved()){
+         return 1;
+      }
+      movable p(r.pop_front());
+      if(p.moved() || r.size() != 1){
+         return 1;
+      }
+      r.emplace_back();
+      movable out[2];
+      r.move_out(2, out);
+      if(!r.empty() || out[0].moved() || out[1].moved()){
+         return 1;
+      }
+   }
+   {
+      //Copyable elements and aliasing arguments
+      ring_buffer<copy_movable> r(2);
+      copy_movable c;
+      r.push_back(c);
+      r.push_back(c);
+      r.emplace_back(r.front());
+      if(c.moved() || r.size() != 2 || r.back().moved()){
+         return 1;
+      }
+      ring_buffer<copy_movable> r2;
+      r2 = r;
+      r2.swap(r);
+      if(r2.size() != 2 || r.size() != 2){
+         return 1;
+      }
+   }
+   {
+      //An output that throws in the second segment: the first segment,
+      //already destroyed, must not be destroyed again
+      ring_buffer<std::string> r(4);
+      for(int i = 0; i != 6; ++i){
+         r.push_back(std::string(40, char('a' + i)));
+      }
+      //Elements c, d are at the end of the buffer and e, f at the beginning
+      std::string out[4];
+      int count = 0;
+      try{
+         r.move_out(4, throwing_output(out, &count, 3));
+         return 1;
+      }
+      catch(std::runtime_error &){}
+      if(r.size() != 2 || r.front() != std::string(40, 'e') || r.back() != std::string(40, 'f')){
+         return 1;
+      }
+      if(out[0] != std::string(40, 'c') || out[1] != std::string(40, 'd')){
+         return 1;
+      }
+      r.push_back(std::string(40, 'g'));
+      r.clear();
+      if(!r.empty()){
+         return 1;
+      }
+   }
+   return 0;
+}
@@ -0,0 +1,178 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/small_vector.hpp>
+#include <boost/static_assert.hpp>
+#include "../example/movable.hpp"
+#include "../example/copymovable.hpp"
+#include "counted_movable.hpp"
+
+//Copyable type whose constructors throw after a given number of calls
+class bomb
+{
+   public:
+   static int live;
+   static int fuse;
+
+   bomb()               {  this->priv_tick();  ++live;  }
+   bomb(const bomb &)   {  this->priv_tick();  ++live;  }
+   bomb &operator=(const bomb &) {  return *this;  }
+   ~bomb() {  --live;  }
+
+   private:
+   void priv_tick()
+   {
+      if(fuse >= 0 && !fuse--){
+         throw int(0);
+      }
+   }
+};
+
+int bomb::live = 0;
+int bomb::fuse = -1;
+
+namespace boost{
+
+template<>
+struct has_nothrow_move<counted_movable>
+{
+   static const bool value = true;
+};
+
+}  //namespace boost{
+
+int main()
+{
+   using boost::movelib::small_vector;
+   BOOST_STATIC_ASSERT((boost::has_trivial_destructor_after_move< small_vector<movable, 4> >::value));
+   BOOST_STATIC_ASSERT((boost::has_nothrow_move< small_vector<movable, 4> >::value));
+   {
+      //Movable-only elements: inline storage, growth and relocation
+      small_vector<counted_movable, 4> v;
+      for(int i = 0; i != 4; ++i){
+         counted_movable c(i);
+         v.push_back(boost::move(c));
+      }
+      if(!v.is_inline() || v.size() != 4 || counted_movable::live != 4){
+         return 1;
+      }
+      v.emplace_back(4);
+      if(v.is_inline() || v.capacity() != 8 || counted_movable::live != 5){
+         return 1;
+      }
+      for(int i = 0; i != 5; ++i){
+         if(v[i].value() != i){
+            return 1;
+         }
+      }
+      //Insert in the middle and at the beginning
+      counted_movable c(10);
+      v.insert(v.begin() + 2, boost::move(c));
+      v.emplace(v.begin(), 20);
+      const int expected[] = { 20, 0, 1, 10, 2, 3, 4 };
+      for(int i = 0; i != 7; ++i){
+         if(v[i].value() != expected[i]){
+            return 1;
+         }
+      }
+      //Erase elements
+      v.erase(v.begin());
+      v.erase(v.begin() + 2, v.begin() + 4);
+      if(v.size() != 4 || v[0].value() != 0 || v[2].value() != 3 || counted_movable::live != 5){
+         return 1;
+      }
+
+      //Moving a heap-backed vector steals the buffer
+      const counted_movable *const data = v.data();
+      small_vector<counted_movable, 4> v2(boost::move(v));
+      if(v2.data() != data || !v.empty() || !v.is_inline() || counted_movable::live != 5){
+         return 1;
+      }
+      //Moving an inline vector relocates the elements
+      small_vector<counted_movable, 4> v3;
+      v3.emplace_back(7);
+      small_vector<counted_movable, 4> v4(boost::move(v3));
+      if(!v4.is_inline() || v4.size() != 1 || v4[0].value() != 7 || !v3.empty() || counted_movable::live != 6){
+         return 1;
+      }
+      v4.swap(v2);
+      if(v2.size() != 1 || v4.size() != 4 || v4[3].value() != 4 || v2[0].value() != 7){
+         return 1;
+      }
+      v2 = boost::move(v4);
+      if(v2.size() != 4 || !v4.empty() || counted_movable::live != 5){
+         return 1;
+      }
+      v2.pop_back();
+      v2.resize(6);
+      if(v2.size() != 6 || v2[5].value() != 0 || counted_movable::live != 7){
+         return 1;
+      }
+   }
+   if(counted_movable::live != 0){
+      return 1;
+   }
+   {
+      //Copyable elements and aliasing arguments
+      small_vector<int, 2> v;
+      v.push_back(1);
+      v.push_back(2);
+      v.push_back(v[0]);
+      v.insert(v.begin(), v[2]);
+      v.insert(v.begin() + 1, v.back());
+      const int expected[] = { 1, 1, 1, 2, 1 };
+      if(v.size() != 5){
+         return 1;
+      }
+      for(int i = 0; i != 5; ++i){
+         if(v[i] != expected[i]){
+            return 1;
+         }
+      }
+      small_vector<int, 2> v2(v);
+      small_vector<int, 2> v3;
+      v3 = v2;
+      if(v2.size() != 5 || v3.size() != 5 || v3[3] != 2){
+         return 1;
+      }
+      small_vector<copy_movable, 2> cv(3);
+      small_vector<copy_movable, 2> cv2;
+      cv2 = cv;
+      cv2.push_back(cv[0]);
+      if(cv2.size() != 4 || cv[0].moved() || cv2[3].moved()){
+         return 1;
+      }
+   }
+   {
+      //Throwing element constructors: no leaked elements or buffers
+      bomb::fuse = 6;
+      try{
+         small_vector<bomb, 2> v(10);
+         return 1;
+      }
+      catch(int){}
+      if(bomb::live != 0){
+         return 1;
+      }
+      bomb::fuse = -1;
+      small_vector<bomb, 2> v(10);
+      bomb::fuse = 6;
+      try{
+         small_vector<bomb, 2> v2(v);
+         return 1;
+      }
+      catch(int){}
+      bomb::fuse = -1;
+      if(bomb::live != 10){
+         return 1;
+      }
+   }
+   return 0;
+}
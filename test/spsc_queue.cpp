@@ -0,0 +1,186 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/spsc_queue.hpp>
+#include "../example/movable.hpp"
+
+#if !defined(BOOST_NO_CXX11_HDR_THREAD)
+#include <thread>
+#endif
+
+//Movable-only handle
+class handle
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(handle)
+   int fd_;
+
+   public:
+   explicit handle(int fd = -1) : fd_(fd) {}
+   handle(BOOST_RV_REF(handle) x) : fd_(x.fd_) {  x.fd_ = -1;  }
+   handle &operator=(BOOST_RV_REF(handle) x) {  fd_ = x.fd_;  x.fd_ = -1;  return *this;  }
+
+   int fd() const {  return fd_;  }
+};
+
+//Movable-only type whose move assignment throws when requested
+class fragile
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(fragile)
+   int *p_;
+
+   public:
+   static int live;
+   static int assignments_before_throw;
+
+   explicit fragile(int v = -1) : p_(new int(v)) {  ++live;  }
+   fragile(BOOST_RV_REF(fragile) x) : p_(x.p_) {  x.p_ = 0;  ++live;  }
+   ~fragile() {  delete p_;  --live;  }
+
+   fragile &operator=(BOOST_RV_REF(fragile) x)
+   {
+      if(assignments_before_throw >= 0 && !assignments_before_throw--){
+         throw int(0);
+      }
+      delete p_;
+      p_ = x.p_;
+      x.p_ = 0;
+      return *this;
+   }
+
+   int value() const {  return p_ ? *p_ : -1;  }
+};
+
+int fragile::live = 0;
+int fragile::assignments_before_throw = -1;
+
+//A throwing assignment in pop_n removes only the elements handed out
+bool throwing_pop_n()
+{
+   boost::movelib::spsc_queue<fragile> q(4);
+   for(int i = 0; i != 4; ++i){
+      fragile f(i);
+      q.try_push(boost::move(f));
+   }
+   fragile outs[4];
+   fragile::assignments_before_throw = 2;
+   try{
+      q.pop_n(outs, 4);
+      return false;
+   }
+   catch(int){}
+   fragile::assignments_before_throw = -1;
+   if(outs[1].value() != 1){
+      return false;
+   }
+   fragile f;
+   if(!q.try_pop(f) || f.value() != 2 || q.pop_n(outs, 4) != 1 || outs[0].value() != 3){
+      return false;
+   }
+   return q.empty();
+}
+
+#if !defined(BOOST_NO_CXX11_HDR_THREAD)
+
+bool two_threads()
+{
+   const int N = 100000;
+   boost::movelib::spsc_queue<handle> q(64);
+   std::thread producer([&q]{
+      for(int i = 0; i != N; ){
+         if(i % 3){
+            handle h(i);
+            if(q.try_push(boost::move(h))){
+               ++i;
+            }
+         }
+         else{
+            handle hs[4] = { handle(i), handle(i+1), handle(i+2), handle(i+3) };
+            const int n = static_cast<int>(q.push_n(hs, N - i < 4 ? N - i : 4));
+            i += n;
+         }
+      }
+   });
+   bool ok = true;
+   for(int i = 0; i != N; ){
+      handle hs[3];
+      const int n = static_cast<int>(q.pop_n(hs, 3));
+      for(int j = 0; j != n; ++j, ++i){
+         ok = ok && hs[j].fd() == i;
+      }
+   }
+   producer.join();
+   return ok && q.empty();
+}
+
+#endif
+
+int main()
+{
+   using boost::movelib::spsc_queue;
+   {
+      spsc_queue<handle> q(3);
+      if(q.capacity() != 4 || !q.empty()){
+         return 1;
+      }
+      handle h(1);
+      if(!q.try_push(boost::move(h)) || h.fd() != -1){
+         return 1;
+      }
+      if(!q.try_emplace(2) || !q.try_emplace(3) || !q.try_emplace(4)){
+         return 1;
+      }
+      handle h5(5);
+      if(q.try_push(boost::move(h5)) || h5.fd() != 5){
+         return 1;
+      }
+      handle out;
+      if(!q.try_pop(out) || out.fd() != 1){
+         return 1;
+      }
+      //Wraps around the end of the ring
+      if(!q.try_push(boost::move(h5)) || h5.fd() != -1){
+         return 1;
+      }
+      handle outs[8];
+      if(q.pop_n(outs, 8) != 4){
+         return 1;
+      }
+      for(int i = 0; i != 4; ++i){
+         if(outs[i].fd() != i + 2){
+            return 1;
+         }
+      }
+      if(q.try_pop(out) || !q.empty()){
+         return 1;
+      }
+      if(q.push_n(outs, 8) != 4 || outs[0].fd() != -1){
+         return 1;
+      }
+   }
+   {
+      //Elements left in the queue are destroyed
+      spsc_queue<movable> q(2);
+      movable m;
+      q.try_push(boost::move(m));
+      movable m2;
+      if(!q.try_pop(m2) || m2.moved()){
+         return 1;
+      }
+   }
+   if(!throwing_pop_n() || fragile::live != 0){
+      return 1;
+   }
+   #if !defined(BOOST_NO_CXX11_HDR_THREAD)
+   if(!two_threads()){
+      return 1;
+   }
+   #endif
+   return 0;
+}
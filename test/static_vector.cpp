@@ -0,0 +1,126 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/static_vector.hpp>
+#include <boost/static_assert.hpp>
+#include "../example/movable.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+//Type whose default constructor throws after a given number of calls
+class bomb
+{
+   public:
+   static int live;
+   static int fuse;
+
+   bomb()
+   {
+      if(fuse >= 0 && !fuse--){
+         throw int(0);
+      }
+      ++live;
+   }
+
+   ~bomb() {  --live;  }
+};
+
+int bomb::live = 0;
+int bomb::fuse = -1;
+
+int main()
+{
+   using boost::movelib::static_vector;
+   BOOST_STATIC_ASSERT((boost::movelib::is_trivially_relocatable< static_vector<int, 4> >::value));
+   BOOST_STATIC_ASSERT((!boost::movelib::is_trivially_relocatable< static_vector<movable, 4> >::value));
+   BOOST_STATIC_ASSERT((boost::has_nothrow_move< static_vector<movable, 4> >::value));
+   {
+      //Movable-only elements filled through back_move_inserter
+      movable src[4];
+      static_vector<movable, 8> v;
+      std::copy(src, src + 4, boost::back_move_inserter(v));
+      if(v.size() != 4 || !src[0].moved() || !src[3].moved() || v[0].moved()){
+         return 1;
+      }
+      //Middle insertion
+      movable m;
+      if(v.insert(v.begin() + 1, boost::move(m)) != v.begin() + 1 || !m.moved() || v.size() != 5){
+         return 1;
+      }
+      for(static_vector<movable, 8>::iterator it = v.begin(); it != v.end(); ++it){
+         if(it->moved()){
+            return 1;
+         }
+      }
+      static_vector<movable, 8> v2(boost::move(v));
+      if(!v.empty() || v2.size() != 5 || v2[4].moved()){
+         return 1;
+      }
+      v2.erase(v2.begin(), v2.begin() + 2);
+      if(v2.size() != 3 || v2[2].moved()){
+         return 1;
+      }
+   }
+   {
+      //Trivially relocatable elements and aliasing insertion
+      static_vector<int, 4> v;
+      v.push_back(1);
+      v.push_back(2);
+      v.insert(v.begin(), v[1]);
+      if(v.size() != 3 || v[0] != 2 || v[1] != 1 || v[2] != 2){
+         return 1;
+      }
+      static_vector<int, 4> v2;
+      v2 = boost::move(v);
+      if(v2.size() != 3 || !v.empty()){
+         return 1;
+      }
+      static_vector<int, 4> v3(v2);
+      v2.swap(v);
+      if(v.size() != 3 || !v2.empty() || v3[2] != 2){
+         return 1;
+      }
+   }
+   {
+      //Overflow policies
+      static_vector<int, 2> v(2);
+      bool thrown = false;
+      try{
+         v.push_back(3);
+      }
+      catch(std::length_error &){
+         thrown = true;
+      }
+      if(!thrown || v.size() != 2){
+         return 1;
+      }
+      static_vector<int, 2, boost::movelib::return_false_on_overflow> r;
+      if(!r.push_back(1) || !r.emplace_back(2) || r.push_back(3) || r.size() != 2){
+         return 1;
+      }
+      if(r.insert(r.begin(), 0) != 0 || r.resize(3) || r[0] != 1){
+         return 1;
+      }
+   }
+   {
+      //The elements built before a throwing constructor are destroyed
+      bomb::fuse = 3;
+      try{
+         static_vector<bomb, 8> v(6);
+         return 1;
+      }
+      catch(int){}
+      bomb::fuse = -1;
+      if(bomb::live != 0){
+         return 1;
+      }
+   }
+   return 0;
+}
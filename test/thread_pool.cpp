@@ -0,0 +1,172 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/thread_pool.hpp>
+#include <boost/move/detail/atomic.hpp>
+#include <stdexcept>
+
+//Movable-only result
+class payload
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(payload)
+   int value_;
+
+   public:
+   explicit payload(int v = 0) : value_(v) {}
+   payload(BOOST_RV_REF(payload) x) : value_(x.value_) {  x.value_ = 0;  }
+   payload &operator=(BOOST_RV_REF(payload) x) {  value_ = x.value_;  x.value_ = 0;  return *this;  }
+
+   int value() const {  return value_;  }
+};
+
+//Movable-only task that returns a movable-only result
+class make_payload
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(make_payload)
+   payload p_;
+
+   public:
+   typedef payload result_type;
+
+   explicit make_payload(int v) : p_(v) {}
+   make_payload(BOOST_RV_REF(make_payload) x) : p_(boost::move(x.p_)) {}
+   make_payload &operator=(BOOST_RV_REF(make_payload) x) {  p_ = boost::move(x.p_);  return *this;  }
+
+   payload operator()()
+   {  return payload(boost::move(p_));  }
+};
+
+//Copyable task
+struct add_one
+{
+   typedef void result_type;
+
+   explicit add_one(boost::move_detail::atomic<int> &c) : counter(&c) {}
+   void operator()() const {  counter->fetch_add(1);  }
+
+   boost::move_detail::atomic<int> *counter;
+};
+
+struct thrower
+{
+   typedef int result_type;
+   int operator()() const {  throw std::runtime_error("task failed");  }
+};
+
+//Recursive task: submits its children to the pool from a worker thread
+struct fib
+{
+   typedef int result_type;
+
+   fib(boost::movelib::thread_pool &p, int n) : pool(&p), n(n) {}
+
+   int operator()() const
+   {
+      if(n < 2){
+         return n;
+      }
+      boost::movelib::future<int> a = pool->submit(fib(*pool, n - 1));
+      boost::movelib::future<int> b = pool->submit(fib(*pool, n - 2));
+      return a.get() + b.get();
+   }
+
+   boost::movelib::thread_pool *pool;
+   int n;
+};
+
+int main()
+{
+   using namespace boost::movelib;
+   //Movable-only callables and results
+   {
+      thread_pool pool(4);
+      if(pool.size() != 4)
+         return 1;
+      future<payload> futures[100];
+      for(int i = 0; i != 100; ++i){
+         make_payload t(i + 1);
+         futures[i] = pool.submit(boost::move(t));
+      }
+      for(int i = 0; i != 100; ++i){
+         if(!futures[i].valid())
+            return 1;
+         payload p(futures[i].get());
+         if(p.value() != i + 1 || futures[i].valid())
+            return 1;
+      }
+   }
+   //Copyable callables, void results. The destructor runs every task
+   {
+      boost::move_detail::atomic<int> counter(0);
+      {
+         thread_pool pool(3);
+         const add_one a(counter);
+         for(int i = 0; i != 1000; ++i){
+            pool.submit(a);
+         }
+      }
+      if(counter.load() != 1000)
+         return 1;
+   }
+   //Exceptions are transported to the future
+   {
+      thread_pool pool(2);
+      future<int> f = pool.submit(thrower());
+      f.wait();
+      if(!f.is_ready())
+         return 1;
+      bool caught = false;
+      try{
+         f.get();
+      }
+      catch(std::runtime_error &){
+         caught = true;
+      }
+      if(!caught || f.valid())
+         return 1;
+   }
+   //Tasks submitted from workers go to the worker's deque and are stolen
+   //by idle workers. get() blocks the worker, so the pool needs more
+   //workers than the 7 internal nodes of the fib(5) call tree.
+   {
+      thread_pool pool(8);
+      future<int> f = pool.submit(fib(pool, 5));
+      if(f.get() != 5)
+         return 1;
+   }
+   //Promise/future pairs
+   {
+      promise<payload> p;
+      future<payload> f = p.get_future();
+      if(f.is_ready())
+         return 1;
+      payload v(7);
+      p.set_value(boost::move(v));
+      if(!f.is_ready() || f.get().value() != 7)
+         return 1;
+   }
+   {
+      future<void> f;
+      {
+         promise<void> p;
+         f = p.get_future();
+      }
+      bool caught = false;
+      try{
+         f.get();
+      }
+      catch(broken_promise &){
+         caught = true;
+      }
+      if(!caught)
+         return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,76 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/tuple.hpp>
+#include <boost/static_assert.hpp>
+#include "../example/movable.hpp"
+#include "../example/copymovable.hpp"
+
+int main()
+{
+   using boost::movelib::tuple;
+   using boost::movelib::get;
+   BOOST_STATIC_ASSERT((boost::movelib::tuple_size< tuple<> >::value == 0));
+   BOOST_STATIC_ASSERT((boost::movelib::tuple_size< tuple<int, movable, char> >::value == 3));
+   BOOST_STATIC_ASSERT((boost::has_nothrow_move< tuple<int, movable> >::value));
+   BOOST_STATIC_ASSERT((!boost::has_nothrow_move< tuple<int, copy_movable> >::value));
+   BOOST_STATIC_ASSERT((boost::movelib::is_trivially_relocatable< tuple<int, char> >::value));
+   {
+      //Movable-only elements
+      movable m;
+      tuple<int, movable> t(1, boost::move(m));
+      if(get<0>(t) != 1 || get<1>(t).moved()){
+         return 1;
+      }
+      tuple<int, movable> t2(boost::move(t));
+      if(get<0>(t2) != 1 || get<1>(t2).moved() || !get<1>(t).moved()){
+         return 1;
+      }
+      get<0>(t) = 2;
+      t = boost::move(t2);
+      if(get<0>(t) != 1 || get<1>(t).moved() || !get<1>(t2).moved()){
+         return 1;
+      }
+      t.swap(t2);
+      if(get<0>(t2) != 1 || get<1>(t2).moved() || !get<1>(t).moved()){
+         return 1;
+      }
+   }
+   {
+      //Copyable elements
+      const tuple<copy_movable, int> t(copy_movable(), 3);
+      tuple<copy_movable, int> t2(t);
+      if(get<0>(t2).moved() || get<1>(t2) != 3){
+         return 1;
+      }
+      tuple<copy_movable, int> t3;
+      t3 = t;
+      if(get<0>(t3).moved() || get<1>(t3) != 3 || get<0>(t).moved()){
+         return 1;
+      }
+      tuple<copy_movable> t4(get<0>(t3));
+      tuple<copy_movable> t5(t4);
+      if(get<0>(t5).moved() || get<0>(t4).moved()){
+         return 1;
+      }
+   }
+   {
+      //forward_as_tuple stores references to the arguments
+      movable m;
+      int i = 5;
+      if(&get<1>(boost::movelib::forward_as_tuple(boost::move(m), i)) != &i){
+         return 1;
+      }
+      if(m.moved()){
+         return 1;
+      }
+   }
+   return 0;
+}
@@ -0,0 +1,121 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/unique_function.hpp>
+#include <boost/static_assert.hpp>
+#include "../example/movable.hpp"
+
+//A movable but not copyable function object
+class task
+{
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(task)
+   movable m_;
+   int *counter_;
+
+   public:
+   explicit task(int *counter) : m_(), counter_(counter){}
+
+   task(BOOST_RV_REF(task) x)
+      : m_(boost::move(x.m_)), counter_(x.counter_)
+   {}
+
+   task& operator=(BOOST_RV_REF(task) x)
+   {  m_ = boost::move(x.m_);  counter_ = x.counter_;  return *this;  }
+
+   bool moved() const {  return m_.moved();  }
+
+   int operator()(int a, int b) const
+   {  ++*counter_;  return m_.moved() ? -1 : a + b;  }
+};
+
+namespace boost{
+
+template<>
+struct has_nothrow_move<task>
+{
+   static const bool value = true;
+};
+
+}  //namespace boost{
+
+//A function object too big for the inline buffer
+struct big_task
+{
+   int data[64];
+   big_task()  {  data[0] = 10;  }
+   int operator()(int a, int b) const {  return data[0] + a*b;  }
+};
+
+int sub(int a, int b) {  return a - b;  }
+
+int g_count = 0;
+void increment() {  ++g_count;  }
+
+typedef boost::movelib::unique_function<int(int, int)> binary_function;
+
+int main()
+{
+   BOOST_STATIC_ASSERT((boost::has_nothrow_move<binary_function>::value));
+   {
+      binary_function f;
+      if(f || !f.empty()){
+         return 1;
+      }
+      bool thrown = false;
+      try{  f(1, 2);  }
+      catch(boost::movelib::bad_function_call &){  thrown = true;  }
+      if(!thrown){
+         return 1;
+      }
+   }
+   {
+      //Movable-only function objects are stored inline
+      int counter = 0;
+      task t(&counter);
+      binary_function f(boost::move(t));
+      if(!t.moved() || !f || f(1, 2) != 3 || counter != 1){
+         return 1;
+      }
+      //Moving the wrapper moves the stored object
+      binary_function f2(boost::move(f));
+      if(f || f2(3, 4) != 7 || counter != 2){
+         return 1;
+      }
+      f = boost::move(f2);
+      if(f2 || f(5, 5) != 10){
+         return 1;
+      }
+   }
+   {
+      //Heap allocated function objects and function pointers
+      binary_function f = binary_function(big_task());
+      binary_function f2(&sub);
+      if(f(2, 3) != 16 || f2(2, 3) != -1){
+         return 1;
+      }
+      f.swap(f2);
+      if(f(2, 3) != -1 || f2(2, 3) != 16){
+         return 1;
+      }
+      f.reset();
+      if(f){
+         return 1;
+      }
+   }
+   {
+      boost::movelib::unique_function<void()> f(&increment);
+      f();
+      f();
+      if(g_count != 2){
+         return 1;
+      }
+   }
+   return 0;
+}
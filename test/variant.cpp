@@ -0,0 +1,96 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2011.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/move for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/move/variant.hpp>
+#include <boost/static_assert.hpp>
+#include "../example/movable.hpp"
+#include "../example/copymovable.hpp"
+
+struct moved_visitor
+{
+   typedef bool result_type;
+   bool operator()(const movable &m) const      {  return m.moved();  }
+   bool operator()(const copy_movable &m) const {  return m.moved();  }
+   bool operator()(int) const                   {  return false;  }
+};
+
+int main()
+{
+   using boost::movelib::variant;
+   typedef variant<int, movable, copy_movable> var_t;
+
+   BOOST_STATIC_ASSERT((boost::movelib::is_trivially_relocatable< variant<int, double> >::value));
+   BOOST_STATIC_ASSERT((!boost::movelib::is_trivially_relocatable<var_t>::value));
+   {
+      var_t v;
+      if(v.which() != 0 || v.get<int>() != 0){
+         return 1;
+      }
+      //Move construction of an alternative
+      movable m;
+      var_t v2(boost::move(m));
+      if(!m.moved() || v2.which() != 1 || v2.get<movable>().moved()){
+         return 1;
+      }
+      //Moving the variant moves the alternative
+      var_t v3(boost::move(v2));
+      if(v3.which() != 1 || !v2.get<movable>().moved() || v3.get<movable>().moved()){
+         return 1;
+      }
+      //Assignment between equal alternatives move assigns
+      v2 = boost::move(v3);
+      if(!v3.get<movable>().moved() || v2.get<movable>().moved()){
+         return 1;
+      }
+      if(boost::movelib::apply_visitor(moved_visitor(), v2) || !boost::movelib::apply_visitor(moved_visitor(), v3)){
+         return 1;
+      }
+      //Assignment between different alternatives
+      v = boost::move(v2);
+      if(v.which() != 1 || v.get<movable>().moved()){
+         return 1;
+      }
+      bool thrown = false;
+      try{  v.get<int>();  }
+      catch(boost::movelib::bad_variant_access &){  thrown = true;  }
+      if(!thrown || v.get_if<int>() != 0){
+         return 1;
+      }
+   }
+   {
+      //Copyable alternatives
+      typedef variant<int, copy_movable> cvar_t;
+      copy_movable c;
+      cvar_t v(c);
+      cvar_t v2(v);
+      if(c.moved() || v2.get<copy_movable>().moved()){
+         return 1;
+      }
+      cvar_t v3;
+      v3 = v2;
+      v3 = 5;
+      if(v3.get<int>() != 5){
+         return 1;
+      }
+      v3.emplace<copy_movable>();
+      v3 = boost::move(c);
+      if(!c.moved() || !v3.holds<copy_movable>()){
+         return 1;
+      }
+   }
+   {
+      variant<int, double> v(1.5);
+      variant<int, double> v2(boost::move(v));
+      if(v2.get<double>() != 1.5){
+         return 1;
+      }
+   }
+   return 0;
+}